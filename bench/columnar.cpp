@@ -0,0 +1,88 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares a selective scan over a columnar_table with the same data in a row based container_table,
+// where every predicate gets evaluated by sqlite.
+
+#include <boost/sqlite/columnar_table.hpp>
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/container_table.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace boost;
+
+constexpr std::size_t rows = 2000000;
+constexpr int runs = 5;
+
+double run_ms(sqlite::connection & conn, const char * sql, sqlite3_int64 & result)
+{
+  auto stmt = conn.prepare(sql);
+  double best = 1e300;
+  for (int i = 0; i < runs; i++)
+  {
+    sqlite3_reset(stmt.handle());
+    const auto start = std::chrono::steady_clock::now();
+    stmt.step();
+    const auto end = std::chrono::steady_clock::now();
+    result = stmt.current().at(0).get_int();
+    best = (std::min)(best, std::chrono::duration<double, std::milli>(end - start).count());
+  }
+  return best;
+}
+
+int main(int /*argc*/, char * /*argv*/[])
+{
+  std::mt19937_64 rng{42};
+  std::uniform_int_distribution<sqlite3_int64> qty_dist{0, 999};
+  std::uniform_real_distribution<double> price_dist{0., 100.};
+
+  std::vector<sqlite3_int64> qty(rows);
+  std::vector<double> price(rows);
+  std::vector<std::tuple<sqlite3_int64, double>> row_data(rows);
+  for (std::size_t i = 0u; i < rows; i++)
+  {
+    qty[i] = qty_dist(rng);
+    price[i] = price_dist(rng);
+    row_data[i] = std::make_tuple(qty[i], price[i]);
+  }
+
+  sqlite::vtab::column_store store;
+  store.add_column("c0", std::move(qty));
+  store.add_column("c1", std::move(price));
+
+  sqlite::connection conn{":memory:"};
+  sqlite::create_module(conn, "col_data", sqlite::vtab::columnar_module(store));
+  sqlite::create_module(conn, "row_data", sqlite::vtab::make_container_module(row_data));
+
+  const char * predicates[] = {
+      "c0 < 10",
+      "c0 = 500 and c1 > 50",
+      "c1 between 10 and 10.5",
+      "c0 in (1, 2, 3, 5, 8, 13, 21)",
+  };
+
+  std::printf("%-32s %12s %12s %8s\n", "predicate", "row [ms]", "columnar [ms]", "speedup");
+  for (auto pred : predicates)
+  {
+    const auto row_sql = std::string("select count(*) from row_data where ") + pred;
+    const auto col_sql = std::string("select count(*) from col_data where ") + pred;
+    sqlite3_int64 row_res, col_res;
+    const auto row_ms = run_ms(conn, row_sql.c_str(), row_res);
+    const auto col_ms = run_ms(conn, col_sql.c_str(), col_res);
+    if (row_res != col_res)
+    {
+      std::printf("result mismatch for %s: %lld != %lld\n", pred, row_res, col_res);
+      return 1;
+    }
+    std::printf("%-32s %12.2f %12.2f %7.1fx\n", pred, row_ms, col_ms, row_ms / col_ms);
+  }
+  return 0;
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the per-call overhead of user defined functions.
+// Every function gets called once per row of a 1M row recursive CTE,
+// the time of the same query without a function call is subtracted.
+
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/function.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace boost;
+
+constexpr int rows = 1000000;
+constexpr int runs = 5;
+
+double run_ns(sqlite::connection & conn, const std::string & expr)
+{
+  auto stmt = conn.prepare(
+      "with recursive c(x) as (select 1 union all select x + 1 from c where x < " + std::to_string(rows) + ") "
+      "select " + expr + " from c");
+
+  double best = 1e300;
+  for (int i = 0; i < runs; i++)
+  {
+    sqlite3_reset(stmt.handle());
+    const auto start = std::chrono::steady_clock::now();
+    stmt.step();
+    const auto end = std::chrono::steady_clock::now();
+    best = (std::min)(best, std::chrono::duration<double, std::nano>(end - start).count());
+  }
+  return best;
+}
+
+struct sum_noexcept
+{
+  sqlite3_int64 total = 0;
+  void step(span<sqlite::value, 1u> args) noexcept { total += args[0].get_int(); }
+  sqlite3_int64 final() noexcept { return total; }
+};
+
+struct sum_throwing
+{
+  sqlite3_int64 total = 0;
+  void step(span<sqlite::value, 1u> args) { total += args[0].get_int(); }
+  sqlite3_int64 final() { return total; }
+};
+
+int main(int /*argc*/, char * /*argv*/[])
+{
+  sqlite::connection conn{":memory:"};
+
+  sqlite3_create_function_v2(
+      conn.handle(), "c_api", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr,
+      [](sqlite3_context * ctx, int, sqlite3_value ** args)
+      {
+        sqlite3_result_int64(ctx, sqlite3_value_int64(args[0]) + 1);
+      },
+      nullptr, nullptr, nullptr);
+
+  sqlite::create_scalar_function(
+      conn, "fast",
+      [](sqlite::context<>, span<sqlite::value, 1u> args) noexcept -> sqlite3_int64
+      {
+        return args[0].get_int() + 1;
+      }, sqlite::deterministic);
+
+  sqlite::create_scalar_function(
+      conn, "slow",
+      [](sqlite::context<>, span<sqlite::value, 1u> args) -> sqlite3_int64
+      {
+        return args[0].get_int() + 1;
+      }, sqlite::deterministic);
+
+  sqlite::create_scalar_function(
+      conn, "slow_result",
+      [](sqlite::context<>, span<sqlite::value, 1u> args) -> sqlite::result<sqlite3_int64>
+      {
+        return args[0].get_int() + 1;
+      }, sqlite::deterministic);
+
+  sqlite::create_aggregate_function<sum_noexcept>(conn, "sum_fast");
+  sqlite::create_aggregate_function<sum_throwing>(conn, "sum_slow");
+
+  const double baseline = run_ns(conn, "sum(x)");
+  std::printf("baseline                 %8.2f ns/row\n", baseline / rows);
+
+  const char * exprs[][2] = {
+      {"c api",                   "sum(c_api(x))"},
+      {"scalar noexcept",         "sum(fast(x))"},
+      {"scalar",                  "sum(slow(x))"},
+      {"scalar result<>",         "sum(slow_result(x))"},
+      {"aggregate noexcept",      "sum_fast(x)"},
+      {"aggregate",               "sum_slow(x)"},
+  };
+
+  for (auto & e : exprs)
+    std::printf("%-24s %8.2f ns/call\n", e[0], (run_ns(conn, e[1]) - baseline) / rows);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,137 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares a correlated lookup into a virtual table, which opens a cursor for every outer row,
+// with & without a cursor_pool.
+
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/vtable.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace boost;
+
+constexpr int outer_rows = 200000;
+constexpr int runs = 5;
+
+struct lookup_cursor final : sqlite::vtab::cursor<>
+{
+  explicit lookup_cursor(const std::vector<sqlite3_int64> & data) : data_(&data) {}
+
+  sqlite::result<void> filter(int index, const char *, span<sqlite::value> values)
+  {
+    pos_ = 0;
+    end_ = static_cast<sqlite3_int64>(data_->size());
+    if (index == 1)
+    {
+      const auto id = values[0].get_int();
+      pos_ = (std::max)(sqlite3_int64(0), (std::min)(id, end_));
+      end_ = id == pos_ ? pos_ + 1 : pos_;
+    }
+    return {};
+  }
+  sqlite::result<void> next() { ++pos_; return {}; }
+  bool eof() noexcept { return pos_ >= end_; }
+  void column(sqlite::context<> ctx, int, bool) { ctx.set_result((*data_)[static_cast<std::size_t>(pos_)]); }
+  sqlite::result<sqlite3_int64> row_id() { return pos_; }
+  sqlite::result<void> reset() { pos_ = end_ = 0; return {}; }
+
+ private:
+  const std::vector<sqlite3_int64> * data_;
+  sqlite3_int64 pos_ = 0, end_ = 0;
+};
+
+struct lookup_table_base : sqlite::vtab::table<lookup_cursor>
+{
+  explicit lookup_table_base(const std::vector<sqlite3_int64> & data) : data_(&data) {}
+
+  const char * declaration() { return "create table x(value integer);"; }
+  sqlite::result<lookup_cursor> open() { return lookup_cursor{*data_}; }
+  sqlite::result<void> best_index(sqlite::vtab::index_info & info)
+  {
+    info.set_estimated_cost(static_cast<double>(data_->size()));
+    for (auto & ct : info.constraints())
+      if (ct.usable && ct.iColumn == -1 && ct.op == SQLITE_INDEX_CONSTRAINT_EQ)
+      {
+        info.claim(ct, true);
+        info.set_index(1);
+        info.set_estimated_cost(1.);
+        break;
+      }
+    return {};
+  }
+ private:
+  const std::vector<sqlite3_int64> * data_;
+};
+
+struct plain_table final : lookup_table_base
+{
+  using lookup_table_base::lookup_table_base;
+};
+
+struct pooled_table final : lookup_table_base, sqlite::vtab::cursor_pool
+{
+  using lookup_table_base::lookup_table_base;
+};
+
+template<typename Table>
+struct lookup_module final : sqlite::vtab::eponymous_module<Table>
+{
+  explicit lookup_module(const std::vector<sqlite3_int64> & data) : data_(&data) {}
+  sqlite::result<Table> connect(sqlite::connection_ref, int, const char * const [])
+  {
+    return Table{*data_};
+  }
+ private:
+  const std::vector<sqlite3_int64> * data_;
+};
+
+double run_ms(sqlite::connection & conn, const char * sql, sqlite3_int64 & result)
+{
+  auto stmt = conn.prepare(sql);
+  double best = 1e300;
+  for (int i = 0; i < runs; i++)
+  {
+    sqlite3_reset(stmt.handle());
+    const auto start = std::chrono::steady_clock::now();
+    stmt.step();
+    const auto end = std::chrono::steady_clock::now();
+    result = stmt.current().at(0).get_int();
+    best = (std::min)(best, std::chrono::duration<double, std::milli>(end - start).count());
+  }
+  return best;
+}
+
+int main(int /*argc*/, char * /*argv*/[])
+{
+  std::vector<sqlite3_int64> data(1000);
+  for (std::size_t i = 0u; i < data.size(); i++)
+    data[i] = static_cast<sqlite3_int64>(i * i);
+
+  sqlite::connection conn{":memory:"};
+  sqlite::create_module(conn, "plain",  lookup_module<plain_table>(data));
+  sqlite::create_module(conn, "pooled", lookup_module<pooled_table>(data));
+  conn.execute(
+      "create table outer_t(id integer);"
+      "with recursive n(i) as (select 0 union all select i + 1 from n where i + 1 < " + std::to_string(outer_rows) + ")"
+      "insert into outer_t select i % 1000 from n;");
+
+  sqlite3_int64 plain_res, pooled_res;
+  const auto plain_ms  = run_ms(conn, "select sum((select value from plain  where rowid = o.id)) from outer_t o;", plain_res);
+  const auto pooled_ms = run_ms(conn, "select sum((select value from pooled where rowid = o.id)) from outer_t o;", pooled_res);
+  if (plain_res != pooled_res)
+  {
+    std::printf("result mismatch: %lld != %lld\n", plain_res, pooled_res);
+    return 1;
+  }
+  std::printf("%-10s %12s\n", "cursor", "[ms]");
+  std::printf("%-10s %12.2f\n", "plain", plain_ms);
+  std::printf("%-10s %12.2f\n", "pooled", pooled_ms);
+  return 0;
+}
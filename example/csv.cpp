@@ -20,6 +20,7 @@ using namespace boost;
 
 // This example demonstrates how to use the vtable interface to read & write from a csv file.
 // The csv implementation is not efficient, but for demontration purposes.
+// For querying large csv files, see sqlite::vtab::csv_module.
 
 
 struct csv_data
@@ -10,23 +10,41 @@
  *  This page contains the documentation of the sqlite high-level API.
  */
 
+#include <boost/sqlite/arrow.hpp>
+#include <boost/sqlite/arrow_table.hpp>
 #include <boost/sqlite/backup.hpp>
 #include <boost/sqlite/blob.hpp>
+#include <boost/sqlite/busy.hpp>
+#include <boost/sqlite/change_capture.hpp>
+#include <boost/sqlite/checkpoint.hpp>
 #include <boost/sqlite/collation.hpp>
+#include <boost/sqlite/columnar_table.hpp>
 #include <boost/sqlite/connection.hpp>
 #include <boost/sqlite/connection_ref.hpp>
+#include <boost/sqlite/container_table.hpp>
 #include <boost/sqlite/cstring_ref.hpp>
+#include <boost/sqlite/csv_table.hpp>
 #include <boost/sqlite/error.hpp>
+#include <boost/sqlite/export.hpp>
 #include <boost/sqlite/field.hpp>
 #include <boost/sqlite/function.hpp>
 #include <boost/sqlite/meta_data.hpp>
 #include <boost/sqlite/memory.hpp>
+#include <boost/sqlite/memory_resource.hpp>
 #include <boost/sqlite/hooks.hpp>
+#include <boost/sqlite/hyperloglog.hpp>
 #include <boost/sqlite/iterator.hpp>
 #include <boost/sqlite/json.hpp>
+#include <boost/sqlite/page_cache.hpp>
+#include <boost/sqlite/parallel_query.hpp>
 #include <boost/sqlite/row.hpp>
+#include <boost/sqlite/row_cursor.hpp>
 #include <boost/sqlite/query.hpp>
+#include <boost/sqlite/query_cache.hpp>
+#include <boost/sqlite/session.hpp>
+#include <boost/sqlite/snapshot.hpp>
 #include <boost/sqlite/statement.hpp>
+#include <boost/sqlite/statistics.hpp>
 #include <boost/sqlite/string.hpp>
 #include <boost/sqlite/transaction.hpp>
 #include <boost/sqlite/value.hpp>
@@ -0,0 +1,182 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_ARROW_HPP
+#define BOOST_SQLITE_ARROW_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/error.hpp>
+#include <boost/sqlite/statement.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// The structs of the Arrow C data & stream interfaces, as specified by
+// https://arrow.apache.org/docs/format/CDataInterface.html
+// The guards are the ones from the spec, so this can be combined with arrow's own headers.
+extern "C"
+{
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema
+{
+  const char* format;
+  const char* name;
+  const char* metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+
+  void (*release)(struct ArrowSchema*);
+  void* private_data;
+};
+
+struct ArrowArray
+{
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+
+  void (*release)(struct ArrowArray*);
+  void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+#ifndef ARROW_C_STREAM_INTERFACE
+#define ARROW_C_STREAM_INTERFACE
+
+struct ArrowArrayStream
+{
+  int (*get_schema)(struct ArrowArrayStream*, struct ArrowSchema* out);
+  int (*get_next)(struct ArrowArrayStream*, struct ArrowArray* out);
+  const char* (*get_last_error)(struct ArrowArrayStream*);
+
+  void (*release)(struct ArrowArrayStream*);
+  void* private_data;
+};
+
+#endif  // ARROW_C_STREAM_INTERFACE
+
+}
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace arrow
+{
+
+/** @brief Reads the rows of a statement as Arrow record batches.
+    @ingroup reference
+
+    Every batch is a struct array with one child per column.
+    The type of a column is taken from its declared type, using sqlite's affinity rules:
+    `INTEGER` columns become `int64`, `REAL` ones `float64`, `TEXT` ones `large_utf8` & `BLOB` ones `large_binary`.
+    Columns without a declared type, e.g. expressions, or with numeric affinity get the type
+    of their first non-null value in the first batch, which is buffered for that purpose.
+
+    Values not matching the type of their column are converted by sqlite, e.g. `1.5` in an `int64` column becomes `1`.
+
+    Once reading rows failed, the rows read so far are dropped
+    and every further call fails with the same error, instead of stepping the statement again.
+
+    The statement must outlive the reader.
+ */
+struct batch_reader
+{
+  batch_reader(statement & stmt, std::size_t batch_size);
+
+  batch_reader(batch_reader && ) noexcept = default;
+  batch_reader& operator=(batch_reader && ) noexcept = default;
+
+  ///@{
+  /// Export the schema into `out`, which the caller needs to release.
+  BOOST_SQLITE_DECL void read_schema(ArrowSchema * out, system::error_code & ec, error_info & ei);
+  BOOST_SQLITE_DECL void read_schema(ArrowSchema * out);
+  ///@}
+
+  ///@{
+  /** Export the next batch of up to `batch_size` rows into `out`, which the caller needs to release.
+      @returns `false` if there were no rows left, in which case `out->release` is null.
+   */
+  BOOST_SQLITE_DECL bool read_next(ArrowArray * out, system::error_code & ec, error_info & ei);
+  BOOST_SQLITE_DECL bool read_next(ArrowArray * out);
+  ///@}
+
+  std::size_t batch_size() const noexcept {return batch_size_;}
+
+ private:
+  struct value_deleter
+  {
+    void operator()(sqlite3_value * v) const noexcept { sqlite3_value_free(v); }
+  };
+
+  void resolve_types(system::error_code & ec, error_info & ei);
+  // remember the error, so it's returned by every later call.
+  void fail(const system::error_code & ec, const error_info & ei);
+  bool failed(system::error_code & ec, error_info & ei) const;
+
+  statement * stmt_;
+  std::size_t batch_size_;
+  std::vector<char> types_;
+  bool resolved_ = false;
+  // the first batch, row by row, read when resolving the types
+  std::vector<std::unique_ptr<sqlite3_value, value_deleter>> buffered_;
+  // the error that stopped the reader.
+  system::error_code error_;
+  error_info error_info_;
+};
+
+inline batch_reader::batch_reader(statement & stmt, std::size_t batch_size)
+    : stmt_(&stmt), batch_size_(batch_size == 0u ? 1u : batch_size)
+{
+}
+
+/** @brief Export the rows of `stmt` as Arrow record batches of up to `batch_size` rows.
+    @ingroup reference
+
+    @par Example
+    @code{.cpp}
+    auto stmt = conn.prepare("select symbol, price, volume from trades");
+    auto reader = sqlite::arrow::export_batches(stmt, 64 * 1024);
+
+    ArrowSchema schema;
+    reader.read_schema(&schema);
+    ArrowArray batch;
+    while (reader.read_next(&batch))
+      consume(&schema, &batch); // takes ownership of batch
+    schema.release(&schema);
+    @endcode
+ */
+inline batch_reader export_batches(statement & stmt, std::size_t batch_size = 64u * 1024u)
+{
+  return batch_reader(stmt, batch_size);
+}
+
+/** @brief Export the rows of `stmt` as an `ArrowArrayStream`.
+    @ingroup reference
+
+    The stream takes ownership of the statement, the caller needs to release `out`.
+    Errors are reported through the return codes of the stream callbacks & `get_last_error`.
+ */
+BOOST_SQLITE_DECL
+void export_stream(statement stmt, std::size_t batch_size, ArrowArrayStream * out);
+
+}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_ARROW_HPP
@@ -0,0 +1,192 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_ARROW_TABLE_HPP
+#define BOOST_SQLITE_ARROW_TABLE_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/arrow.hpp>
+#include <boost/sqlite/vtable.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace vtab
+{
+
+/** @brief Record batches imported from an `ArrowArrayStream`.
+    @ingroup reference
+
+    Owns the schema & the arrays, which get released by the destructor.
+    The stream must produce struct arrays, with one child per column.
+ */
+struct arrow_batches
+{
+  /// The physical type of a column.
+  enum class kind : unsigned char
+  {
+    int8, int16, int32, int64, uint8, uint16, uint32, uint64,
+    float32, float64, boolean,
+    utf8, large_utf8, binary, large_binary
+  };
+
+  arrow_batches() noexcept = default;
+  arrow_batches(const arrow_batches & ) = delete;
+  arrow_batches(arrow_batches && lhs) noexcept
+      : schema_(lhs.schema_), batches_(std::move(lhs.batches_)),
+        offsets_(std::move(lhs.offsets_)), columns_(std::move(lhs.columns_))
+  {
+    lhs.schema_.release = nullptr;
+  }
+  arrow_batches& operator=(const arrow_batches & ) = delete;
+  arrow_batches& operator=(arrow_batches && lhs) noexcept
+  {
+    arrow_batches tmp{std::move(lhs)};
+    swap(tmp);
+    return *this;
+  }
+  ~arrow_batches() { clear(); }
+
+  ///@{
+  /// Read all batches of `stream` & release it.
+  BOOST_SQLITE_DECL void import(ArrowArrayStream * stream, system::error_code & ec, error_info & ei);
+  BOOST_SQLITE_DECL void import(ArrowArrayStream * stream);
+  ///@}
+
+  /// Release the schema & all arrays.
+  BOOST_SQLITE_DECL void clear() noexcept;
+
+  /// The total number of rows.
+  std::size_t size() const noexcept { return offsets_.empty() ? 0u : offsets_.back(); }
+  std::size_t batch_count() const noexcept { return batches_.size(); }
+  std::size_t column_count() const noexcept { return columns_.size(); }
+
+  const std::string & column_name(std::size_t idx) const { return columns_.at(idx).name; }
+  kind column_kind(std::size_t idx) const { return columns_.at(idx).type; }
+
+  const ArrowSchema & schema() const noexcept { return schema_; }
+  const ArrowArray & batch(std::size_t idx) const { return batches_.at(idx); }
+  /// The index of the first row of the batch.
+  std::size_t batch_offset(std::size_t idx) const { return offsets_.at(idx); }
+
+  void swap(arrow_batches & other) noexcept
+  {
+    std::swap(schema_, other.schema_);
+    batches_.swap(other.batches_);
+    offsets_.swap(other.offsets_);
+    columns_.swap(other.columns_);
+  }
+
+ private:
+  struct column
+  {
+    std::string name;
+    kind type;
+  };
+
+  ArrowSchema schema_{};
+  std::vector<ArrowArray> batches_;
+  // the first row of each batch, followed by the total
+  std::vector<std::size_t> offsets_;
+  std::vector<column> columns_;
+};
+
+/// The cursor of an arrow_table. @ingroup reference
+struct arrow_cursor final : cursor<>
+{
+  explicit arrow_cursor(const arrow_batches & data) noexcept : data_(&data) {}
+
+  BOOST_SQLITE_DECL result<void> filter(int index, const char * index_data, span<sqlite::value> values);
+  BOOST_SQLITE_DECL result<void> next();
+  bool eof() noexcept { return batch_ >= data_->batch_count(); }
+  BOOST_SQLITE_DECL void column(context<> ctx, int idx, bool no_change);
+  result<sqlite3_int64> row_id() noexcept
+  {
+    return static_cast<sqlite3_int64>(data_->batch_offset(batch_) + row_);
+  }
+  // keeps the buffer of the constraints for the next query.
+  result<void> reset() noexcept { batch_ = row_ = 0u; constraints_.clear(); return {}; }
+
+ private:
+  struct constraint
+  {
+    std::size_t column;
+    char op;
+    // inclusive bounds for integer columns
+    sqlite3_int64 lo, hi;
+    double real;
+    std::string text;
+  };
+
+  bool matches() const noexcept;
+  void seek() noexcept;
+
+  const arrow_batches * data_;
+  std::vector<constraint> constraints_;
+  std::size_t batch_ = 0u, row_ = 0u;
+};
+
+/** @brief A read-only virtual table over arrow_batches.
+    @ingroup reference
+
+    The cursor reads the values from the Arrow buffers, text & blobs are handed to sqlite without a copy.
+    Comparisons (`=`, `<`, `<=`, `>`, `>=`) on numeric columns are evaluated on the buffers,
+    as is `=` on text columns using the binary collation.
+    The row count from the batch lengths is reported to the query planner.
+ */
+struct arrow_table final : table<arrow_cursor>, cursor_pool
+{
+  BOOST_SQLITE_DECL explicit arrow_table(std::shared_ptr<const arrow_batches> data);
+
+  const char * declaration() { return declaration_.c_str(); }
+  result<arrow_cursor> open() { return arrow_cursor{*data_}; }
+  BOOST_SQLITE_DECL result<void> best_index(index_info & info);
+
+ private:
+  std::shared_ptr<const arrow_batches> data_;
+  std::string declaration_;
+};
+
+/** @brief An eponymous module for an arrow_table.
+    @ingroup reference
+
+    The stream is read into memory when the module is constructed, since sqlite may scan a table multiple times,
+    e.g. as the inner table of a join.
+
+    @par Example
+    @code{.cpp}
+    ArrowArrayStream stream;
+    service.export_positions(&stream);
+
+    sqlite::create_module(conn, "positions", sqlite::vtab::arrow_module(&stream));
+    auto st = conn.prepare("select p.symbol, p.qty * t.price from positions p join trades t using (symbol)");
+    @endcode
+ */
+struct arrow_module final : eponymous_module<arrow_table>
+{
+  /// Import the stream, taking ownership of it.
+  explicit arrow_module(ArrowArrayStream * stream)
+  {
+    auto data = std::make_shared<arrow_batches>();
+    data->import(stream);
+    data_ = std::move(data);
+  }
+  explicit arrow_module(arrow_batches data) : data_(std::make_shared<arrow_batches>(std::move(data))) {}
+
+  result<arrow_table> connect(connection_ref, int, const char * const [])
+  {
+    return arrow_table{data_};
+  }
+ private:
+  std::shared_ptr<const arrow_batches> data_;
+};
+
+}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_ARROW_TABLE_HPP
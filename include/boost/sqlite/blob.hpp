@@ -62,6 +62,8 @@ struct blob
     }
     /// Create an empty blob with size `n`.
     explicit blob(std::size_t n) : impl_(sqlite3_malloc(static_cast<int>(n))), size_(n) {}
+    /// Take ownership of `n` bytes allocated by sqlite, e.g. a changeset.
+    blob(unique_ptr<void> data, std::size_t n) noexcept : impl_(std::move(data)), size_(n) {}
 
     /// Construct an empty blob
     constexpr blob() = default;
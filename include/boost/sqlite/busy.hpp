@@ -0,0 +1,235 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_BUSY_HPP
+#define BOOST_SQLITE_BUSY_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/detail/exception.hpp>
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/error.hpp>
+#include <boost/sqlite/transaction.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+/**
+  @brief Wait up to `timeout` for a locked table, polling it with a fixed schedule.
+  @ingroup reference
+
+  @see [related sqlite documentation](https://www.sqlite.org/c3ref/busy_timeout.html)
+
+  A timeout of zero or less turns off waiting, so a locked table fails with `SQLITE_BUSY` right away.
+  This replaces the handler installed by `busy_handler`.
+ */
+BOOST_SQLITE_DECL void busy_timeout(connection_ref conn, std::chrono::milliseconds timeout) noexcept;
+
+/// The settings of an exponential backoff. @ingroup reference
+struct backoff_options
+{
+  /// The delay before the first retry.
+  std::chrono::milliseconds initial_delay{1};
+  /// The maximum delay between two retries. The delay doubles with each retry until it reaches this value.
+  std::chrono::milliseconds max_delay{100};
+  /// Give up once waiting for this long.
+  std::chrono::milliseconds timeout{5000};
+};
+
+/** @brief Histograms of the waits for a lock.
+    @ingroup reference
+
+    Bucket `i` counts the values in `[2^i, 2^(i+1))`, the first one also counts zero
+    and the last one everything above.
+ */
+struct lock_wait_metrics
+{
+  constexpr static std::size_t buckets = 16u;
+
+  /// The number of times a lock was busy.
+  std::uint64_t waits = 0u;
+  /// The number of retries of all waits.
+  std::uint64_t retries = 0u;
+  /// The waits that gave up, i.e. failed with `SQLITE_BUSY`.
+  std::uint64_t timeouts = 0u;
+  /// The retries per wait.
+  std::array<std::uint64_t, buckets> retry_histogram{};
+  /// The duration of each wait in milliseconds.
+  std::array<std::uint64_t, buckets> wait_histogram{};
+};
+
+/** @brief A busy handler that retries with a jittered exponential backoff.
+    @ingroup reference
+
+    The delay starts at `initial_delay` and doubles with every retry up to `max_delay`.
+    Each delay is randomized to between half and the full value,
+    so connections that got blocked by the same writer don't all retry at once.
+
+    The handler records a histogram of the retries & durations of the waits of its connection,
+    which can be read from any thread.
+    Each handler must only be installed in one connection and outlive it.
+
+    @par Example
+    @code{.cpp}
+    sqlite::backoff_busy_handler backoff;
+    sqlite::busy_handler(conn, backoff);
+    @endcode
+ */
+struct backoff_busy_handler
+{
+  BOOST_SQLITE_DECL explicit backoff_busy_handler(backoff_options options = {}) noexcept;
+  backoff_busy_handler(const backoff_busy_handler & ) = delete;
+  backoff_busy_handler& operator=(const backoff_busy_handler & ) = delete;
+
+  /// Sleep and return true, if `count` retries still fit into the timeout.
+  BOOST_SQLITE_DECL bool operator()(int count) noexcept;
+
+  /// The waits recorded so far. A wait that is in progress is included.
+  BOOST_SQLITE_DECL lock_wait_metrics metrics() const noexcept;
+  /// The settings.
+  const backoff_options & options() const noexcept { return options_; }
+
+ private:
+  using histogram = std::array<std::atomic<std::uint64_t>, lock_wait_metrics::buckets>;
+
+  backoff_options options_;
+  std::minstd_rand rng_;
+  // the wait in progress, only touched by the connection.
+  std::chrono::steady_clock::time_point start_;
+  std::uint64_t current_retries_ = 0u;
+  std::uint64_t current_wait_ = 0u;
+
+  std::atomic<std::uint64_t> waits_{0u}, retries_{0u}, timeouts_{0u};
+  histogram retry_histogram_{}, wait_histogram_{};
+};
+
+/// The settings of `with_retry`. @ingroup reference
+struct retry_options
+{
+  /// How to begin the transaction. Immediate takes the write lock up front,
+  /// so a busy database is found before running the block.
+  transaction::behaviour behaviour = transaction::immediate;
+  /// The maximum number of times the block gets run.
+  int max_attempts = 10;
+  /// The delays between attempts. Retrying stops after `backoff.timeout`.
+  backoff_options backoff;
+};
+
+namespace detail
+{
+
+struct retry_state
+{
+  BOOST_SQLITE_DECL explicit retry_state(const retry_options & options) noexcept;
+
+  BOOST_SQLITE_DECL void begin(connection_ref conn, system::error_code & ec, error_info & ei);
+  // commit, or roll back if `ec` is set or the commit fails.
+  BOOST_SQLITE_DECL void end(connection_ref conn, system::error_code & ec, error_info & ei);
+  // sleep & return true if `ec` is worth another attempt.
+  BOOST_SQLITE_DECL bool retry(const system::error_code & ec) noexcept;
+
+ private:
+  const retry_options & options_;
+  int attempts_ = 1;
+  std::minstd_rand rng_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}
+
+///@{
+/**
+  @brief Run `func` in a transaction and run it again if the database was busy.
+  @ingroup reference
+
+  The whole transaction gets rolled back and retried, if it fails with
+  `SQLITE_BUSY` or `SQLITE_LOCKED`, including extended codes like `SQLITE_BUSY_SNAPSHOT`.
+  These can't be resolved by a busy handler, because the transaction needs to restart
+  to see the changes of the connection that blocked it.
+  Other errors roll back the transaction and get returned or rethrown right away.
+
+  `func` might get run multiple times, so it shouldn't have side effects outside the database.
+  The version with an `error_code` calls `func(ec, ei)`, the other one calls `func()`.
+
+  @par Example
+  @code{.cpp}
+  sqlite::with_retry(
+      conn,
+      [&]
+      {
+        conn.execute("update accounts set balance = balance - 10 where id = 1");
+        conn.execute("update accounts set balance = balance + 10 where id = 2");
+      });
+  @endcode
+ */
+template<typename Func>
+void with_retry(connection_ref conn, Func && func, const retry_options & options,
+                system::error_code & ec, error_info & ei)
+{
+  detail::retry_state state{options};
+  do
+  {
+    ec.clear();
+    ei.clear();
+    state.begin(conn, ec, ei);
+    if (ec)
+      continue;
+    BOOST_TRY
+    {
+      func(ec, ei);
+    }
+    BOOST_CATCH(...)
+    {
+      system::error_code ec_;
+      error_info ei_;
+      BOOST_SQLITE_ASSIGN_EC(ec_, SQLITE_ABORT);
+      state.end(conn, ec_, ei_);
+      BOOST_RETHROW
+    }
+    BOOST_CATCH_END
+    state.end(conn, ec, ei);
+  }
+  while (ec && state.retry(ec));
+}
+
+template<typename Func>
+void with_retry(connection_ref conn, Func && func, const retry_options & options = {})
+{
+  system::error_code ec;
+  error_info ei;
+  with_retry(
+      conn,
+      [&func](system::error_code & ec, error_info & ei)
+      {
+#if !defined(BOOST_NO_EXCEPTIONS)
+        try
+        {
+#endif
+          func();
+#if !defined(BOOST_NO_EXCEPTIONS)
+        }
+        catch(system::system_error & se)
+        {
+          ec = se.code();
+          const auto msg = detail::get_message(se);
+          if (!msg.empty())
+            ei.format("%.*s", static_cast<int>(msg.size()), msg.data());
+        }
+#endif
+      },
+      options, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+///@}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_BUSY_HPP
@@ -0,0 +1,132 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_CHANGE_CAPTURE_HPP
+#define BOOST_SQLITE_CHANGE_CAPTURE_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/connection_ref.hpp>
+#include <boost/sqlite/value.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+/// A row change recorded by a change_capture. @ingroup reference
+struct row_change
+{
+  /// `SQLITE_INSERT`, `SQLITE_UPDATE` or `SQLITE_DELETE`.
+  int op;
+  std::string database;
+  std::string table;
+  /// The rowid before the change. Without the preupdate hook this is the same as `new_rowid`.
+  sqlite3_int64 old_rowid;
+  /// The rowid after the change.
+  sqlite3_int64 new_rowid;
+  /// The values before an update or delete, only captured through the preupdate hook.
+  std::vector<unique_value> old_values;
+  /// The values after an insert or update, only captured through the preupdate hook.
+  std::vector<unique_value> new_values;
+};
+
+/// The changes of one committed transaction. @ingroup reference
+struct change_batch
+{
+  /// Increases by one with every commit, a gap means that batches were dropped.
+  std::uint64_t sequence = 0u;
+  std::vector<row_change> changes;
+};
+
+/** @brief Captures the row changes of connections & publishes them per transaction.
+    @ingroup reference
+
+    The changes are recorded by the hooks of the connection and kept with the connection until the transaction ends.
+    On commit they get pushed as a change_batch into a bounded lock-free ring buffer, on rollback they are dropped.
+    Consumer threads take the batches out of the ring, so the writer never waits for them.
+    If the ring is full, the batch gets dropped and counted in `dropped()`.
+
+    `attach` installs the update (or preupdate), commit & rollback hooks of the connection, replacing others.
+    Multiple connections may be attached & `try_pop` may be called from multiple threads concurrently.
+    `attach` and `detach` must not run concurrently with each other.
+
+    @note Changes undone by `ROLLBACK TO` a savepoint are not removed, since sqlite has no hook for it.
+    A batch is published from the commit hook, i.e. right before the commit.
+    If the commit itself fails, e.g. with `SQLITE_BUSY`, the batch has still been published.
+
+    @par Example
+    @code{.cpp}
+    sqlite::change_capture cdc{4096};
+    cdc.attach(conn);
+
+    std::thread replicator{[&]
+    {
+      while (running)
+        if (cdc.drain([&](sqlite::change_batch && batch) { index.apply(batch); }) == 0u)
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }};
+    @endcode
+ */
+struct change_capture
+{
+  /// Create a capture with a ring of at least `capacity` batches.
+  BOOST_SQLITE_DECL explicit change_capture(std::size_t capacity = 1024u);
+  change_capture(const change_capture & ) = delete;
+  change_capture& operator=(const change_capture & ) = delete;
+  BOOST_SQLITE_DECL ~change_capture();
+
+  /** @brief Install the hooks into `conn`.
+
+      @param conn The connection, which must be detached or closed before the capture gets destroyed.
+      @param capture_values Record the old & new values of every change.
+      This requires sqlite & this library to be compiled with `SQLITE_ENABLE_PREUPDATE_HOOK`, it's ignored otherwise.
+   */
+  BOOST_SQLITE_DECL void attach(connection_ref conn, bool capture_values = true);
+  /// Remove the hooks from `conn`, dropping the changes of an open transaction.
+  BOOST_SQLITE_DECL void detach(connection_ref conn);
+
+  /// Take the oldest batch out of the ring, returns false if it's empty. Never blocks.
+  BOOST_SQLITE_DECL bool try_pop(change_batch & batch);
+
+  /// Invoke `func(change_batch &&)` for every batch in the ring & return the number of batches.
+  template<typename Func>
+  std::size_t drain(Func && func)
+  {
+    std::size_t n = 0u;
+    change_batch batch;
+    while (try_pop(batch))
+    {
+      func(std::move(batch));
+      n++;
+    }
+    return n;
+  }
+
+  /// The number of batches dropped because the ring was full.
+  std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+  /// The number of batches the ring can hold.
+  std::size_t capacity() const noexcept { return mask_ + 1u; }
+
+ private:
+  struct cell;
+  struct connection_state;
+
+  bool push(std::unique_ptr<change_batch> & batch) noexcept;
+  void publish(connection_state & state) noexcept;
+
+  std::unique_ptr<cell[]> cells_;
+  std::size_t mask_;
+  std::atomic<std::size_t> enqueue_pos_{0u};
+  std::atomic<std::size_t> dequeue_pos_{0u};
+  std::atomic<std::uint64_t> sequence_{0u};
+  std::atomic<std::uint64_t> dropped_{0u};
+  std::vector<std::unique_ptr<connection_state>> connections_;
+};
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_CHANGE_CAPTURE_HPP
@@ -0,0 +1,188 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_CHECKPOINT_HPP
+#define BOOST_SQLITE_CHECKPOINT_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/cstring_ref.hpp>
+#include <boost/sqlite/error.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+/// The mode of a wal checkpoint. @ingroup reference
+enum class checkpoint_mode
+{
+  /// Checkpoint as many frames as possible without waiting for readers or writers.
+  passive = SQLITE_CHECKPOINT_PASSIVE,
+  /// Wait for the writers, then checkpoint all frames.
+  full = SQLITE_CHECKPOINT_FULL,
+  /// Like full, but also wait for the readers so the next writer restarts the log from the beginning.
+  restart = SQLITE_CHECKPOINT_RESTART,
+  /// Like restart, but also truncate the log file to zero bytes.
+  truncate = SQLITE_CHECKPOINT_TRUNCATE
+};
+
+/// The frame counts reported by a checkpoint. @ingroup reference
+struct checkpoint_result
+{
+  /// The number of frames in the log.
+  int log_frames = -1;
+  /// The number of frames in the log that have been checkpointed.
+  int checkpointed_frames = -1;
+};
+
+///@{
+/**
+  @brief Run a checkpoint of the write-ahead log.
+  @ingroup reference
+
+  @see [related sqlite documentation](https://www.sqlite.org/c3ref/wal_checkpoint_v2.html)
+
+  If a blocking mode can't complete, it fails with `SQLITE_BUSY`. The frame counts are still reported then.
+
+  @param conn The connection to run the checkpoint on.
+  @param mode The mode of the checkpoint.
+  @param database The database to checkpoint, all attached databases if empty.
+ */
+BOOST_SQLITE_DECL
+checkpoint_result wal_checkpoint(connection_ref conn, checkpoint_mode mode, cstring_ref database,
+                                 system::error_code & ec, error_info & ei);
+
+BOOST_SQLITE_DECL
+checkpoint_result wal_checkpoint(connection_ref conn,
+                                 checkpoint_mode mode = checkpoint_mode::passive,
+                                 cstring_ref database = "main");
+///@}
+
+///@{
+/**
+  @brief Checkpoint automatically after a commit, once the log has at least `frames` frames.
+  @ingroup reference
+
+  A value of zero or less disables automatic checkpoints. The default is 1000.
+  This replaces the wal_hook of the connection.
+
+  @see [related sqlite documentation](https://www.sqlite.org/c3ref/wal_autocheckpoint.html)
+ */
+BOOST_SQLITE_DECL void wal_autocheckpoint(connection_ref conn, int frames, system::error_code & ec, error_info & ei);
+BOOST_SQLITE_DECL void wal_autocheckpoint(connection_ref conn, int frames);
+///@}
+
+/// The settings of a checkpoint_manager. @ingroup reference
+struct checkpoint_options
+{
+  /// Wake up the checkpoint thread once a commit leaves at least this many frames in the log.
+  int passive_frames = 1000;
+  /// Run a restart checkpoint if the log still has this many frames after a passive checkpoint.
+  int restart_frames = 10000;
+  /// Run a truncate checkpoint if the log still has this many frames after a passive checkpoint.
+  int truncate_frames = 100000;
+  /// Run a passive checkpoint at least this often, even without commits. Zero disables it.
+  std::chrono::milliseconds interval{1000};
+  /// How long a restart or truncate checkpoint waits for readers & writers.
+  std::chrono::milliseconds busy_timeout{100};
+};
+
+/// Counters of a checkpoint_manager. @ingroup reference
+struct checkpoint_metrics
+{
+  std::uint64_t passive = 0u;
+  std::uint64_t restart = 0u;
+  std::uint64_t truncate = 0u;
+  /// The checkpoints that returned `SQLITE_BUSY` or another error.
+  std::uint64_t failed = 0u;
+  /// The frames in the log reported by the last checkpoint.
+  int log_frames = 0;
+  /// The checkpointed frames reported by the last checkpoint.
+  int checkpointed_frames = 0;
+};
+
+/** @brief Runs the checkpoints of a wal database on a background thread.
+    @ingroup reference
+
+    Writers attached to the manager have their automatic checkpoints disabled,
+    so a commit never runs a checkpoint on the committing thread.
+    Instead their wal hook wakes up the background thread once the log has `passive_frames` frames.
+
+    The thread runs a passive checkpoint on its own connection to the database.
+    If the log has still grown beyond `restart_frames` or `truncate_frames`,
+    which happens if readers keep the checkpoint from completing,
+    it escalates to a restart or truncate checkpoint, which waits up to `busy_timeout` for the readers.
+
+    @note This replaces the wal hook of the attached connections.
+
+    @par Example
+    @code{.cpp}
+    sqlite::connection writer{"app.db"};
+    writer.execute("pragma journal_mode=wal");
+
+    sqlite::checkpoint_manager ckpt{"app.db"};
+    ckpt.attach(writer);
+    @endcode
+ */
+struct checkpoint_manager
+{
+  /// Open a connection to `filename` and start the checkpoint thread.
+  BOOST_SQLITE_DECL explicit checkpoint_manager(cstring_ref filename, checkpoint_options options = {});
+  checkpoint_manager(const checkpoint_manager & ) = delete;
+  checkpoint_manager& operator=(const checkpoint_manager & ) = delete;
+  /// Stops the thread.
+  BOOST_SQLITE_DECL ~checkpoint_manager();
+
+  /** @brief Disable the automatic checkpoints of `writer` & install a wal hook waking up the thread.
+
+      The writer must be detached or closed before the manager gets destroyed.
+   */
+  BOOST_SQLITE_DECL void attach(connection_ref writer);
+  /// Remove the hook from `writer` & restore its automatic checkpoints.
+  BOOST_SQLITE_DECL void detach(connection_ref writer);
+
+  /// Wake up the thread to run a checkpoint now.
+  BOOST_SQLITE_DECL void request() noexcept;
+  /// Stop the thread. Called by the destructor.
+  BOOST_SQLITE_DECL void stop() noexcept;
+
+  /// The counters of the checkpoints run so far.
+  BOOST_SQLITE_DECL checkpoint_metrics metrics() const noexcept;
+  /// The settings.
+  const checkpoint_options & options() const noexcept { return options_; }
+
+ private:
+  struct on_wal
+  {
+    checkpoint_manager * self;
+    void operator()(const char * db_name, int pages) noexcept;
+  };
+
+  void run() noexcept;
+  void checkpoint(checkpoint_mode mode, std::atomic<std::uint64_t> & counter) noexcept;
+
+  checkpoint_options options_;
+  connection conn_;
+  on_wal hook_{this};
+
+  mutable std::mutex mtx_;
+  std::condition_variable cv_;
+  bool requested_ = false;
+  bool stopped_ = false;
+
+  std::atomic<std::uint64_t> passive_{0u}, restart_{0u}, truncate_{0u}, failed_{0u};
+  std::atomic<int> log_frames_{0}, checkpointed_frames_{0};
+  std::thread thread_;
+};
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_CHECKPOINT_HPP
@@ -0,0 +1,135 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_COLUMNAR_TABLE_HPP
+#define BOOST_SQLITE_COLUMNAR_TABLE_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/vtable.hpp>
+
+#include <boost/variant2/variant.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace vtab
+{
+
+/** @brief Typed, contiguous column arrays that can be queried through a columnar_table.
+    @ingroup reference
+
+    All columns need to have the same size. Values cannot be NULL.
+ */
+struct column_store
+{
+  using column_data = variant2::variant<std::vector<sqlite3_int64>, std::vector<double>, std::vector<std::string>>;
+
+  ///@{
+  /// Add a column. Throws `std::invalid_argument` if the size doesn't match the existing columns.
+  BOOST_SQLITE_DECL void add_column(std::string name, std::vector<sqlite3_int64> data);
+  BOOST_SQLITE_DECL void add_column(std::string name, std::vector<double> data);
+  BOOST_SQLITE_DECL void add_column(std::string name, std::vector<std::string> data);
+  ///@}
+
+  /// The number of rows.
+  std::size_t size() const noexcept { return size_; }
+  /// The number of columns.
+  std::size_t column_count() const noexcept { return columns_.size(); }
+
+  const std::string & column_name(std::size_t idx) const { return columns_.at(idx).name; }
+  const column_data & column     (std::size_t idx) const { return columns_.at(idx).data; }
+
+ private:
+  BOOST_SQLITE_DECL void add_column_impl(std::string name, column_data data, std::size_t size);
+
+  struct entry
+  {
+    std::string name;
+    column_data data;
+  };
+  std::vector<entry> columns_;
+  std::size_t size_ = 0u;
+};
+
+/// The cursor of a columnar_table. @ingroup reference
+struct columnar_cursor final : cursor<>
+{
+  explicit columnar_cursor(const column_store & store) noexcept : store_(&store) {}
+
+  BOOST_SQLITE_DECL result<void> filter(int index, const char * index_data, span<sqlite::value> values);
+  result<void> next() noexcept { ++pos_; return {}; }
+  bool eof() noexcept { return pos_ >= end_; }
+  BOOST_SQLITE_DECL void column(context<> ctx, int idx, bool no_change);
+  result<sqlite3_int64> row_id() noexcept { return static_cast<sqlite3_int64>(current()); }
+  // keeps the buffers of the selection vector & mask for the next query.
+  result<void> reset() noexcept { pos_ = end_ = 0u; filtered_ = false; return {}; }
+
+ private:
+  std::size_t current() const noexcept { return filtered_ ? selection_[pos_] : pos_; }
+
+  const column_store * store_;
+  // the rows passing the pushed down constraints
+  std::vector<std::uint32_t> selection_;
+  std::vector<std::uint8_t> mask_;
+  std::size_t pos_ = 0u, end_ = 0u;
+  bool filtered_ = false;
+};
+
+/** @brief A read-only virtual table over a column_store.
+    @ingroup reference
+
+    Comparisons (`=`, `<`, `<=`, `>`, `>=`, `BETWEEN`, `IN`) on numeric columns are evaluated inside `filter`,
+    a column at a time into a selection vector, so only qualifying rows reach sqlite.
+    Constraints on text columns are left to sqlite.
+    If all constraints are handled by the table, `LIMIT` & `OFFSET` are applied as well.
+ */
+struct columnar_table final : table<columnar_cursor>, cursor_pool
+{
+  BOOST_SQLITE_DECL explicit columnar_table(const column_store & store);
+
+  const char * declaration() { return declaration_.c_str(); }
+  result<columnar_cursor> open() { return columnar_cursor{*store_}; }
+  BOOST_SQLITE_DECL result<void> best_index(index_info & info);
+
+ private:
+  const column_store * store_;
+  std::string declaration_;
+};
+
+/** @brief An eponymous module for a columnar_table.
+    @ingroup reference
+
+    The store must outlive the connection and must not be modified while a query runs.
+
+    @par Example
+    @code{.cpp}
+    sqlite::vtab::column_store trades;
+    trades.add_column("price",  std::move(prices));
+    trades.add_column("volume", std::move(volumes));
+    trades.add_column("symbol", std::move(symbols));
+
+    sqlite::create_module(conn, "trades", sqlite::vtab::columnar_module(trades));
+    auto st = conn.prepare("select symbol, sum(volume) from trades where price between 10 and 11 group by symbol");
+    @endcode
+ */
+struct columnar_module final : eponymous_module<columnar_table>
+{
+  explicit columnar_module(const column_store & store) : store_(&store) {}
+
+  result<columnar_table> connect(connection_ref, int, const char * const [])
+  {
+    return columnar_table{*store_};
+  }
+ private:
+  const column_store * store_;
+};
+
+}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_COLUMNAR_TABLE_HPP
@@ -16,6 +16,19 @@ BOOST_SQLITE_BEGIN_NAMESPACE
 
 constexpr static cstring_ref in_memory = ":memory:";
 
+namespace detail
+{
+
+// The prepared statements used by transaction & savepoint, see transaction.hpp
+struct control_statements;
+struct control_statements_deleter
+{
+  BOOST_SQLITE_DECL void operator()(control_statements * cs) const noexcept;
+};
+BOOST_SQLITE_DECL control_statements * control_statements_of(connection & conn);
+
+}
+
 /** @brief main object for a connection to a database.
   @ingroup reference
 
@@ -34,7 +47,7 @@ struct connection
     /// Returns the handle
     handle_type handle() const { return impl_.get(); }
     /// Release the owned handle.
-    handle_type release() &&    { return impl_.release(); }
+    handle_type release() &&    { control_.reset(); return impl_.release(); }
 
     ///Default constructor
     connection() = default;
@@ -154,6 +167,10 @@ struct connection
     };
 
     std::unique_ptr<sqlite3, deleter_> impl_{nullptr, deleter_{}};
+    // destroyed before impl_, so the statements are finalized before the connection closes.
+    std::unique_ptr<detail::control_statements, detail::control_statements_deleter> control_;
+
+    friend detail::control_statements * detail::control_statements_of(connection & conn);
 };
 
 BOOST_SQLITE_END_NAMESPACE
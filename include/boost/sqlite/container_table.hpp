@@ -0,0 +1,385 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_CONTAINER_TABLE_HPP
+#define BOOST_SQLITE_CONTAINER_TABLE_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/row_cursor.hpp>
+#include <boost/sqlite/vtable.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/function.hpp>
+#include <boost/mp11/utility.hpp>
+
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <utility>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+// how the rows of a container are found by rowid.
+template<typename Container>
+using container_mapped_type = typename Container::mapped_type;
+template<typename Container>
+using container_key_compare = typename Container::key_compare;
+
+template<typename Key>
+bool container_key_in_range(sqlite3_int64 id)
+{
+  using limits = std::numeric_limits<Key>;
+  if (id < 0)
+    return limits::is_signed && id >= static_cast<sqlite3_int64>((limits::min)());
+  return static_cast<sqlite3_uint64>(id) <= static_cast<sqlite3_uint64>((limits::max)());
+}
+
+template<typename Container,
+         int Kind = !mp11::mp_valid<container_mapped_type, Container>::value ? 0 :
+                     mp11::mp_valid<container_key_compare, Container>::value ? 1 : 2>
+struct container_access
+{
+  static_assert(
+      std::is_base_of<std::random_access_iterator_tag,
+                      typename std::iterator_traits<typename Container::const_iterator>::iterator_category>::value,
+      "A sequence container needs random access, the index is used as rowid.");
+
+  using iterator = typename Container::const_iterator;
+  using value_type = typename Container::value_type;
+  // ranges on the rowid can be positioned
+  constexpr static bool ordered = true;
+
+  static const value_type & get(iterator itr) { return *itr; }
+  static sqlite3_int64 row_id(const Container & c, iterator itr)
+  {
+    return static_cast<sqlite3_int64>(itr - c.begin());
+  }
+  static iterator find(const Container & c, sqlite3_int64 id)
+  {
+    return id >= 0 && static_cast<std::size_t>(id) < c.size() ? c.begin() + id : c.end();
+  }
+  static iterator lower_bound(const Container & c, sqlite3_int64 id)
+  {
+    if (id <= 0)
+      return c.begin();
+    return static_cast<std::size_t>(id) < c.size() ? c.begin() + id : c.end();
+  }
+  // the cost of positioning the cursor
+  static double seek_cost(double) { return 1.; }
+};
+
+template<typename Container>
+struct container_access<Container, 1>
+{
+  static_assert(std::is_integral<typename Container::key_type>::value, "The key is used as rowid, so it must be integral.");
+  using iterator = typename Container::const_iterator;
+  using value_type = typename Container::mapped_type;
+  constexpr static bool ordered = true;
+
+  static const value_type & get(iterator itr) { return itr->second; }
+  static sqlite3_int64 row_id(const Container &, iterator itr) { return static_cast<sqlite3_int64>(itr->first); }
+  static iterator find(const Container & c, sqlite3_int64 id)
+  {
+    if (!container_key_in_range<typename Container::key_type>(id))
+      return c.end();
+    return c.find(static_cast<typename Container::key_type>(id));
+  }
+  static iterator lower_bound(const Container & c, sqlite3_int64 id)
+  {
+    if (!container_key_in_range<typename Container::key_type>(id))
+      return id < 0 ? c.begin() : c.end();
+    return c.lower_bound(static_cast<typename Container::key_type>(id));
+  }
+  static double seek_cost(double rows) { return rows > 2. ? std::log2(rows) : 1.; }
+};
+
+template<typename Container>
+struct container_access<Container, 2>
+{
+  static_assert(std::is_integral<typename Container::key_type>::value, "The key is used as rowid, so it must be integral.");
+  using iterator = typename Container::const_iterator;
+  using value_type = typename Container::mapped_type;
+  // hashed containers can only find single rows
+  constexpr static bool ordered = false;
+
+  static const value_type & get(iterator itr) { return itr->second; }
+  static sqlite3_int64 row_id(const Container &, iterator itr) { return static_cast<sqlite3_int64>(itr->first); }
+  static iterator find(const Container & c, sqlite3_int64 id)
+  {
+    if (!container_key_in_range<typename Container::key_type>(id))
+      return c.end();
+    return c.find(static_cast<typename Container::key_type>(id));
+  }
+  static double seek_cost(double) { return 1.; }
+};
+
+enum container_index_flags
+{
+  container_index_eq           = 1,
+  container_index_lower        = 2,
+  container_index_lower_strict = 4,
+  container_index_upper        = 8,
+  container_index_upper_strict = 16
+};
+
+// applies numeric affinity to the rowid constraint and computes an inclusive bound.
+// returns false if no rowid can match.
+BOOST_SQLITE_DECL bool container_rowid_eq   (value v, sqlite3_int64 & id);
+BOOST_SQLITE_DECL bool container_rowid_lower(value v, bool strict, sqlite3_int64 & lo);
+BOOST_SQLITE_DECL bool container_rowid_upper(value v, bool strict, sqlite3_int64 & hi);
+
+}
+
+namespace vtab
+{
+
+template<typename Container>
+struct container_cursor final : cursor<>
+{
+  using access = detail::container_access<Container>;
+  using row = detail::container_row<typename access::value_type>;
+
+  explicit container_cursor(const Container & container)
+    : container_(&container), itr_(container.begin()), end_(container.end()) {}
+
+  result<void> filter(int index, const char * , span<sqlite::value> values)
+  {
+    itr_ = container_->begin();
+    end_ = container_->end();
+    filter_impl(index, values, std::integral_constant<bool, access::ordered>{});
+    return {};
+  }
+
+  result<void> next() { ++itr_; return {}; }
+  bool eof() noexcept { return itr_ == end_; }
+  result<sqlite3_int64> row_id() { return access::row_id(*container_, itr_); }
+  result<void> reset() { itr_ = container_->begin(); end_ = container_->end(); return {}; }
+
+  void column(context<> ctx, int i, bool /* no_change */)
+  {
+    const auto & r = access::get(itr_);
+    mp11::mp_with_index<row::size>(
+        static_cast<std::size_t>(i),
+        [&](auto Idx)
+        {
+          detail::set_container_column(ctx, row::template get<Idx>(r));
+        });
+  }
+
+ private:
+  bool filter_eq(int index, span<sqlite::value> values)
+  {
+    if ((index & detail::container_index_eq) == 0)
+      return false;
+    sqlite3_int64 id;
+    if (detail::container_rowid_eq(values[0], id))
+    {
+      itr_ = access::find(*container_, id);
+      if (itr_ != end_)
+        end_ = std::next(itr_);
+    }
+    else
+      itr_ = end_;
+    return true;
+  }
+
+  void filter_impl(int index, span<sqlite::value> values, std::false_type /* ordered */)
+  {
+    filter_eq(index, values);
+  }
+
+  void filter_impl(int index, span<sqlite::value> values, std::true_type /* ordered */)
+  {
+    if (filter_eq(index, values))
+      return;
+
+    auto lo = (std::numeric_limits<sqlite3_int64>::min)();
+    auto hi = (std::numeric_limits<sqlite3_int64>::max)();
+    auto arg = values.begin();
+    if ((index & detail::container_index_lower) &&
+        !detail::container_rowid_lower(*arg++, (index & detail::container_index_lower_strict) != 0, lo))
+      return void(itr_ = end_);
+    if ((index & detail::container_index_upper) &&
+        !detail::container_rowid_upper(*arg++, (index & detail::container_index_upper_strict) != 0, hi))
+      return void(itr_ = end_);
+
+    if (lo > hi)
+      return void(itr_ = end_);
+    if (lo != (std::numeric_limits<sqlite3_int64>::min)())
+      itr_ = access::lower_bound(*container_, lo);
+    if (hi != (std::numeric_limits<sqlite3_int64>::max)())
+      end_ = access::lower_bound(*container_, hi + 1);
+  }
+
+  const Container * container_;
+  typename access::iterator itr_, end_;
+};
+
+/** @brief A read-only virtual table over a container of structs.
+    @ingroup reference
+
+    Every public member becomes a column. The members are found with Boost.Describe if the struct is described,
+    std::tuple & std::pair map to columns `c0`, `c1`, ..., otherwise Boost.PFR gets used.
+
+    The rowid depends on the container:
+
+    @li Random access sequences, e.g. `std::vector`, use the index as rowid.
+        Equality and ranges on the rowid are positioned in O(1).
+    @li Ordered maps with an integral key, e.g. `std::map`, use the key as rowid.
+        Equality and ranges on the rowid are positioned in O(log n).
+    @li Hashed maps with an integral key, e.g. `std::unordered_map`, use the key as rowid.
+        Equality is O(1), ranges need a full scan.
+
+    The table only holds a pointer to the container, which must outlive it and must not be modified while a query runs.
+ */
+template<typename Container>
+struct container_table final : table<container_cursor<Container>>, cursor_pool
+{
+  using access = detail::container_access<Container>;
+  using row = detail::container_row<typename access::value_type>;
+
+  explicit container_table(const Container & container) : container_(&container)
+  {
+    std::string buf;
+    declaration_ = "create table x(";
+    mp11::mp_for_each<mp11::mp_iota_c<row::size>>(
+        [&](auto Idx)
+        {
+          using member_type = typename std::decay<decltype(row::template get<Idx>(std::declval<const typename access::value_type&>()))>::type;
+          if (Idx != 0u)
+            declaration_ += ", ";
+          declaration_ += '"';
+          declaration_ += row::template name<Idx>(buf);
+          declaration_ += '"';
+          declaration_ += detail::container_column_type<member_type>();
+        });
+    declaration_ += ");";
+  }
+
+  const char * declaration() { return declaration_.c_str(); }
+
+  result<container_cursor<Container>> open()
+  {
+    return container_cursor<Container>{*container_};
+  }
+
+  result<void> best_index(index_info & info)
+  {
+    const auto rows = static_cast<double>(container_->size());
+    const sqlite3_index_info::sqlite3_index_constraint * eq = nullptr, * lower = nullptr, * upper = nullptr;
+    for (auto & ct : info.constraints())
+    {
+      if (!ct.usable || ct.iColumn != -1)
+        continue;
+      switch (ct.op)
+      {
+        case SQLITE_INDEX_CONSTRAINT_EQ:
+          if (!eq) eq = &ct;
+          break;
+        case SQLITE_INDEX_CONSTRAINT_GT: BOOST_FALLTHROUGH;
+        case SQLITE_INDEX_CONSTRAINT_GE:
+          if (!lower && access::ordered) lower = &ct;
+          break;
+        case SQLITE_INDEX_CONSTRAINT_LT: BOOST_FALLTHROUGH;
+        case SQLITE_INDEX_CONSTRAINT_LE:
+          if (!upper && access::ordered) upper = &ct;
+          break;
+        default:
+          break;
+      }
+    }
+
+    // sqlite still checks the constraints, so non-integral operands keep their usual semantics.
+    int index = 0, argv = 1;
+    double estimate = rows;
+    if (eq)
+    {
+      index = detail::container_index_eq;
+      info.usage_of(*eq).argvIndex = argv++;
+      estimate = 1.;
+#if SQLITE_VERSION_NUMBER >= 3009000
+      info.set_index_scan_flags(SQLITE_INDEX_SCAN_UNIQUE);
+#endif
+    }
+    else
+    {
+      if (lower)
+      {
+        index |= detail::container_index_lower;
+        if (lower->op == SQLITE_INDEX_CONSTRAINT_GT)
+          index |= detail::container_index_lower_strict;
+        info.usage_of(*lower).argvIndex = argv++;
+        estimate /= 4.;
+      }
+      if (upper)
+      {
+        index |= detail::container_index_upper;
+        if (upper->op == SQLITE_INDEX_CONSTRAINT_LT)
+          index |= detail::container_index_upper_strict;
+        info.usage_of(*upper).argvIndex = argv++;
+        estimate /= 4.;
+      }
+    }
+
+    const auto order_by = info.order_by();
+    if (order_by.size() == 1u && order_by[0].iColumn == -1 && !order_by[0].desc && (access::ordered || eq))
+      info.set_already_ordered();
+
+    estimate = (std::max)(estimate, 1.);
+    info.set_index(index);
+    info.set_estimated_cost(index == 0 ? (std::max)(rows, 1.) : access::seek_cost(rows) + estimate);
+#if SQLITE_VERSION_NUMBER >= 3008200
+    info.set_estimated_rows(static_cast<sqlite3_int64>(index == 0 ? rows : estimate));
+#endif
+    return {};
+  }
+
+ private:
+  const Container * container_;
+  std::string declaration_;
+};
+
+/** @brief An eponymous module for a container_table.
+    @ingroup reference
+
+    @par Example
+    @code{.cpp}
+    struct entry { std::string name; double price; };
+    BOOST_DESCRIBE_STRUCT(entry, (), (name, price));
+
+    std::vector<entry> cache = load_cache();
+    sqlite::create_module(conn, "cache", sqlite::vtab::make_container_module(cache));
+    auto st = conn.prepare("select name from cache where rowid between 100 and 200 and price > 10");
+    @endcode
+ */
+template<typename Container>
+struct container_module final : eponymous_module<container_table<Container>>
+{
+  explicit container_module(const Container & container) : container_(&container) {}
+
+  result<container_table<Container>> connect(connection_ref, int, const char * const [])
+  {
+    return container_table<Container>{*container_};
+  }
+ private:
+  const Container * container_;
+};
+
+/// Create a container_module for `container`. @ingroup reference
+template<typename Container>
+container_module<Container> make_container_module(const Container & container)
+{
+  return container_module<Container>{container};
+}
+
+}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_CONTAINER_TABLE_HPP
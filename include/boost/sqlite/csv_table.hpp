@@ -0,0 +1,186 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_CSV_TABLE_HPP
+#define BOOST_SQLITE_CSV_TABLE_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/cstring_ref.hpp>
+#include <boost/sqlite/error.hpp>
+#include <boost/sqlite/vtable.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace vtab
+{
+
+/// The format of a csv file. @ingroup reference
+struct csv_options
+{
+  /// The field separator, e.g. `'\t'` for tsv.
+  char delimiter = ',';
+  /// The quote character. Quotes inside a quoted field are escaped by doubling them.
+  char quote = '"';
+  /// Whether the first row holds the column names. Otherwise the columns are named `c0`, `c1`, ...
+  bool header = true;
+  /// The number of rows between two entries of the row offset index.
+  std::size_t index_stride = 64u;
+  /// The number of threads used to index large files. `0` uses `std::thread::hardware_concurrency()`.
+  std::size_t threads = 0u;
+  /// Files smaller than this are indexed on the calling thread.
+  std::size_t parallel_threshold = 64u * 1024u * 1024u;
+};
+
+/// A field of a csv row, pointing into the mapped file. @ingroup reference
+struct csv_field
+{
+  const char * begin = nullptr;
+  const char * end = nullptr;
+  /// The field contains doubled quotes, that need to be unescaped.
+  bool escaped = false;
+};
+
+/** @brief A memory mapped, read-only csv file with a sparse index of the row offsets.
+    @ingroup reference
+
+    Every `index_stride`-th row start is stored, so finding a row by its number
+    scans at most `index_stride - 1` rows.
+ */
+struct csv_file
+{
+  csv_file() = default;
+  BOOST_SQLITE_DECL csv_file(csv_file && lhs) noexcept;
+  BOOST_SQLITE_DECL csv_file& operator=(csv_file && lhs) noexcept;
+  BOOST_SQLITE_DECL ~csv_file();
+
+  ///@{
+  /// Map & index the file.
+  BOOST_SQLITE_DECL void open(cstring_ref path, const csv_options & options,
+                              system::error_code & ec, error_info & ei);
+  BOOST_SQLITE_DECL void open(cstring_ref path, const csv_options & options = {});
+  ///@}
+
+  /// Unmap the file.
+  BOOST_SQLITE_DECL void close() noexcept;
+
+  bool is_open() const noexcept { return is_open_; }
+
+  /// The number of rows, excluding the header.
+  std::size_t size() const noexcept { return rows_; }
+  /// The number of columns, as determined by the header or the first row.
+  std::size_t column_count() const noexcept { return names_.size(); }
+  const std::string & column_name(std::size_t idx) const { return names_.at(idx); }
+  const csv_options & options() const noexcept { return options_; }
+
+  /// The start of the row with index `idx`. Requires `idx < size()`.
+  BOOST_SQLITE_DECL const char * row_begin(std::size_t idx) const noexcept;
+  /// The end of the mapped file.
+  const char * end() const noexcept { return data_ + size_; }
+
+  /// Returns the start of the row after the one starting at `row`.
+  BOOST_SQLITE_DECL const char * skip_row(const char * row) const noexcept;
+  /// Split up to `count` leading fields of the row at `row` into `fields` & return the start of the next row.
+  BOOST_SQLITE_DECL const char * split_row(const char * row, std::size_t count, std::vector<csv_field> & fields) const;
+
+  /// Get the text of a field, `buffer` is used if the field needs to be unescaped.
+  BOOST_SQLITE_DECL string_view decode(const csv_field & field, std::string & buffer) const;
+
+ private:
+  BOOST_SQLITE_DECL void build_index();
+
+  const char * data_ = nullptr;
+  std::size_t size_ = 0u;
+  bool is_open_ = false;
+#if defined(BOOST_WINDOWS_API)
+  void * file_ = nullptr, * mapping_ = nullptr;
+#endif
+  csv_options options_;
+  std::vector<std::string> names_;
+  // offsets of every index_stride-th row
+  std::vector<std::uint64_t> index_;
+  std::size_t rows_ = 0u;
+};
+
+/// The cursor of a csv_table. @ingroup reference
+struct csv_cursor final : cursor<>
+{
+  explicit csv_cursor(const csv_file & file) noexcept : file_(&file) {}
+
+  BOOST_SQLITE_DECL result<void> filter(int index, const char * index_data, span<sqlite::value> values);
+  BOOST_SQLITE_DECL result<void> next();
+  bool eof() noexcept { return row_ >= end_row_; }
+  BOOST_SQLITE_DECL void column(context<> ctx, int idx, bool no_change);
+  result<sqlite3_int64> row_id() noexcept { return static_cast<sqlite3_int64>(row_ + 1u); }
+  result<void> reset() noexcept { row_ = end_row_ = 0u; return {}; }
+
+ private:
+  void load();
+
+  const csv_file * file_;
+  const char * next_ = nullptr;
+  std::size_t row_ = 0u, end_row_ = 0u;
+  // the number of leading fields that get split, as derived from the used columns.
+  std::size_t split_count_ = 0u;
+  std::vector<csv_field> fields_;
+  std::string buffer_;
+};
+
+/** @brief A read-only virtual table over a csv file.
+    @ingroup reference
+
+    The rowid is the 1-based row number. All values are text.
+ */
+struct csv_table final : table<csv_cursor>, cursor_pool
+{
+  BOOST_SQLITE_DECL explicit csv_table(csv_file file);
+
+  const char * declaration() { return declaration_.c_str(); }
+  result<csv_cursor> open() { return csv_cursor{file_}; }
+  BOOST_SQLITE_DECL result<void> best_index(index_info & info);
+
+ private:
+  csv_file file_;
+  std::string declaration_;
+};
+
+/** @brief A module for csv_table.
+    @ingroup reference
+
+    The arguments are `key=value` pairs, a single argument without a key is the filename:
+
+     - `filename` the path of the file
+     - `header` `yes` or `no`
+     - `delimiter` a single character or `tab`
+     - `quote` a single character
+     - `threads` the number of threads used to build the index
+
+    Anything not specified uses the options passed to the constructor.
+
+    @par Example
+    @code{.cpp}
+    sqlite::create_module(conn, "csv", sqlite::vtab::csv_module());
+    conn.execute("create virtual table trades using csv(filename='trades.csv', header=yes)");
+    auto st = conn.prepare("select symbol, sum(cast(volume as integer)) from trades group by symbol");
+    @endcode
+ */
+struct csv_module final : module<csv_table>
+{
+  explicit csv_module(csv_options options = {}) : options_(options) {}
+
+  BOOST_SQLITE_DECL result<csv_table> create (connection_ref db, int argc, const char * const argv[]);
+  BOOST_SQLITE_DECL result<csv_table> connect(connection_ref db, int argc, const char * const argv[]);
+
+ private:
+  csv_options options_;
+};
+
+}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_CSV_TABLE_HPP
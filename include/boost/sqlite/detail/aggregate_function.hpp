@@ -18,6 +18,8 @@
 #include <boost/callable_traits/has_void_return.hpp>
 #include <boost/core/span.hpp>
 
+#include <tuple>
+
 
 BOOST_SQLITE_BEGIN_NAMESPACE
 
@@ -36,6 +38,28 @@ struct aggregate_function_maker
   }
 };
 
+// Can `Func` be constructed from the stored argument tuple without throwing?
+template<typename Func, typename Args>
+struct is_nothrow_aggregate_constructible : std::false_type {};
+
+template<typename Func, typename ... Args>
+struct is_nothrow_aggregate_constructible<Func, std::tuple<Args...>>
+    : std::is_nothrow_constructible<Func, Args&...> {};
+
+// If neither construction nor the member function can throw,
+// execute_context_function can skip the exception frame.
+template<typename Func, typename Args, typename Span>
+struct is_nothrow_aggregate_step
+    : std::integral_constant<bool,
+                             is_nothrow_aggregate_constructible<Func, Args>::value &&
+                             noexcept(std::declval<Func&>().step(std::declval<Span>()))> {};
+
+template<typename Func, typename Args>
+struct is_nothrow_aggregate_final
+    : std::integral_constant<bool,
+                             is_nothrow_aggregate_constructible<Func, Args>::value &&
+                             noexcept(std::declval<Func&>().final())> {};
+
 template<typename Func, typename Args>
 int create_aggregate_function(sqlite3 * db, cstring_ref name, Args && args, int flags,
                               std::true_type /* void return */)
@@ -44,6 +68,8 @@ int create_aggregate_function(sqlite3 * db, cstring_ref name, Args && args, int
   using span_type    = typename std::tuple_element<1U, args_type>::type;
   using func_type    = typename std::decay<Func>::type;
   using func_args_type    = typename std::decay<Args>::type;
+  using nothrow_step      = is_nothrow_aggregate_step<func_type, func_args_type, span_type>;
+  using nothrow_final     = is_nothrow_aggregate_final<func_type, func_args_type>;
 
   return sqlite3_create_function_v2(
       db, name.c_str(),
@@ -59,7 +85,7 @@ int create_aggregate_function(sqlite3 * db, cstring_ref name, Args && args, int
 
         execute_context_function(
             ctx,
-            [&]() -> result<void>
+            [&]() noexcept(nothrow_step::value) -> result<void>
             {
               if (c == nullptr)
               {
@@ -79,7 +105,7 @@ int create_aggregate_function(sqlite3 * db, cstring_ref name, Args && args, int
 
         execute_context_function(
             ctx,
-            [&]() -> result<decltype(c->final())>
+            [&]() noexcept(nothrow_final::value) -> result<decltype(c->final())>
             {
               if (c == nullptr)
               {
@@ -93,7 +119,7 @@ int create_aggregate_function(sqlite3 * db, cstring_ref name, Args && args, int
               return c->final();
             });
       },
-      [](void * ptr) noexcept { delete_(static_cast<func_type*>(ptr));}
+      [](void * ptr) noexcept { delete_(static_cast<func_args_type*>(ptr));}
   );
 }
 
@@ -106,6 +132,8 @@ int create_aggregate_function(sqlite3 * db, cstring_ref name, Args && args, int
   using span_type    = typename std::tuple_element<1U, args_type>::type;
   using func_type    = typename std::decay<Func>::type;
   using func_args_type    = typename std::decay<Args>::type;
+  using nothrow_step      = is_nothrow_aggregate_step<func_type, func_args_type, span_type>;
+  using nothrow_final     = is_nothrow_aggregate_final<func_type, func_args_type>;
 
   return sqlite3_create_function_v2(
       db, name.c_str(),
@@ -121,7 +149,7 @@ int create_aggregate_function(sqlite3 * db, cstring_ref name, Args && args, int
 
         execute_context_function(
             ctx,
-            [&]() -> result<void>
+            [&]() noexcept(nothrow_step::value) -> result<void>
             {
               if (c == nullptr)
               {
@@ -140,7 +168,7 @@ int create_aggregate_function(sqlite3 * db, cstring_ref name, Args && args, int
 
         execute_context_function(
             ctx,
-            [&]() -> result<decltype(c->final())>
+            [&]() noexcept(nothrow_final::value) -> result<decltype(c->final())>
             {
               if (c == nullptr)
               {
@@ -154,7 +182,7 @@ int create_aggregate_function(sqlite3 * db, cstring_ref name, Args && args, int
               return c->final();
             });
       },
-      [](void * ptr) noexcept { delete_(static_cast<func_type*>(ptr));}
+      [](void * ptr) noexcept { delete_(static_cast<func_args_type*>(ptr));}
   );
 }
 
@@ -0,0 +1,171 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_DETAIL_ARGUMENT_HPP
+#define BOOST_SQLITE_DETAIL_ARGUMENT_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/blob.hpp>
+#include <boost/sqlite/cstring_ref.hpp>
+#include <boost/sqlite/value.hpp>
+
+#include <boost/mp11/integer_sequence.hpp>
+#include <boost/mp11/list.hpp>
+#include <string>
+#include <type_traits>
+
+namespace boost { template<typename> class optional;}
+
+#if __cplusplus >= 201702L
+#include  <optional>
+#endif
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+// Converts the sqlite3_value passed into a function into a typed argument.
+// `check` is only given the type, so the check is a single sqlite3_value_type call per argument.
+template<typename T, typename = void>
+struct argument_converter {};
+
+template<typename T>
+struct argument_converter<T, typename std::enable_if<std::is_integral<T>::value>::type>
+{
+  static const char * expected() noexcept {return "integer";}
+  static bool check(value_type vt) noexcept {return vt == value_type::integer;}
+  static T get(value v) noexcept {return static_cast<T>(v.get_int());}
+};
+
+template<typename T>
+struct argument_converter<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+  static const char * expected() noexcept {return "floating";}
+  static bool check(value_type vt) noexcept {return vt == value_type::floating || vt == value_type::integer;}
+  static T get(value v) noexcept {return static_cast<T>(v.get_double());}
+};
+
+template<>
+struct argument_converter<string_view>
+{
+  static const char * expected() noexcept {return "text";}
+  static bool check(value_type vt) noexcept {return vt == value_type::text;}
+  static string_view get(value v) noexcept {return v.get_text();}
+};
+
+template<>
+struct argument_converter<cstring_ref>
+{
+  static const char * expected() noexcept {return "text";}
+  static bool check(value_type vt) noexcept {return vt == value_type::text;}
+  static cstring_ref get(value v) noexcept {return v.get_text();}
+};
+
+template<typename Traits, typename Allocator>
+struct argument_converter<std::basic_string<char, Traits, Allocator>>
+{
+  static const char * expected() noexcept {return "text";}
+  static bool check(value_type vt) noexcept {return vt == value_type::text;}
+  static std::basic_string<char, Traits, Allocator> get(value v)
+  {
+    auto t = v.get_text();
+    return {t.begin(), t.end()};
+  }
+};
+
+template<>
+struct argument_converter<blob_view>
+{
+  static const char * expected() noexcept {return "blob";}
+  static bool check(value_type vt) noexcept {return vt == value_type::blob;}
+  static blob_view get(value v) noexcept {return v.get_blob();}
+};
+
+template<>
+struct argument_converter<blob>
+{
+  static const char * expected() noexcept {return "blob";}
+  static bool check(value_type vt) noexcept {return vt == value_type::blob;}
+  static blob get(value v) {return blob(v.get_blob());}
+};
+
+template<>
+struct argument_converter<value>
+{
+  static const char * expected() noexcept {return "value";}
+  static bool check(value_type) noexcept {return true;}
+  static value get(value v) noexcept {return v;}
+};
+
+#if __cplusplus >= 201702L
+template<typename T>
+struct argument_converter<std::optional<T>, decltype(void(argument_converter<T>::check))>
+{
+  static const char * expected() noexcept {return argument_converter<T>::expected();}
+  static bool check(value_type vt) noexcept
+  {
+    return vt == value_type::null || argument_converter<T>::check(vt);
+  }
+  static std::optional<T> get(value v) noexcept(noexcept(argument_converter<T>::get(v)))
+  {
+    if (v.is_null())
+      return std::nullopt;
+    return argument_converter<T>::get(v);
+  }
+};
+#endif
+
+template<typename T>
+struct argument_converter<boost::optional<T>, decltype(void(argument_converter<T>::check))>
+{
+  static const char * expected() noexcept {return argument_converter<T>::expected();}
+  static bool check(value_type vt) noexcept
+  {
+    return vt == value_type::null || argument_converter<T>::check(vt);
+  }
+  static boost::optional<T> get(value v) noexcept(noexcept(argument_converter<T>::get(v)))
+  {
+    if (v.is_null())
+      return boost::optional<T>();
+    return boost::optional<T>(argument_converter<T>::get(v));
+  }
+};
+
+template<typename T, typename = void>
+struct is_argument : std::false_type {};
+
+template<typename T>
+struct is_argument<T, decltype(void(argument_converter<typename std::decay<T>::type>::check))>
+    : std::true_type {};
+
+template<typename T>
+using argument_converter_t = argument_converter<typename std::decay<T>::type>;
+
+// Check the types of all arguments, sets an error on the context & returns false on mismatch.
+template<typename ... Ts, std::size_t ... Is>
+bool check_arguments(mp11::mp_list<Ts...>, mp11::index_sequence<Is...>,
+                     sqlite3_context * ctx, const value * args) noexcept
+{
+  const bool ok[] = {true, argument_converter_t<Ts>::check(args[Is].type())...};
+  const char * expected[] = {nullptr, argument_converter_t<Ts>::expected()...};
+  for (std::size_t i = 0u; i < sizeof...(Ts); i++)
+    if (!ok[i + 1u])
+    {
+      char msg[128];
+      sqlite3_snprintf(sizeof(msg), msg, "argument %d: expected %s, got %s",
+                       static_cast<int>(i + 1u), expected[i + 1u],
+                       value_type_name(args[i].type()));
+      sqlite3_result_error(ctx, msg, -1);
+      sqlite3_result_error_code(ctx, SQLITE_MISMATCH);
+      return false;
+    }
+  return true;
+}
+
+}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_DETAIL_ARGUMENT_HPP
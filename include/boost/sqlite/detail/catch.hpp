@@ -26,7 +26,7 @@ template<typename Func, typename ... Args>
 void execute_context_function_impl(std::false_type /* is_void */,
                                    sqlite3_context * ctx,
                                    Func && func, Args && ... args)
-    noexcept(noexcept(std::forward<Func>(func)(std::forward<Args>(args)...)))
+    noexcept(noexcept(set_result(ctx, std::forward<Func>(func)(std::forward<Args>(args)...))))
 {
   set_result(ctx, std::forward<Func>(func)(std::forward<Args>(args)...));
 }
@@ -50,8 +50,21 @@ int extract_error(char * &errMsg, result<T> & res)
 }
 
 
+// Neither the function nor setting its result can throw, so we don't need an exception frame.
 template<typename Func, typename ... Args>
-void execute_context_function(sqlite3_context * ctx,
+void execute_context_function(std::true_type /* is_nothrow */,
+                              sqlite3_context * ctx,
+                              Func && func, Args && ... args) noexcept
+{
+  using return_type = decltype(func(std::forward<Args>(args)...));
+  execute_context_function_impl(std::is_void<return_type>{}, ctx,
+                                std::forward<Func>(func),
+                                std::forward<Args>(args)...);
+}
+
+template<typename Func, typename ... Args>
+void execute_context_function(std::false_type /* is_nothrow */,
+                              sqlite3_context * ctx,
                               Func && func, Args && ... args) noexcept
 {
   using return_type = decltype(func(std::forward<Args>(args)...));
@@ -88,6 +101,21 @@ void execute_context_function(sqlite3_context * ctx,
 #endif
 }
 
+template<typename Func, typename ... Args>
+void execute_context_function(sqlite3_context * ctx,
+                              Func && func, Args && ... args) noexcept
+{
+  using return_type = decltype(func(std::forward<Args>(args)...));
+  using is_nothrow = std::integral_constant<
+      bool,
+      noexcept(execute_context_function_impl(std::is_void<return_type>{}, ctx,
+                                             std::forward<Func>(func),
+                                             std::forward<Args>(args)...))>;
+  execute_context_function(is_nothrow{}, ctx,
+                           std::forward<Func>(func),
+                           std::forward<Args>(args)...);
+}
+
 }
 BOOST_SQLITE_END_NAMESPACE
 
@@ -6,6 +6,8 @@
 #define BOOST_SQLITE_DETAIL_SCALAR_FUNCTION_HPP
 
 #include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/detail/argument.hpp>
+#include <boost/sqlite/detail/catch.hpp>
 #include <boost/sqlite/cstring_ref.hpp>
 #include <boost/sqlite/memory.hpp>
 #include <boost/sqlite/result.hpp>
@@ -15,6 +17,11 @@
 #include <boost/callable_traits/return_type.hpp>
 #include <boost/callable_traits/has_void_return.hpp>
 #include <boost/core/span.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/function.hpp>
+#include <boost/mp11/tuple.hpp>
+
+#include <tuple>
 
 
 BOOST_SQLITE_BEGIN_NAMESPACE
@@ -75,13 +82,7 @@ auto create_scalar_function_impl(sqlite3 * db,
         auto &f = *reinterpret_cast<func_type*>(sqlite3_user_data(ctx));
         boost::span<value, Extent> vals{aa, static_cast<std::size_t>(len)};
 
-        execute_context_function(
-            ctx,
-            [&]()
-            {
-              f(cc, vals);
-              return result<void>();
-            });
+        execute_context_function(ctx, f, cc, vals);
 
       }, nullptr, nullptr,
       +[](void * ptr){delete_(static_cast<func_type*>(ptr));}
@@ -135,17 +136,115 @@ auto create_scalar_function_impl(sqlite3 * db,
         auto aa =  reinterpret_cast<value*>(args);
         auto  f = *reinterpret_cast<Func*>(sqlite3_user_data(ctx));
         boost::span<value, Extent> vals{aa, static_cast<std::size_t>(len)};
-        execute_context_function(
-            ctx,
-            [&]()
-            {
-              f(cc, vals);
-              return result<void>();
-            });
+        execute_context_function(ctx, f, cc, vals);
 
       }, nullptr, nullptr, nullptr);
 }
 
+template<typename Func>
+void * make_function_user_data(Func && func, std::false_type /* is pointer */)
+{
+  return new (memory_tag{}) typename std::decay<Func>::type(std::forward<Func>(func));
+}
+
+template<typename Func>
+void * make_function_user_data(Func func, std::true_type /* is pointer */)
+{
+  return reinterpret_cast<void*>(func);
+}
+
+template<typename Func>
+Func & get_function(sqlite3_context * ctx, std::false_type /* is pointer */)
+{
+  return *static_cast<Func*>(sqlite3_user_data(ctx));
+}
+
+template<typename Func>
+Func get_function(sqlite3_context * ctx, std::true_type /* is pointer */)
+{
+  return reinterpret_cast<Func>(sqlite3_user_data(ctx));
+}
+
+template<typename Func>
+auto function_user_data_deleter(std::false_type /* is pointer */) -> void(*)(void*)
+{
+  return +[](void * ptr) noexcept {delete_(static_cast<Func*>(ptr));};
+}
+
+template<typename Func>
+auto function_user_data_deleter(std::true_type /* is pointer */) -> void(*)(void*)
+{
+  return nullptr;
+}
+
+// Converts the arguments inside execute_context_function, so a throwing conversion gets caught, too.
+template<typename ... Ts, std::size_t ... Is, typename Func, typename ... Prefix>
+void invoke_typed_function(mp11::mp_list<Ts...>, mp11::index_sequence<Is...>,
+                           sqlite3_context * ctx, Func && func, value * args,
+                           Prefix && ... prefix) noexcept
+{
+  execute_context_function(
+      ctx,
+      [&]() noexcept(noexcept(func(prefix..., argument_converter_t<Ts>::get(args[Is])...)))
+          -> decltype(func(prefix..., argument_converter_t<Ts>::get(args[Is])...))
+      {
+        return func(prefix..., argument_converter_t<Ts>::get(args[Is])...);
+      });
+}
+
+// Typed arguments, e.g. `(sqlite3_int64, string_view, std::optional<double>)`.
+template<typename Func, typename ... Ts, typename IsVoid, typename IsPointer>
+auto create_scalar_function_impl(sqlite3 * db,
+                                 cstring_ref name,
+                                 Func && func, int flags,
+                                 std::tuple<Ts...> * ,
+                                 IsVoid /* void return */,
+                                 IsPointer /* is pointer */)
+    -> typename std::enable_if<mp11::mp_all<is_argument<Ts>...>::value, int>::type
+{
+  using func_type = typename std::decay<Func>::type;
+  return sqlite3_create_function_v2(
+      db, name.c_str(),
+      static_cast<int>(sizeof...(Ts)),
+      SQLITE_UTF8 | flags,
+      make_function_user_data(std::forward<Func>(func), IsPointer{}),
+      +[](sqlite3_context* ctx, int, sqlite3_value** args)
+      {
+        auto aa = reinterpret_cast<value*>(args);
+        if (check_arguments(mp11::mp_list<Ts...>{}, mp11::index_sequence_for<Ts...>{}, ctx, aa))
+          invoke_typed_function(mp11::mp_list<Ts...>{}, mp11::index_sequence_for<Ts...>{},
+                                ctx, get_function<func_type>(ctx, IsPointer{}), aa);
+      }, nullptr, nullptr,
+      function_user_data_deleter<func_type>(IsPointer{}));
+}
+
+// Typed arguments with a leading context, e.g. `(context<std::string>, sqlite3_int64)`.
+template<typename Func, typename ... Args, typename ... Ts, typename IsVoid, typename IsPointer>
+auto create_scalar_function_impl(sqlite3 * db,
+                                 cstring_ref name,
+                                 Func && func, int flags,
+                                 std::tuple<context<Args...>, Ts...> * ,
+                                 IsVoid /* void return */,
+                                 IsPointer /* is pointer */)
+    -> typename std::enable_if<mp11::mp_all<is_argument<Ts>...>::value, int>::type
+{
+  using func_type = typename std::decay<Func>::type;
+  return sqlite3_create_function_v2(
+      db, name.c_str(),
+      static_cast<int>(sizeof...(Ts)),
+      SQLITE_UTF8 | flags,
+      make_function_user_data(std::forward<Func>(func), IsPointer{}),
+      +[](sqlite3_context* ctx, int, sqlite3_value** args)
+      {
+        auto aa = reinterpret_cast<value*>(args);
+        if (check_arguments(mp11::mp_list<Ts...>{}, mp11::index_sequence_for<Ts...>{}, ctx, aa))
+          invoke_typed_function(mp11::mp_list<Ts...>{}, mp11::index_sequence_for<Ts...>{},
+                                ctx, get_function<func_type>(ctx, IsPointer{}), aa,
+                                context<Args...>(ctx));
+      }, nullptr, nullptr,
+      function_user_data_deleter<func_type>(IsPointer{}));
+}
+
 template<typename Func>
 auto create_scalar_function(sqlite3 * db,
                      cstring_ref name,
@@ -165,6 +264,30 @@ auto create_scalar_function(sqlite3 * db,
 }
 
 
+template<typename ... Funcs>
+struct overload_set
+{
+  std::tuple<Funcs...> funcs;
+};
+
+// Registers one function per arity, a later overload with the same arity replaces the previous one.
+template<typename ... Funcs>
+int create_scalar_function(sqlite3 * db,
+                           cstring_ref name,
+                           overload_set<Funcs...> overloads,
+                           int flags)
+{
+  int res = SQLITE_OK;
+  mp11::tuple_for_each(
+      std::move(overloads.funcs),
+      [&](auto && func)
+      {
+        if (res == SQLITE_OK)
+          res = create_scalar_function(db, name, std::forward<decltype(func)>(func), flags);
+      });
+  return res;
+}
+
 }
 
 BOOST_SQLITE_END_NAMESPACE
@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_DETAIL_SCAN_HPP
+#define BOOST_SQLITE_DETAIL_SCAN_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/core/bit.hpp>
+
+#include <cstdint>
+
+#if !defined(BOOST_SQLITE_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BOOST_SQLITE_SSE2 1
+#endif
+#endif
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+namespace detail
+{
+
+// Find the first of the four characters in [p, end), 16 bytes at a time where possible.
+inline const char * find_any(const char * p, const char * end, char c1, char c2, char c3, char c4) noexcept
+{
+#if defined(BOOST_SQLITE_SSE2)
+  const auto v1 = _mm_set1_epi8(c1), v2 = _mm_set1_epi8(c2), v3 = _mm_set1_epi8(c3), v4 = _mm_set1_epi8(c4);
+  for (; end - p >= 16; p += 16)
+  {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const auto hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, v1), _mm_cmpeq_epi8(chunk, v2)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(chunk, v3), _mm_cmpeq_epi8(chunk, v4)));
+    const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hit));
+    if (mask != 0u)
+      return p + core::countr_zero(mask);
+  }
+#endif
+  for (; p != end; p++)
+    if (*p == c1 || *p == c2 || *p == c3 || *p == c4)
+      return p;
+  return end;
+}
+
+// Find the first character that needs escaping in a json string, i.e. `"`, `\` or a control character.
+inline const char * find_json_escape(const char * p, const char * end) noexcept
+{
+#if defined(BOOST_SQLITE_SSE2)
+  const auto quote = _mm_set1_epi8('"'), backslash = _mm_set1_epi8('\\'), control = _mm_set1_epi8(0x1F);
+  for (; end - p >= 16; p += 16)
+  {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    // unsigned chunk <= 0x1F
+    const auto ctrl = _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk);
+    const auto hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)), ctrl);
+    const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hit));
+    if (mask != 0u)
+      return p + core::countr_zero(mask);
+  }
+#endif
+  for (; p != end; p++)
+    if (*p == '"' || *p == '\\' || static_cast<unsigned char>(*p) < 0x20u)
+      return p;
+  return end;
+}
+
+}
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_DETAIL_SCAN_HPP
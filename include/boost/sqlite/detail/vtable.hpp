@@ -30,7 +30,7 @@ static int connect(sqlite3 * db, void * pAux, int argc, const char * const * arg
     if (rtab.has_error())
       return extract_error(*errMsg, rtab);
 
-    auto tab = make_unique<table_type>(std::move(*rtab));
+    auto tab = sqlite::make_unique<table_type>(std::move(*rtab));
     tab->db_ = db;
     auto code = sqlite3_declare_vtab(db, tab->declaration());
     if (code != SQLITE_OK)
@@ -64,7 +64,7 @@ static int create(sqlite3 * db, void * pAux, int argc, const char * const * argv
     if (rtab.has_error())
       return extract_error(*errMsg, rtab);
 
-    auto tab = make_unique<table_type>(std::move(*rtab));
+    auto tab = sqlite::make_unique<table_type>(std::move(*rtab));
     tab->db_ = db;
 
     auto code = sqlite3_declare_vtab(db, tab->declaration());
@@ -164,6 +164,64 @@ static int close(sqlite3_vtab_cursor * cursor)
 
 }
 
+template<typename Cursor>
+static void destroy_cursor(sqlite3_vtab_cursor * cursor)
+{
+  close<Cursor>(cursor);
+}
+
+template<typename Cursor>
+static bool reset_cursor(Cursor * p)
+{
+  BOOST_SQLITE_TRY
+  {
+    return !p->reset().has_error();
+  }
+#if !defined(BOOST_NO_EXCEPTIONS)
+  catch(...) {}
+#endif
+  return false;
+}
+
+template<typename Table>
+static int open_pooled(sqlite3_vtab *pVTab, sqlite3_vtab_cursor **ppCursor)
+{
+  sqlite::vtab::cursor_pool & pool = *static_cast<Table *>(pVTab);
+  if (pool.size_ == 0u)
+    return open<Table>(pVTab, ppCursor);
+
+  *ppCursor = pool.free_[--pool.size_];
+  return SQLITE_OK;
+}
+
+template<typename Table>
+static int close_pooled(sqlite3_vtab_cursor * cursor)
+{
+  using cursor_type = typename Table::cursor_type;
+  sqlite::vtab::cursor_pool & pool = *static_cast<Table *>(cursor->pVtab);
+  auto p = static_cast<cursor_type *>(cursor);
+  if (pool.size_ == pool.capacity || !reset_cursor(p))
+    return close<cursor_type>(cursor);
+
+  pool.destroy_ = &destroy_cursor<cursor_type>;
+  pool.free_[pool.size_++] = cursor;
+  return SQLITE_OK;
+}
+
+template<typename Module>
+static void assign_cursor_pool(sqlite3_module & /*md*/, const Module &,
+                               std::false_type /* cursor_pool */)
+{
+}
+
+template<typename Module>
+static void assign_cursor_pool(sqlite3_module & md, const Module &,
+                               std::true_type /* cursor_pool */)
+{
+  md.xOpen  = &open_pooled <typename Module::table_type>;
+  md.xClose = &close_pooled<typename Module::table_type>;
+}
+
 template<typename Table>
 static int best_index(sqlite3_vtab *pVTab, sqlite3_index_info* info)
 {
@@ -595,6 +653,7 @@ const sqlite3_module make_module(const Module & mod)
   vtab_impl::assign_transaction  (md, mod, std::is_base_of<sqlite::vtab::transaction,           table_type>{});
   vtab_impl::assign_find_function(md, mod, std::is_base_of<sqlite::vtab::overload_functions,    table_type>{});
   vtab_impl::assign_rename       (md, mod, std::is_base_of<sqlite::vtab::renamable,             table_type>{});
+  vtab_impl::assign_cursor_pool  (md, mod, std::is_base_of<sqlite::vtab::cursor_pool,           table_type>{});
 #if SQLITE_VERSION_NUMBER >= 3007007
   vtab_impl::assign_recursive_transaction(md, mod, std::is_base_of<sqlite::vtab::recursive_transaction, table_type>{});
 #endif
@@ -7,6 +7,7 @@
 #if SQLITE_VERSION_NUMBER >= 3025000
 
 #include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/detail/aggregate_function.hpp>
 #include <boost/sqlite/cstring_ref.hpp>
 #include <boost/sqlite/memory.hpp>
 #include <boost/sqlite/result.hpp>
@@ -29,6 +30,18 @@ struct window_function_maker
   }
 };
 
+template<typename Func, typename Args>
+struct is_nothrow_window_value
+    : std::integral_constant<bool,
+                             is_nothrow_aggregate_constructible<Func, Args>::value &&
+                             noexcept(std::declval<Func&>().value())> {};
+
+template<typename Func, typename Args, typename Span>
+struct is_nothrow_window_inverse
+    : std::integral_constant<bool,
+                             is_nothrow_aggregate_constructible<Func, Args>::value &&
+                             noexcept(std::declval<Func&>().inverse(std::declval<Span>()))> {};
+
 template<typename Func, typename Args>
 int create_window_function(sqlite3 * db, cstring_ref name, Args && args, int flags,
                            std::true_type /* is void */)
@@ -37,6 +50,9 @@ int create_window_function(sqlite3 * db, cstring_ref name, Args && args, int fla
   using span_type    = typename std::tuple_element<1U, args_type>::type;
   using func_type    = typename std::decay<Func>::type;
   using func_args_type    = typename std::decay<Args>::type;
+  using nothrow_step      = is_nothrow_aggregate_step<func_type, func_args_type, span_type>;
+  using nothrow_value     = is_nothrow_window_value<func_type, func_args_type>;
+  using nothrow_inverse   = is_nothrow_window_inverse<func_type, func_args_type, span_type>;
 
   return sqlite3_create_window_function(
       db, name.c_str(),
@@ -51,7 +67,7 @@ int create_window_function(sqlite3 * db, cstring_ref name, Args && args, int fla
 
         execute_context_function(
             ctx,
-            [&]() -> result<void>
+            [&]() noexcept(nothrow_step::value) -> result<void>
             {
               if (c == nullptr)
               {
@@ -72,7 +88,7 @@ int create_window_function(sqlite3 * db, cstring_ref name, Args && args, int fla
 
         execute_context_function(
             ctx,
-            [&]() -> result<decltype(c->value())>
+            [&]() noexcept(nothrow_value::value) -> result<decltype(c->value())>
             {
               if (c == nullptr)
               {
@@ -93,7 +109,7 @@ int create_window_function(sqlite3 * db, cstring_ref name, Args && args, int fla
         auto c = static_cast<func_type*>(sqlite3_aggregate_context(ctx, 0));
         execute_context_function(
             ctx,
-            [&]() -> result<decltype(c->value())>
+            [&]() noexcept(nothrow_value::value) -> result<decltype(c->value())>
             {
               if (c == nullptr)
               {
@@ -113,7 +129,7 @@ int create_window_function(sqlite3 * db, cstring_ref name, Args && args, int fla
         auto c = static_cast<func_type*>(sqlite3_aggregate_context(ctx, 0));
         execute_context_function(
             ctx,
-            [&]() -> result<decltype(c->inverse(span_type{aa, static_cast<std::size_t>(len)}))>
+            [&]() noexcept(nothrow_inverse::value) -> result<decltype(c->inverse(span_type{aa, static_cast<std::size_t>(len)}))>
             {
               if (c == nullptr)
               {
@@ -127,7 +143,7 @@ int create_window_function(sqlite3 * db, cstring_ref name, Args && args, int fla
             });
 
       },
-      [](void * ptr) /* xDestroy */ { delete_(static_cast<func_type*>(ptr));}
+      [](void * ptr) /* xDestroy */ { delete_(static_cast<func_args_type*>(ptr));}
   );
 }
 
@@ -139,6 +155,9 @@ int create_window_function(sqlite3 * db, cstring_ref name, Args && args, int fla
   using span_type    = typename std::tuple_element<1U, args_type>::type;
   using func_type    = typename std::decay<Func>::type;
   using func_args_type    = typename std::decay<Args>::type;
+  using nothrow_step      = is_nothrow_aggregate_step<func_type, func_args_type, span_type>;
+  using nothrow_value     = is_nothrow_window_value<func_type, func_args_type>;
+  using nothrow_inverse   = is_nothrow_window_inverse<func_type, func_args_type, span_type>;
 
   return sqlite3_create_window_function(
       db, name.c_str(),
@@ -153,7 +172,7 @@ int create_window_function(sqlite3 * db, cstring_ref name, Args && args, int fla
 
         execute_context_function(
             ctx,
-            [&]() -> result<decltype(c->step(span_type{aa, static_cast<std::size_t>(len)}))>
+            [&]() noexcept(nothrow_step::value) -> result<decltype(c->step(span_type{aa, static_cast<std::size_t>(len)}))>
             {
               if (c == nullptr)
               {
@@ -172,7 +191,7 @@ int create_window_function(sqlite3 * db, cstring_ref name, Args && args, int fla
         auto c = static_cast<func_type*>(sqlite3_aggregate_context(ctx, 0));
         execute_context_function(
             ctx,
-            [&]() -> result<decltype(c->value())>
+            [&]() noexcept(nothrow_value::value) -> result<decltype(c->value())>
             {
               if (c == nullptr)
               {
@@ -193,7 +212,7 @@ int create_window_function(sqlite3 * db, cstring_ref name, Args && args, int fla
         auto c = static_cast<func_type*>(sqlite3_aggregate_context(ctx, 0));
         execute_context_function(
             ctx,
-            [&]() -> result<decltype(c->value())>
+            [&]() noexcept(nothrow_value::value) -> result<decltype(c->value())>
             {
               if (c == nullptr)
               {
@@ -213,7 +232,7 @@ int create_window_function(sqlite3 * db, cstring_ref name, Args && args, int fla
         auto c = static_cast<func_type*>(sqlite3_aggregate_context(ctx, 0));
         execute_context_function(
             ctx,
-            [&]() -> result<decltype(c->inverse(span_type{aa, static_cast<std::size_t>(len)}))>
+            [&]() noexcept(nothrow_inverse::value) -> result<decltype(c->inverse(span_type{aa, static_cast<std::size_t>(len)}))>
             {
               if (c == nullptr)
               {
@@ -226,7 +245,7 @@ int create_window_function(sqlite3 * db, cstring_ref name, Args && args, int fla
             });
 
       },
-      [](void * ptr) /* xDestroy */ { delete_(static_cast<func_type*>(ptr));}
+      [](void * ptr) /* xDestroy */ { delete_(static_cast<func_args_type*>(ptr));}
   );
 }
 
@@ -37,18 +37,51 @@ struct error_info
     /// Initialization constructor.
     error_info(core::string_view msg) noexcept : msg_(new (memory_tag{}) char[msg.size() + 1u])
     {
-      std::memcpy(msg_.get(), msg.data(), (std::min)(msg.size() + 1, capacity()));
+      copy_(msg);
     }
 
     /// set the message by copy
     void set_message(core::string_view msg)
     {
+      db_ = nullptr;
       reserve(msg.size() + 1u);
-      std::memcpy(msg_.get(), msg.data(), (std::min)(msg.size() + 1, capacity()));
+      copy_(msg);
     }
+
+    /** @brief Opt into taking the message from the connection when it is requested, instead of copying it.
+
+        This neither allocates nor copies, so it's cheap for errors that are expected, e.g. constraint violations.
+        A lazy message is only valid until the connection is used or closed,
+        so it must be read or `detach`ed before that.
+     */
+    void set_lazy(bool lazy = true) noexcept
+    {
+      lazy_ = lazy;
+    }
+
+    /// Check if messages of a connection are taken lazily.
+    bool lazy() const noexcept {return lazy_;}
+
+    /// Set the message of the connection, by copy unless the error_info is `lazy`.
+    void set_message(sqlite3 * db)
+    {
+      if (!lazy_)
+        return set_message(core::string_view(sqlite3_errmsg(db)));
+      clear();
+      db_ = db;
+    }
+
+    /// Copy the message of the connection, if taken lazily, so it doesn't depend on the connection anymore.
+    void detach()
+    {
+      if (db_ != nullptr)
+        set_message(core::string_view(sqlite3_errmsg(db_)));
+    }
+
     /// transfer ownership into the message
     void reset(char * c = nullptr)
     {
+      db_ = nullptr;
       msg_.reset(c);
     }
 
@@ -58,6 +91,7 @@ struct error_info
     {
       va_list args;
       va_start(args, fmt);
+      db_ = nullptr;
       msg_.reset(sqlite3_vmprintf(fmt, args));
       va_end(args);
       return msg_.get();
@@ -68,6 +102,7 @@ struct error_info
     {
       va_list args;
       va_start(args, fmt);
+      db_ = nullptr;
       msg_.reset(sqlite3_vmprintf(fmt.c_str(), args));
       va_end(args);
       return msg_.get();
@@ -81,6 +116,7 @@ struct error_info
         return "";
       va_list args;
       va_start(args, fmt);
+      db_ = nullptr;
       sqlite3_vsnprintf(static_cast<int>(capacity()), msg_.get(), fmt, args);
       va_end(args);
       return msg_.get();
@@ -93,6 +129,7 @@ struct error_info
         return "";
       va_list args;
       va_start(args, fmt);
+      db_ = nullptr;
       sqlite3_vsnprintf(static_cast<int>(capacity()), msg_.get(), fmt.c_str(), args);
       va_end(args);
       return msg_.get();
@@ -113,19 +150,45 @@ struct error_info
     std::size_t capacity() const {return msg_ ? sqlite3_msize(msg_.get()) : 0u;}
 
     /// Gets the error message.
-    cstring_ref message() const noexcept { return msg_ ? msg_.get() : ""; }
+    cstring_ref message() const noexcept
+    {
+      if (db_ != nullptr)
+        return sqlite3_errmsg(db_);
+      return msg_ ? msg_.get() : "";
+    }
 
     char * release()
     {
+      detach();
       return msg_.release();
     }
     /// Restores the object to its initial state.
-    void clear() noexcept { if (msg_) *msg_ = '\0'; }
+    void clear() noexcept
+    {
+      db_ = nullptr;
+      if (msg_)
+        *msg_ = '\0';
+    }
 
 
-    operator bool() const {return msg_.operator bool();}
+    operator bool() const {return db_ != nullptr || msg_.operator bool();}
   private:
+    // msg doesn't need to be null-terminated, so only copy its characters & terminate it here.
+    void copy_(core::string_view msg) noexcept
+    {
+      const auto cap = capacity();
+      if (cap == 0u)
+        return;
+      const auto n = (std::min)(msg.size(), cap - 1u);
+      if (n > 0u)
+        std::memcpy(msg_.get(), msg.data(), n);
+      msg_.get()[n] = '\0';
+    }
+
     unique_ptr<char> msg_;
+    // the connection to get the message from, if set lazily.
+    sqlite3 * db_ = nullptr;
+    bool lazy_ = false;
 };
 
 
@@ -141,7 +204,7 @@ struct error
   /// The additional information of the error
   error_info info;
 
-  error(int code, error_info info) : code(code), info(std::move(info)) {}
+  error(int code, error_info info) : code(code), info(std::move(info)) { this->info.detach(); }
   explicit error(int code)                  : code(code)                        {}
   error(int code, core::string_view info)
           : code(code),
@@ -149,7 +212,11 @@ struct error
 
   error(system::error_code code, error_info info)
           : code(code.category() == sqlite_category() ? code.value() : SQLITE_FAIL),
-            info(std::move(info)) {}
+            info(std::move(info))
+  {
+    // an error may outlive the state of the connection.
+    this->info.detach();
+  }
 
   error(system::error_code code) : code(code.category() == sqlite_category() ? code.value() : SQLITE_FAIL)
   {
@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_EXPORT_HPP
+#define BOOST_SQLITE_EXPORT_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/error.hpp>
+#include <boost/sqlite/statement.hpp>
+
+#include <memory>
+#include <type_traits>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+/// The output format of export_rows. @ingroup reference
+enum class export_format
+{
+  /// RFC 4180, fields with delimiters, quotes or newlines are quoted.
+  csv,
+  /// Tab separated, with tabs, newlines & backslashes escaped by a backslash.
+  tsv,
+  /// One json object per row, keyed by the column names.
+  ndjson
+};
+
+/// How blobs get written by export_rows. @ingroup reference
+enum class blob_encoding
+{
+  hex,
+  base64
+};
+
+/// The options for export_rows. @ingroup reference
+struct export_options
+{
+  export_format format = export_format::csv;
+  /// The field separator for csv.
+  char delimiter = ',';
+  /// Write the column names as the first line for csv & tsv.
+  bool header = true;
+  blob_encoding blobs = blob_encoding::hex;
+  /// The size of the output buffer. The sink is invoked whenever it's full.
+  std::size_t buffer_size = 64u * 1024u;
+};
+
+/** @brief A reference to a function receiving the output of export_rows.
+    @ingroup reference
+
+    The function needs to have the signature `void(string_view data, system::error_code & ec)`.
+    The sink only references the function, which must stay alive while export_rows runs.
+ */
+struct export_sink
+{
+  template<typename Func,
+           typename = typename std::enable_if<!std::is_same<typename std::decay<Func>::type, export_sink>::value>::type>
+  export_sink(Func && func) noexcept
+      : func_(const_cast<void*>(static_cast<const void*>(std::addressof(func)))),
+        write_(+[](void * func, string_view data, system::error_code & ec)
+                {
+                  (*static_cast<typename std::remove_reference<Func>::type*>(func))(data, ec);
+                })
+  {
+  }
+
+  void operator()(string_view data, system::error_code & ec) const { write_(func_, data, ec); }
+
+ private:
+  void * func_;
+  void (*write_)(void *, string_view, system::error_code &);
+};
+
+///@{
+/** @brief Step through `stmt` & write all rows to `sink`.
+    @ingroup reference
+
+    The output is formatted into a single reusable buffer, which gets handed to the sink when full,
+    so the memory use doesn't depend on the size of the result.
+
+    @returns The number of rows written.
+
+    @par Example
+    @code{.cpp}
+    auto stmt = conn.prepare("select * from orders where day = ?");
+    stmt.bind(1, today);
+    sqlite::export_options opts;
+    opts.format = sqlite::export_format::ndjson;
+    sqlite::export_rows(stmt, STDOUT_FILENO, opts);
+    @endcode
+ */
+BOOST_SQLITE_DECL
+std::size_t export_rows(statement & stmt, export_sink sink, const export_options & options,
+                        system::error_code & ec, error_info & ei);
+BOOST_SQLITE_DECL
+std::size_t export_rows(statement & stmt, export_sink sink, const export_options & options = {});
+
+/// Write the rows to a file descriptor.
+BOOST_SQLITE_DECL
+std::size_t export_rows(statement & stmt, int fd, const export_options & options,
+                        system::error_code & ec, error_info & ei);
+BOOST_SQLITE_DECL
+std::size_t export_rows(statement & stmt, int fd, const export_options & options = {});
+///@}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_EXPORT_HPP
@@ -153,6 +153,13 @@ struct context
  `func` must take `context<Args...>` as the first and a `span<value, N>` as the second value.
  If `N` is not `dynamic_extent` it will be used to deduce the number of arguments for the function.
 
+ Alternatively `func` can take typed arguments, optionally after a `context<Args...>`,
+ e.g. `(sqlite3_int64, string_view, std::optional<double>)`.
+ The number of arguments gets deduced from the signature and the type of every argument is checked before invocation,
+ a mismatch results in an `SQLITE_MISMATCH` error. Use `overloads` to register multiple arities under one name.
+
+ If `func` is `noexcept` and its result can be set without throwing, it is invoked without an exception handler.
+
  @par Example
 
  @code{.cpp}
@@ -257,6 +264,31 @@ auto create_scalar_function(
 }
 ///@}
 
+/** @brief Combine multiple functions with typed arguments into an overload set.
+   @ingroup reference
+
+ Passing the result to `create_scalar_function` registers every function under the same name,
+ so that sqlite picks the function based on the number of arguments.
+ Functions with the same number of arguments replace the previously registered one.
+
+ @par Example
+
+ @code{.cpp}
+  extern sqlite::connection conn;
+
+  sqlite::create_scalar_function(
+    conn, "pad",
+    sqlite::overloads(
+      [](sqlite::string_view s) { return std::string(s) + " "; },
+      [](sqlite::string_view s, sqlite3_int64 n) { return std::string(s) + std::string(n, ' '); }));
+  @endcode
+ */
+template<typename ... Funcs>
+detail::overload_set<typename std::decay<Funcs>::type...> overloads(Funcs && ... funcs)
+{
+  return {std::make_tuple(std::forward<Funcs>(funcs)...)};
+}
+
 
 ///@{
 /** @brief create a aggregate function
@@ -77,13 +77,14 @@ bool commit_hook_impl(sqlite3 * db,
                       std::false_type)
 {
   static_assert(noexcept(func()), "hook must be noexcept");
+  using func_type = typename std::remove_reference<Func>::type;
   return sqlite3_commit_hook(
       db,
-      [](void * data) { return (*static_cast<Func *>(data))() ? 1 : 0; },
+      [](void * data) { return (*static_cast<func_type *>(data))() ? 1 : 0; },
       &func) != nullptr;
 }
 
-inline bool commit_hook(sqlite3 * db, std::nullptr_t, std::false_type)
+inline bool commit_hook_impl(sqlite3 * db, std::nullptr_t, std::false_type)
 {
   return sqlite3_commit_hook(db, nullptr, nullptr);
 }
@@ -116,9 +117,10 @@ bool rollback_hook_impl(sqlite3 * db,
                       std::false_type)
 {
   static_assert(noexcept(func()), "hook must be noexcept");
+  using func_type = typename std::remove_reference<Func>::type;
   return sqlite3_rollback_hook(
       db,
-      [](void * data) { (*static_cast<Func *>(data))(); },
+      [](void * data) { (*static_cast<func_type *>(data))(); },
       &func) != nullptr;
 }
 
@@ -252,6 +254,93 @@ bool update_hook(sqlite3 * db,
   return update_hook_impl(db, std::forward<Func>(func), std::is_pointer<func_type>{});
 }
 
+template<typename Func>
+bool wal_hook_impl(sqlite3 * db,
+                   Func * func,
+                   std::true_type)
+{
+  static_assert(noexcept(func("", 0)), "hook must be noexcept");
+  return sqlite3_wal_hook(
+      db,
+      [](void * data, sqlite3 *, const char * db_name, int pages)
+      {
+        (*static_cast<Func *>(data))(db_name, pages);
+        return SQLITE_OK;
+      }, reinterpret_cast<void*>(func)) != nullptr;
+}
+
+template<typename Func>
+bool wal_hook_impl(sqlite3 * db,
+                   Func && func,
+                   std::false_type)
+{
+  static_assert(noexcept(func("", 0)), "hook must be noexcept");
+  using func_type = typename std::remove_reference<Func>::type;
+  return sqlite3_wal_hook(
+      db,
+      [](void * data, sqlite3 *, const char * db_name, int pages)
+      {
+        (*static_cast<func_type *>(data))(db_name, pages);
+        return SQLITE_OK;
+      }, &func) != nullptr;
+}
+
+inline bool wal_hook_impl(sqlite3 * db, std::nullptr_t, std::false_type)
+{
+  return sqlite3_wal_hook(db, nullptr, nullptr) != nullptr;
+}
+
+template<typename Func>
+bool wal_hook(sqlite3 * db,
+              Func && func)
+{
+  using func_type    = typename std::decay<Func>::type;
+  return wal_hook_impl(db, std::forward<Func>(func), std::is_pointer<func_type>{});
+}
+
+
+template<typename Func>
+void busy_handler_impl(sqlite3 * db,
+                       Func * func,
+                       std::true_type)
+{
+  static_assert(noexcept(func(0)), "busy handler must be noexcept");
+  sqlite3_busy_handler(
+      db,
+      [](void * data, int count) -> int
+      {
+        return (*static_cast<Func *>(data))(count) ? 1 : 0;
+      }, reinterpret_cast<void*>(func));
+}
+
+template<typename Func>
+void busy_handler_impl(sqlite3 * db,
+                       Func && func,
+                       std::false_type)
+{
+  static_assert(noexcept(func(0)), "busy handler must be noexcept");
+  using func_type = typename std::remove_reference<Func>::type;
+  sqlite3_busy_handler(
+      db,
+      [](void * data, int count) -> int
+      {
+        return (*static_cast<func_type *>(data))(count) ? 1 : 0;
+      }, &func);
+}
+
+inline void busy_handler_impl(sqlite3 * db, std::nullptr_t, std::false_type)
+{
+  sqlite3_busy_handler(db, nullptr, nullptr);
+}
+
+template<typename Func>
+void busy_handler(sqlite3 * db,
+                  Func && func)
+{
+  using func_type    = typename std::decay<Func>::type;
+  busy_handler_impl(db, std::forward<Func>(func), std::is_pointer<func_type>{});
+}
+
 
 }
 
@@ -365,6 +454,60 @@ bool update_hook(connection_ref conn, Func && func)
   return detail::update_hook(conn.handle(), std::forward<Func>(func));
 }
 
+/**
+  @brief Install a write-ahead log hook
+  @ingroup reference
+
+  @see [related sqlite documentation](https://www.sqlite.org/c3ref/wal_hook.html)
+
+  The wal hook gets called after a transaction got committed to the write-ahead log.
+
+  @note If the function is not a free function pointer, this function will *NOT* take ownership.
+
+  The signature of the function is `void(const char * db_name, int pages) noexcept`,
+  where `pages` is the number of frames in the log.
+
+  @note Installing a wal hook disables the automatic checkpoints set up by `sqlite3_wal_autocheckpoint` & vice versa.
+
+  @note If `func` is a `nullptr` the hook gets reset.
+
+  @param conn The database connection to install the hook in
+  @param func The hook function
+  @return true if an hook has been replaced.
+ */
+template<typename Func>
+bool wal_hook(connection_ref conn, Func && func)
+{
+  return detail::wal_hook(conn.handle(), std::forward<Func>(func));
+}
+
+/**
+  @brief Install a busy handler
+  @ingroup reference
+
+  @see [related sqlite documentation](https://www.sqlite.org/c3ref/busy_handler.html)
+
+  The busy handler gets called when a table is locked by another connection.
+  `count` is the number of times it has been called for the same lock, starting at zero.
+  If `func` returns true, sqlite tries to acquire the lock again, otherwise the statement fails with `SQLITE_BUSY`.
+
+  @note If the function is not a free function pointer, this function will *NOT* take ownership.
+
+  The signature of the function is `bool(int count) noexcept`.
+
+  @note A connection has only one busy handler, so this replaces the one set up by `busy_timeout` & vice versa.
+
+  @note If `func` is a `nullptr` the handler gets reset.
+
+  @param conn The database connection to install the handler in
+  @param func The handler function
+ */
+template<typename Func>
+void busy_handler(connection_ref conn, Func && func)
+{
+  detail::busy_handler(conn.handle(), std::forward<Func>(func));
+}
+
 BOOST_SQLITE_END_NAMESPACE
 
 #endif //BOOST_SQLITE_HOOKS_HPP
@@ -0,0 +1,135 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_HYPERLOGLOG_HPP
+#define BOOST_SQLITE_HYPERLOGLOG_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/blob.hpp>
+#include <boost/sqlite/connection_ref.hpp>
+#include <boost/sqlite/error.hpp>
+#include <boost/sqlite/result.hpp>
+#include <boost/sqlite/value.hpp>
+
+#include <boost/core/bit.hpp>
+#include <boost/core/span.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+/** @brief A HyperLogLog sketch for approximate distinct counts.
+    @ingroup reference
+
+    The sketch has a fixed size of `2^precision` one-byte registers, i.e. 16KiB,
+    which gives a standard error of about 0.8%.
+    It does not allocate, so it can live directly in the aggregate context.
+
+    The estimate uses Ertl's improved raw estimator, which is accurate over the whole range
+    without the empirical bias tables of HLL++.
+
+    Sketches are mergeable and can be serialized into a blob.
+ */
+struct hyperloglog
+{
+  constexpr static unsigned precision = 14u;
+  constexpr static std::size_t register_count = std::size_t(1u) << precision;
+
+  /// Add a hash value. The hash needs to be uniformly distributed over all 64 bits.
+  void add_hash(std::uint64_t hash) noexcept
+  {
+    constexpr unsigned q = 64u - precision;
+    const auto idx = static_cast<std::size_t>(hash >> q);
+    const auto w = hash << precision;
+    const auto rho = static_cast<std::uint8_t>(w == 0u ? q + 1u : (std::min)(static_cast<unsigned>(core::countl_zero(w)) + 1u, q + 1u));
+    if (rho > registers[idx])
+      registers[idx] = rho;
+  }
+
+  /// Add a value, NULLs are ignored. Values that compare equal in sqlite, such as `1` and `1.0` hash equally.
+  void add(const value & v) noexcept
+  {
+    if (!v.is_null())
+      add_hash(hash(v));
+  }
+
+  /// Merge another sketch into this one.
+  BOOST_SQLITE_DECL void merge(const hyperloglog & other) noexcept;
+  /// Merge a serialized sketch, fails with `SQLITE_MISMATCH` if `bv` isn't a valid sketch.
+  BOOST_SQLITE_DECL result<void> merge(blob_view bv) noexcept;
+
+  /// The estimated number of distinct values.
+  BOOST_SQLITE_DECL double estimate() const noexcept;
+  /// Serialize the sketch.
+  BOOST_SQLITE_DECL blob to_blob() const;
+
+  /// The 64 bit hash used for sqlite values.
+  BOOST_SQLITE_DECL static std::uint64_t hash(const value & v) noexcept;
+
+  std::uint8_t registers[register_count] = {};
+};
+
+namespace detail
+{
+
+struct approx_count_distinct
+{
+  void step(span<sqlite::value, 1u> args) noexcept { state.add(args[0]); }
+  sqlite3_int64 final() noexcept { return static_cast<sqlite3_int64>(state.estimate() + .5); }
+
+  hyperloglog state;
+};
+
+struct hll_sketch
+{
+  void step(span<sqlite::value, 1u> args) noexcept { state.add(args[0]); }
+  blob final() { return state.to_blob(); }
+
+  hyperloglog state;
+};
+
+struct hll_merge
+{
+  result<void> step(span<sqlite::value, 1u> args) noexcept
+  {
+    if (args[0].is_null())
+      return {};
+    return state.merge(args[0].get_blob());
+  }
+  blob final() { return state.to_blob(); }
+
+  hyperloglog state;
+};
+
+}
+
+///@{
+/** @brief Add the HyperLogLog functions to a connection.
+    @ingroup reference
+
+    The following functions get registered:
+
+    @li `approx_count_distinct(x)`, an aggregate estimating `count(distinct x)`
+    @li `hll_sketch(x)`, an aggregate returning the sketch as a blob
+    @li `hll_merge(sketch)`, an aggregate merging sketch blobs into one
+    @li `hll_estimate(sketch)`, a scalar function returning the estimate of a sketch
+
+    @par Example
+    @code{.cpp}
+    sqlite::create_hyperloglog_functions(conn);
+    conn.execute("insert into daily_visitors select date(ts), hll_sketch(user_id) from visits group by date(ts);");
+    auto st = conn.prepare("select hll_estimate(hll_merge(sketch)) from daily_visitors where day >= date('now', '-7 days');");
+    @endcode
+ */
+BOOST_SQLITE_DECL
+void create_hyperloglog_functions(connection_ref conn, system::error_code & ec, error_info & ei);
+
+BOOST_SQLITE_DECL
+void create_hyperloglog_functions(connection_ref conn);
+///@}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_HYPERLOGLOG_HPP
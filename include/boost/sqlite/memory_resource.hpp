@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_SQLITE_MEMORY_RESOURCE_HPP
+#define BOOST_SQLITE_MEMORY_RESOURCE_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/allocator.hpp>
+
+#if !defined(BOOST_SQLITE_HAS_MEMORY_RESOURCE) && defined(__has_include)
+# if __has_include(<memory_resource>) && (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#  define BOOST_SQLITE_HAS_MEMORY_RESOURCE 1
+# endif
+#endif
+
+#if BOOST_SQLITE_HAS_MEMORY_RESOURCE
+
+#include <boost/throw_exception.hpp>
+
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <new>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+/** @brief A `std::pmr::memory_resource` that allocates with `sqlite3_malloc64`.
+    @ingroup reference
+
+    Use `get_memory_resource` to obtain the instance, e.g. as the upstream of a pool or `arena`.
+
+    Allocations with an alignment above `allocator<char>::alignment` get over-allocated by the alignment and a pointer.
+
+    @note This is only available if the standard library provides `<memory_resource>`.
+ */
+struct memory_resource final : std::pmr::memory_resource
+{
+ private:
+  void * do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    constexpr auto natural = allocator<char>::alignment;
+    if (alignment <= natural)
+    {
+      auto p = sqlite3_malloc64(bytes);
+      if (p == nullptr)
+        boost::throw_exception(std::bad_alloc());
+      return p;
+    }
+
+    // store the pointer returned by sqlite in front of the aligned block.
+    // sqlite might only align to 4 bytes, so the pointer & the padding can take more than `alignment`.
+    if (bytes > (std::numeric_limits<std::size_t>::max)() - alignment - sizeof(void*))
+      boost::throw_exception(std::bad_alloc());
+    auto raw = static_cast<unsigned char*>(sqlite3_malloc64(bytes + alignment + sizeof(void*)));
+    if (raw == nullptr)
+      boost::throw_exception(std::bad_alloc());
+    auto addr = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+    addr = (addr + alignment - 1u) & ~(static_cast<std::uintptr_t>(alignment) - 1u);
+    auto aligned = reinterpret_cast<unsigned char*>(addr);
+    std::memcpy(aligned - sizeof(void*), &raw, sizeof(void*));
+    return aligned;
+  }
+
+  void do_deallocate(void * p, std::size_t, std::size_t alignment) override
+  {
+    if (alignment <= allocator<char>::alignment)
+      return sqlite3_free(p);
+
+    void * raw;
+    std::memcpy(&raw, static_cast<unsigned char*>(p) - sizeof(void*), sizeof(void*));
+    sqlite3_free(raw);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+  {
+    return dynamic_cast<const memory_resource*>(&other) != nullptr;
+  }
+};
+
+/// Returns the `memory_resource` that allocates with `sqlite3_malloc64`. @ingroup reference
+inline memory_resource * get_memory_resource() noexcept
+{
+  static memory_resource res;
+  return &res;
+}
+
+/** @brief A monotonic arena, that frees all its memory at once.
+    @ingroup reference
+
+    Deallocation is a no-op, so the short-lived allocations of a query,
+    e.g. in a function, a vtable cursor or for materialized rows,
+    only cost a pointer bump. Call `reset` after the query is done,
+    e.g. next to `statement::reset`, to give the memory back.
+
+    The arena is not thread-safe and gets its blocks from `get_memory_resource()` by default.
+
+    @par Example
+    @code{.cpp}
+    sqlite::arena arena;
+    std::pmr::vector<std::pmr::string> names{&arena};
+    auto st = conn.prepare("select name from users");
+    while (st.step())
+      names.emplace_back(st.current().at(0).get_text().c_str());
+    // ...
+    names.clear();
+    arena.reset();
+    @endcode
+ */
+struct arena : std::pmr::monotonic_buffer_resource
+{
+  /// Construct the arena, allocating the first block of `initial_size` bytes on first use.
+  explicit arena(std::size_t initial_size = 4096u,
+                 std::pmr::memory_resource * upstream = get_memory_resource())
+      : std::pmr::monotonic_buffer_resource(initial_size, upstream)
+  {
+  }
+
+  /// Construct the arena using `buffer` first, e.g. a stack buffer.
+  arena(void * buffer, std::size_t size,
+        std::pmr::memory_resource * upstream = get_memory_resource())
+      : std::pmr::monotonic_buffer_resource(buffer, size, upstream)
+  {
+  }
+
+  /// Free all allocations at once. Objects allocated from the arena must have been destroyed before.
+  void reset() noexcept { release(); }
+};
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif
+
+#endif //BOOST_SQLITE_MEMORY_RESOURCE_HPP
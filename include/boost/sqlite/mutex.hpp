@@ -9,6 +9,10 @@
 #define BOOST_SQLITE_MUTEX_HPP
 
 #include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/error.hpp>
+
+#include <chrono>
+#include <cstdint>
 #include <memory>
 
 BOOST_SQLITE_BEGIN_NAMESPACE
@@ -50,6 +54,52 @@ struct recursive_mutex
   std::unique_ptr<sqlite3_mutex, deleter_> impl_;
 };
 
+/// The settings of the mutexes installed by `install_adaptive_mutex`. @ingroup reference
+struct adaptive_mutex_options
+{
+  /// How often a contended lock gets tried before the thread blocks on it.
+  int spin = 100;
+};
+
+/// The contention counters of a class of sqlite mutexes, see `mutex_contention`. @ingroup reference
+struct mutex_metrics
+{
+  /// The number of times a mutex of the class was locked.
+  std::uint64_t acquisitions = 0u;
+  /// The number of locks that found the mutex held by another thread.
+  std::uint64_t contended = 0u;
+  /// The time the contended locks spent waiting.
+  std::chrono::nanoseconds wait_time{0};
+};
+
+///@{
+/**
+  @brief Make sqlite use adaptive mutexes that record their contention.
+  @ingroup reference
+
+  The mutexes spin for a while if they are held by another thread, before they block.
+  Each lock gets counted per mutex class, so `mutex_contention` can show
+  which of sqlite's mutexes, e.g. `SQLITE_MUTEX_STATIC_MEM` or `SQLITE_MUTEX_STATIC_LRU`, limit the throughput.
+
+  This uses `SQLITE_CONFIG_MUTEX`, so it must be called before sqlite is initialized,
+  or after `sqlite3_shutdown`. Otherwise it fails with `SQLITE_MISUSE`.
+  The mutexes are only used if sqlite is threadsafe, i.e. not in single-thread mode.
+
+  @see [related sqlite documentation](https://www.sqlite.org/c3ref/mutex_methods.html)
+ */
+BOOST_SQLITE_DECL void install_adaptive_mutex(const adaptive_mutex_options & options, system::error_code & ec);
+BOOST_SQLITE_DECL void install_adaptive_mutex(const adaptive_mutex_options & options = {});
+///@}
+
+/**
+  @brief The contention of a class of mutexes installed by `install_adaptive_mutex`.
+  @ingroup reference
+
+  `type` is one of the `SQLITE_MUTEX_*` constants.
+  The acquisitions of `SQLITE_MUTEX_FAST` & `SQLITE_MUTEX_RECURSIVE` mutexes get added once the mutex is freed.
+ */
+BOOST_SQLITE_DECL mutex_metrics mutex_contention(int type) noexcept;
+
 BOOST_SQLITE_END_NAMESPACE
 
 #endif //BOOST_SQLITE_MUTEX_HPP
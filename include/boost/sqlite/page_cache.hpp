@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_PAGE_CACHE_HPP
+#define BOOST_SQLITE_PAGE_CACHE_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/error.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+/// The settings of the page cache installed by `install_page_cache`. @ingroup reference
+struct page_cache_options
+{
+  /// The memory all connections together may use for pages that can be reloaded from the database.
+  std::size_t max_memory = 64u * 1024u * 1024u;
+  /// The number of independently locked shards the pages are distributed over.
+  std::size_t shards = 16u;
+};
+
+/// The counters of the page cache installed by `install_page_cache`. @ingroup reference
+struct page_cache_metrics
+{
+  /// Fetches that found the page in the cache.
+  std::uint64_t hits = 0u;
+  /// Fetches that didn't find the page in the cache.
+  std::uint64_t misses = 0u;
+  /// Pages that got evicted to stay within the memory budget.
+  std::uint64_t evictions = 0u;
+  /// The pages in the cache.
+  std::size_t pages = 0u;
+  /// The memory used by the pages, including pages of in-memory & temporary databases.
+  std::size_t memory_used = 0u;
+};
+
+///@{
+/**
+  @brief Install a page cache, which shares one memory budget between all connections.
+  @ingroup reference
+
+  By default, each connection limits its own cache by `pragma cache_size`,
+  so the memory used for pages grows with the number of connections.
+  This cache instead evicts pages of any connection that haven't been used recently,
+  once all connections together use `max_memory`, so a pool of connections can't exceed it.
+  `pragma cache_size` has no effect then.
+
+  The pages are distributed over `shards`, each with its own lock and its own share of the budget.
+  Pages get evicted with the CLOCK algorithm, i.e. a page that has been used since the last sweep gets a second chance.
+
+  Pages of in-memory & temporary databases hold the data itself, so they are never evicted & don't count against the budget.
+
+  This uses `SQLITE_CONFIG_PCACHE2`, so it must be called before sqlite is initialized,
+  or after `sqlite3_shutdown`. Otherwise it fails with `SQLITE_MISUSE`.
+
+  @note Each connection still has its own copy of a page, since sqlite modifies pages in its cache.
+        Use `SQLITE_OPEN_SHAREDCACHE` to share the pages between connections.
+
+  @see [related sqlite documentation](https://www.sqlite.org/c3ref/pcache_methods2.html)
+ */
+BOOST_SQLITE_DECL void install_page_cache(const page_cache_options & options, system::error_code & ec);
+BOOST_SQLITE_DECL void install_page_cache(const page_cache_options & options = {});
+///@}
+
+/// The counters of the page cache installed by `install_page_cache`. @ingroup reference
+BOOST_SQLITE_DECL page_cache_metrics page_cache_stats() noexcept;
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_PAGE_CACHE_HPP
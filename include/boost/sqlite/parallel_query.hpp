@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_SQLITE_PARALLEL_QUERY_HPP
+#define BOOST_SQLITE_PARALLEL_QUERY_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/detail/exception.hpp>
+#include <boost/sqlite/connection_ref.hpp>
+#include <boost/sqlite/cstring_ref.hpp>
+#include <boost/sqlite/error.hpp>
+#include <boost/sqlite/row.hpp>
+
+#include <boost/core/span.hpp>
+
+#include <iterator>
+#include <vector>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+BOOST_SQLITE_DECL
+void parallel_query(span<const connection_ref> pool,
+                    core::string_view sql,
+                    cstring_ref partition_column,
+                    std::size_t partitions,
+                    void (*func)(void * data, std::size_t partition, const row & r),
+                    void * data,
+                    system::error_code & ec,
+                    error_info & ei);
+
+}
+
+///@{
+/**
+  @brief Run a read query in parallel over multiple connections.
+  @ingroup reference
+
+  The query gets split into `partitions` disjoint ranges of the numeric `partition_column`,
+  each of which is run on one of the connections in `pool` from its own thread.
+
+  The bounds are obtained by running `select min(col), max(col) from (sql)` on the first connection,
+  each partition then runs `select * from (sql) where col >= ?1 and col < ?2 order by col`.
+  The `partition_column` must therefore be part of the result set, ideally the rowid or an indexed integer key.
+  Rows where it's null, text or a blob can't be in any partition, so the query fails with `SQLITE_MISMATCH`
+  before any row is delivered.
+
+  All connections need to be connected to the same database and may not have an open transaction.
+  If sqlite was compiled with `SQLITE_ENABLE_SNAPSHOT` and the database is in WAL mode,
+  all partitions will read the same snapshot.
+  Otherwise each connection opens its own read transaction.
+
+  @param pool A range of connections, that are convertible to `connection_ref`.
+  @param sql The query to partition. It must not be terminated by a semicolon.
+  @param partition_column The integer column used to partition the query.
+  @param partitions The number of partitions.
+  @param func The callback invoked for every row as `func(std::size_t partition, const row & r)`.
+  @param ec The system::error_code
+  @param ei Additional error information
+
+  @note `func` gets invoked concurrently from multiple threads, but never concurrently for the same partition.
+   Rows within a partition are delivered ordered by `partition_column`,
+   so collecting the rows per partition and concatenating them gives all rows ordered by it.
+
+  @throws system::system_error when the overload without `ec` is used.
+  Exceptions thrown by `func` stop all partitions and get rethrown from the calling thread.
+
+  @par Example
+  @code{.cpp}
+  std::vector<sqlite::connection> readers = open_readers("./my-database.db");
+  std::atomic<double> total{0.};
+
+  sqlite::parallel_query(readers, "select id, amount from orders", "id", 8,
+                         [&](std::size_t, const sqlite::row & r)
+                         {
+                           add(total, r[1].get_double());
+                         });
+  @endcode
+ */
+template<typename Pool, typename Func>
+void parallel_query(Pool && pool,
+                    core::string_view sql,
+                    cstring_ref partition_column,
+                    std::size_t partitions,
+                    Func && func,
+                    system::error_code & ec,
+                    error_info & ei)
+{
+  using func_type = typename std::remove_reference<Func>::type;
+  std::vector<connection_ref> conns;
+  for (auto && c : pool)
+    conns.emplace_back(c);
+
+  detail::parallel_query(
+      conns, sql, partition_column, partitions,
+      +[](void * data, std::size_t partition, const row & r)
+      {
+        (*static_cast<func_type*>(data))(partition, r);
+      },
+      &func, ec, ei);
+}
+
+template<typename Pool, typename Func>
+void parallel_query(Pool && pool,
+                    core::string_view sql,
+                    cstring_ref partition_column,
+                    std::size_t partitions,
+                    Func && func)
+{
+  system::error_code ec;
+  error_info ei;
+  parallel_query(std::forward<Pool>(pool), sql, partition_column, partitions,
+                 std::forward<Func>(func), ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+///@}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_PARALLEL_QUERY_HPP
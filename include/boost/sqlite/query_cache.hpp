@@ -0,0 +1,281 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_QUERY_CACHE_HPP
+#define BOOST_SQLITE_QUERY_CACHE_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/blob.hpp>
+#include <boost/sqlite/connection_ref.hpp>
+#include <boost/sqlite/error.hpp>
+#include <boost/sqlite/statement.hpp>
+#include <boost/sqlite/value.hpp>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+/// A value inside a cached_result. @ingroup reference
+struct cached_value
+{
+  /// The type of the value.
+  value_type type() const noexcept { return static_cast<value_type>(cell_->type); }
+  /// Is the held value null
+  bool is_null() const noexcept { return type() == value_type::null; }
+  /// Is the held value is not null
+  explicit operator bool () const noexcept { return !is_null(); }
+  /// Returns the value as an integer, text & blobs give 0.
+  BOOST_SQLITE_DECL sqlite3_int64 get_int() const noexcept;
+  /// Returns the value as a double, text & blobs give 0.
+  BOOST_SQLITE_DECL double get_double() const noexcept;
+  /// Returns the text, or the bytes of a blob. Numbers & null give an empty string.
+  BOOST_SQLITE_DECL core::string_view get_text() const noexcept;
+  /// Returns the bytes of a blob or text. Numbers & null give an empty blob.
+  BOOST_SQLITE_DECL blob_view get_blob() const noexcept;
+
+ private:
+  friend struct cached_result;
+  friend struct query_cache;
+  struct cell
+  {
+    // the integer, the bits of the double or the offset into the data.
+    std::uint64_t payload;
+    std::uint32_t size;
+    int type;
+  };
+
+  cached_value(const cell * c, const char * data) noexcept : cell_(c), data_(data) {}
+  const cell * cell_;
+  const char * data_;
+};
+
+/** @brief The rows of a query owned by the query_cache.
+    @ingroup reference
+
+    All values are stored in one array of fixed size cells, text & blobs in one shared buffer.
+ */
+struct cached_result
+{
+  /// The number of rows.
+  std::size_t size() const noexcept { return rows_; }
+  /// Check if no row was returned.
+  bool empty() const noexcept { return rows_ == 0u; }
+  /// The number of columns.
+  std::size_t column_count() const noexcept { return names_.size(); }
+  /// The name of a column.
+  core::string_view column_name(std::size_t column) const { return names_.at(column); }
+
+  /// The value at `row` & `column`, throws `std::out_of_range` if either is out of bounds.
+  BOOST_SQLITE_DECL cached_value at(std::size_t row, std::size_t column) const;
+
+  /// The bytes used by the result.
+  BOOST_SQLITE_DECL std::size_t memory_used() const noexcept;
+
+ private:
+  friend struct query_cache;
+  std::size_t rows_ = 0u;
+  std::vector<std::string> names_;
+  std::vector<cached_value::cell> cells_;
+  std::string data_;
+};
+
+/** @brief A cache of query results, invalidated through the update hook.
+    @ingroup reference
+
+    Results are cached by the sql & the bound parameters.
+    Every entry records the tables it read, which are reported by the authorizer while preparing the statement.
+    A change to one of those tables, reported by the update hook, drops the entry.
+    Changes made inside a transaction drop entries immediately
+    and prevent entries reading the changed tables from being cached until the transaction ends.
+    A rollback drops the entries reading the tables changed by the transaction again.
+
+    The cache keeps at most `max_memory` bytes of results & drops the least recently used ones beyond that.
+    Results are shared, i.e. a result handed out stays valid after it got dropped from the cache.
+
+    The cache installs the update & rollback hooks of the connection, replacing others,
+    and removes them when it gets destroyed, which needs to happen before the connection closes.
+
+    @note The update hook doesn't see changes made through other connections, to `WITHOUT ROWID` tables,
+    to virtual tables or to the schema, nor a `DELETE` without `WHERE` clause, which sqlite runs as a truncate.
+    Call `invalidate` or `clear` after those.
+    Queries with non-deterministic results, such as `random()` or `datetime('now')` should not be cached.
+
+    @note Preparing a statement with an authorizer makes sqlite recompile
+    the other prepared statements of the connection on their next reset. This happens on every cache miss.
+
+    @warning The cache replaces the authorizer of the connection while preparing a statement,
+    and sqlite doesn't allow reading the current authorizer, so one installed with `sqlite3_set_authorizer`
+    gets removed by the first cache miss. Use `query_cache::set_authorizer` instead,
+    which the cache restores after & chains to while preparing.
+
+    @par Example
+    @code{.cpp}
+    sqlite::query_cache cache{conn, 64u * 1024u * 1024u};
+
+    auto res = cache.query("select name, total from orders where customer = ?", {customer_id});
+    for (std::size_t i = 0u; i < res->size(); i++)
+      print(res->at(i, 0).get_text(), res->at(i, 1).get_double());
+    @endcode
+ */
+struct query_cache
+{
+  /// Create a cache for `conn` that holds up to `max_memory` bytes of results.
+  BOOST_SQLITE_DECL explicit query_cache(connection_ref conn, std::size_t max_memory = 16u * 1024u * 1024u);
+  query_cache(const query_cache & ) = delete;
+  query_cache& operator=(const query_cache & ) = delete;
+  BOOST_SQLITE_DECL ~query_cache();
+
+  ///@{
+  /// Get the result of `sql` with `params` bound from the cache, or run the query & cache it.
+  template<typename ArgRange = std::initializer_list<param_ref>>
+  std::shared_ptr<const cached_result> query(core::string_view sql, ArgRange && params,
+                                             system::error_code & ec, error_info & ei)
+  {
+    std::string key = sql_key(sql);
+    bool cacheable = true;
+    for (auto && p : params)
+      cacheable = cacheable && append_key(key, p);
+    if (cacheable)
+      if (auto res = find(key))
+        return res;
+
+    std::vector<std::string> tables;
+    auto stmt = prepare(sql, tables, ec, ei);
+    if (!ec)
+      stmt.bind(std::forward<ArgRange>(params), ec, ei);
+    if (ec)
+      return nullptr;
+    return run(cacheable ? &key : nullptr, stmt, std::move(tables), ec, ei);
+  }
+
+  template<typename ArgRange = std::initializer_list<param_ref>>
+  std::shared_ptr<const cached_result> query(core::string_view sql, ArgRange && params)
+  {
+    system::error_code ec;
+    error_info ei;
+    auto res = query(sql, std::forward<ArgRange>(params), ec, ei);
+    if (ec)
+      detail::throw_error_code(ec, ei);
+    return res;
+  }
+
+  std::shared_ptr<const cached_result> query(core::string_view sql, system::error_code & ec, error_info & ei)
+  {
+    return query(sql, std::initializer_list<param_ref>{}, ec, ei);
+  }
+
+  std::shared_ptr<const cached_result> query(core::string_view sql)
+  {
+    return query(sql, std::initializer_list<param_ref>{});
+  }
+  ///@}
+
+  /// The signature of the authorizer callback of sqlite.
+  using authorizer_type = int(*)(void*, int, const char*, const char*, const char*, const char*);
+
+  ///@{
+  /** @brief Install the authorizer of the connection, which must not be set through `sqlite3_set_authorizer`.
+
+      The authorizer is installed on the connection right away.
+      On a cache miss it also authorizes the statement prepared by the cache,
+      which temporarily replaces it & restores it afterwards.
+      The cache removes it when it gets destroyed.
+
+      The callable gets invoked as `int(int action, const char*, const char*, const char* database, const char* trigger) noexcept`
+      & must stay alive until it gets replaced or the cache is destroyed.
+
+      @see [related sqlite documentation](https://www.sqlite.org/c3ref/set_authorizer.html)
+   */
+  BOOST_SQLITE_DECL void set_authorizer(authorizer_type auth, void * data);
+
+  template<typename Func>
+  void set_authorizer(Func & func)
+  {
+    static_assert(noexcept(func(0, nullptr, nullptr, nullptr, nullptr)), "authorizer must be noexcept");
+    set_authorizer(
+        [](void * data, int action, const char * a, const char * b, const char * db, const char * trigger)
+        {
+          return (*static_cast<Func*>(data))(action, a, b, db, trigger);
+        }, &func);
+  }
+  ///@}
+
+  /// Drop all entries that read `table` of `database`. The name needs to be spelled as in the schema.
+  BOOST_SQLITE_DECL void invalidate(core::string_view table, core::string_view database = "main");
+  /// Drop all entries.
+  BOOST_SQLITE_DECL void clear() noexcept;
+
+  /// The number of cached results.
+  std::size_t size() const noexcept { return index_.size(); }
+  /// The bytes used by the cached results.
+  std::size_t memory_used() const noexcept { return memory_used_; }
+  /// The maximum number of bytes used by the cached results.
+  std::size_t max_memory() const noexcept { return max_memory_; }
+  /// The number of queries answered from the cache.
+  std::uint64_t hits() const noexcept { return hits_; }
+  /// The number of queries that had to run.
+  std::uint64_t misses() const noexcept { return misses_; }
+
+ private:
+  struct entry
+  {
+    std::string key;
+    std::vector<std::string> tables;
+    std::shared_ptr<const cached_result> result;
+    std::size_t size;
+  };
+  using entry_list = std::list<entry>;
+
+  struct on_update
+  {
+    query_cache * self;
+    void operator()(int op, const char * db_name, const char * table, sqlite3_int64 rowid) noexcept;
+  };
+  struct on_rollback
+  {
+    query_cache * self;
+    void operator()() noexcept;
+  };
+
+  // The start of the key, holding the length of the sql, so it can't run into the parameters.
+  BOOST_SQLITE_DECL static std::string sql_key(core::string_view sql);
+  // Appends the parameter to the key, returns false for pointers, which can't be cached.
+  BOOST_SQLITE_DECL static bool append_key(std::string & key, const param_ref & param);
+  BOOST_SQLITE_DECL std::shared_ptr<const cached_result> find(const std::string & key);
+  BOOST_SQLITE_DECL statement prepare(core::string_view sql, std::vector<std::string> & tables,
+                                      system::error_code & ec, error_info & ei);
+  BOOST_SQLITE_DECL std::shared_ptr<const cached_result> run(const std::string * key, statement & stmt,
+                                                             std::vector<std::string> tables,
+                                                             system::error_code & ec, error_info & ei);
+  void drop_table(const std::string & name) noexcept;
+  void erase(entry_list::iterator itr) noexcept;
+  void end_transaction_if_done() noexcept;
+
+  sqlite3 * db_;
+  std::size_t max_memory_;
+  std::size_t memory_used_ = 0u;
+  std::uint64_t hits_ = 0u, misses_ = 0u;
+  // most recently used first
+  entry_list entries_;
+  std::unordered_map<std::string, entry_list::iterator> index_;
+  // "<database>\0<table>" to the entries reading it
+  std::unordered_map<std::string, std::unordered_set<entry*>> tables_;
+  // tables changed by the current transaction
+  std::unordered_set<std::string> dirty_;
+  on_update update_{this};
+  on_rollback rollback_{this};
+  // the authorizer of the user
+  authorizer_type auth_ = nullptr;
+  void * auth_data_ = nullptr;
+};
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_QUERY_CACHE_HPP
@@ -15,6 +15,7 @@
 #include <boost/variant2/variant.hpp>
 
 #include <type_traits>
+#include <utility>
 
 
 BOOST_SQLITE_BEGIN_NAMESPACE
@@ -23,47 +24,48 @@ BOOST_SQLITE_BEGIN_NAMESPACE
 struct set_result_tag {};
 
 
-inline void tag_invoke(set_result_tag, sqlite3_context * ctx, blob b)
+inline void tag_invoke(set_result_tag, sqlite3_context * ctx, blob b) noexcept
 {
   auto sz = b.size();
-  sqlite3_result_blob(ctx, std::move(b).release(), sz, &operator delete);
+  sqlite3_result_blob64(ctx, std::move(b).release(), sz, &sqlite3_free);
 }
 
 
-inline void tag_invoke(set_result_tag, sqlite3_context * ctx, zero_blob zb)
+inline void tag_invoke(set_result_tag, sqlite3_context * ctx, zero_blob zb) noexcept
 {
   sqlite3_result_zeroblob64(ctx, static_cast<sqlite3_uint64>(zb));
 }
 
-inline void tag_invoke(set_result_tag, sqlite3_context * ctx, double dbl) { sqlite3_result_double(ctx, dbl); }
+inline void tag_invoke(set_result_tag, sqlite3_context * ctx, double dbl) noexcept { sqlite3_result_double(ctx, dbl); }
 
-inline void tag_invoke(set_result_tag, sqlite3_context * ctx, sqlite3_int64 value)
+inline void tag_invoke(set_result_tag, sqlite3_context * ctx, sqlite3_int64 value) noexcept
 {
   sqlite3_result_int64(ctx, static_cast<sqlite3_int64>(value));
 }
 
 template<typename T>
-inline auto tag_invoke(set_result_tag, sqlite3_context * ctx, const T &value)
+inline auto tag_invoke(set_result_tag, sqlite3_context * ctx, const T &value) noexcept
   -> std::enable_if_t<!std::is_same<std::int64_t, sqlite3_int64>::value && std::is_same<T, std::int64_t>::value>
 {
   sqlite3_result_int64(ctx, static_cast<sqlite3_int64>(value));
 }
 
-inline void tag_invoke(set_result_tag, sqlite3_context * ctx, std::nullptr_t) { sqlite3_result_null(ctx); }
-inline void tag_invoke(set_result_tag, sqlite3_context * ctx, string_view str)
+inline void tag_invoke(set_result_tag, sqlite3_context * ctx, std::nullptr_t) noexcept { sqlite3_result_null(ctx); }
+inline void tag_invoke(set_result_tag, sqlite3_context * ctx, string_view str) noexcept
 {
   sqlite3_result_text(ctx, str.data(), str.size(), SQLITE_TRANSIENT);
 }
 template<typename String>
 inline auto tag_invoke(set_result_tag, sqlite3_context * ctx, String && str)
+  noexcept(noexcept(string_view(str)))
   -> typename std::enable_if<std::is_convertible<String, string_view>::value>::type
 {
   return tag_invoke(set_result_tag{}, ctx, string_view(str));
 }
 
 
-inline void tag_invoke(set_result_tag, sqlite3_context * , variant2::monostate) { }
-inline void tag_invoke(set_result_tag, sqlite3_context * ctx, const value & val)
+inline void tag_invoke(set_result_tag, sqlite3_context * , variant2::monostate) noexcept { }
+inline void tag_invoke(set_result_tag, sqlite3_context * ctx, const value & val) noexcept
 {
   sqlite3_result_value(ctx, val.handle());
 }
@@ -104,7 +106,7 @@ inline auto tag_invoke(set_result_tag, sqlite3_context * ctx, std::unique_ptr<T,
   sqlite3_result_pointer(ctx, ptr.release(), typeid(T).name(), +[](void * ptr){Deleter()(static_cast<T*>(ptr));});
 }
 
-inline void tag_invoke(set_result_tag, sqlite3_context * ctx, error err)
+inline void tag_invoke(set_result_tag, sqlite3_context * ctx, error err) noexcept
 {
   if (err.info)
     sqlite3_result_error(ctx, err.info.message().c_str(), -1);
@@ -114,6 +116,7 @@ inline void tag_invoke(set_result_tag, sqlite3_context * ctx, error err)
 
 template<typename T>
 inline void tag_invoke(set_result_tag tag, sqlite3_context * ctx, result<T> res)
+    noexcept(noexcept(tag_invoke(tag, ctx, std::declval<T>())))
 {
   if (res.has_value())
     tag_invoke(tag, ctx, std::move(res).value());
@@ -121,7 +124,7 @@ inline void tag_invoke(set_result_tag tag, sqlite3_context * ctx, result<T> res)
     tag_invoke(tag, ctx, std::move(res).error());
 }
 
-inline void tag_invoke(set_result_tag tag, sqlite3_context * ctx, result<void> res)
+inline void tag_invoke(set_result_tag tag, sqlite3_context * ctx, result<void> res) noexcept
 {
   if (res.has_error())
     tag_invoke(tag, ctx, std::move(res).error());
@@ -133,6 +136,7 @@ namespace detail
 
 template<typename Value>
 inline auto set_result(sqlite3_context * ctx, Value && value)
+    noexcept(noexcept(tag_invoke(set_result_tag{}, ctx, std::forward<Value>(value))))
     -> decltype(tag_invoke(set_result_tag{}, ctx, std::forward<Value>(value)))
 {
   tag_invoke(set_result_tag{}, ctx, std::forward<Value>(value));
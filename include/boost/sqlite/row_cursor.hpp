@@ -0,0 +1,277 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_ROW_CURSOR_HPP
+#define BOOST_SQLITE_ROW_CURSOR_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/blob.hpp>
+#include <boost/sqlite/vtable.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/integral.hpp>
+
+#include <algorithm>
+#include <bitset>
+#include <cstdlib>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if !defined(BOOST_SQLITE_HAS_DESCRIBE) && defined(__has_include)
+# if __has_include(<boost/describe/members.hpp>)
+#  define BOOST_SQLITE_HAS_DESCRIBE 1
+# endif
+#endif
+
+#if !defined(BOOST_SQLITE_HAS_PFR) && defined(__has_include)
+# if __has_include(<boost/pfr/core.hpp>)
+#  define BOOST_SQLITE_HAS_PFR 1
+# endif
+#endif
+
+#if BOOST_SQLITE_HAS_DESCRIBE
+#include <boost/describe/members.hpp>
+#endif
+
+#if BOOST_SQLITE_HAS_PFR
+#include <boost/pfr/core.hpp>
+#if __has_include(<boost/pfr/core_name.hpp>)
+#include <boost/pfr/core_name.hpp>
+#endif
+#endif
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+// how the members of a row get mapped to columns.
+// 1 = Boost.Describe, 2 = std::tuple/std::pair, 3 = Boost.PFR
+template<typename T>
+struct is_tuple_row : std::false_type {};
+template<typename ... Ts>
+struct is_tuple_row<std::tuple<Ts...>> : std::true_type {};
+template<typename T, typename U>
+struct is_tuple_row<std::pair<T, U>> : std::true_type {};
+
+template<typename T>
+struct container_row_kind : std::integral_constant<int,
+#if BOOST_SQLITE_HAS_DESCRIBE
+      describe::has_describe_members<T>::value ? 1 :
+#endif
+      is_tuple_row<T>::value ? 2 : 3> {};
+
+template<typename T, int Kind = container_row_kind<T>::value>
+struct container_row
+{
+  static_assert(Kind != 3, "The row type must be described with Boost.Describe, a std::tuple, or an aggregate usable with Boost.PFR.");
+};
+
+#if BOOST_SQLITE_HAS_DESCRIBE
+template<typename T>
+struct container_row<T, 1>
+{
+  using members = describe::describe_members<T, describe::mod_public>;
+  constexpr static std::size_t size = mp11::mp_size<members>::value;
+
+  template<std::size_t I, typename Row>
+  static auto get(Row & row) -> decltype(row.*mp11::mp_at_c<members, I>::pointer)
+  {
+    return row.*mp11::mp_at_c<members, I>::pointer;
+  }
+
+  template<std::size_t I>
+  static const char * name(std::string &) { return mp11::mp_at_c<members, I>::name; }
+};
+#endif
+
+template<typename T>
+struct container_row<T, 2>
+{
+  constexpr static std::size_t size = std::tuple_size<T>::value;
+
+  template<std::size_t I, typename Row>
+  static auto get(Row & row) -> decltype(std::get<I>(row)) { return std::get<I>(row); }
+
+  template<std::size_t I>
+  static const char * name(std::string & buf)
+  {
+    buf = "c" + std::to_string(I);
+    return buf.c_str();
+  }
+};
+
+#if BOOST_SQLITE_HAS_PFR
+template<typename T>
+struct container_row<T, 3>
+{
+  constexpr static std::size_t size = pfr::tuple_size<T>::value;
+
+  template<std::size_t I, typename Row>
+  static auto get(Row & row) -> decltype(pfr::get<I>(row)) { return pfr::get<I>(row); }
+
+  template<std::size_t I>
+  static const char * name(std::string & buf)
+  {
+#if defined(BOOST_PFR_CORE_NAME_ENABLED) && BOOST_PFR_CORE_NAME_ENABLED
+    buf = pfr::get_name<I, T>();
+#else
+    buf = "c" + std::to_string(I);
+#endif
+    return buf.c_str();
+  }
+};
+#endif
+
+template<typename T>
+auto set_container_column(context<> & ctx, const T & val)
+    -> typename std::enable_if<std::is_integral<T>::value>::type
+{
+  ctx.set_result(static_cast<sqlite3_int64>(val));
+}
+
+template<typename T>
+auto set_container_column(context<> & ctx, const T & val)
+    -> typename std::enable_if<std::is_floating_point<T>::value>::type
+{
+  ctx.set_result(static_cast<double>(val));
+}
+
+template<typename T>
+auto set_container_column(context<> & ctx, const T & val)
+    -> typename std::enable_if<!std::is_arithmetic<T>::value>::type
+{
+  ctx.set_result(val);
+}
+
+template<typename T>
+const char * container_column_type()
+{
+  return std::is_integral<T>::value ? " INTEGER" :
+         std::is_floating_point<T>::value ? " REAL" :
+         std::is_convertible<const T&, string_view>::value ? " TEXT" :
+         std::is_same<T, blob>::value || std::is_same<T, blob_view>::value ? " BLOB" : "";
+}
+
+}
+
+namespace vtab
+{
+
+/** @brief A cursor that materializes the current row once and answers every column from it.
+    @ingroup reference
+
+    The derived cursor still implements `filter`, `next`, `eof` & `row_id`,
+    and stores the current row into `row()` when it moves.
+    Every member of `Row` is a column, in order.
+    The `Row` can be a struct described with Boost.Describe, a std::tuple or std::pair,
+    or an aggregate usable with Boost.PFR.
+
+    `column` is dispatched on the member index at compile time,
+    so no per cell lookup of the underlying data is needed.
+
+    If the table stores `index_info::columns_used()` with `store_columns_used` in its `best_index`
+    and `filter` hands the index string to `set_columns_used`, `fill` only visits the columns the statement reads.
+
+    @par Example
+    @code{.cpp}
+    struct order_cursor final : sqlite::vtab::row_cursor<std::tuple<sqlite3_int64, double, std::string>>
+    {
+      result<void> filter(int, const char * idx_str, span<sqlite::value>)
+      {
+        set_columns_used(idx_str);
+        pos_ = 0;
+        return load();
+      }
+      result<void> next() { ++pos_; return load(); }
+      bool eof() noexcept { return pos_ == records_.size(); }
+      result<sqlite3_int64> row_id() { return pos_; }
+
+      result<void> load()
+      {
+        if (!eof())
+          fill([&](auto & member, auto idx) { member = decode<idx>(records_[pos_]); });
+        return {};
+      }
+    };
+    @endcode
+ */
+template<typename Row>
+struct row_cursor : cursor<>
+{
+  using row_type = Row;
+  /// The number of columns
+  constexpr static std::size_t column_count = detail::container_row<Row>::size;
+
+  /// Set the column from the materialized row.
+  void column(context<> ctx, int idx, bool /* no_change */)
+  {
+    mp11::mp_with_index<column_count>(
+        static_cast<std::size_t>(idx),
+        [&](auto Idx)
+        {
+          detail::set_container_column(ctx, detail::container_row<Row>::template get<Idx>(row_));
+        });
+  }
+
+        Row & row()       noexcept { return row_; }
+  const Row & row() const noexcept { return row_; }
+
+  /// Set the columns that will be read, as obtained from `index_info::columns_used()`.
+  void set_columns_used(std::bitset<64u> used) noexcept { used_ = used; }
+
+  /// Set the columns that will be read from the index string written by `store_columns_used`. Null means all columns.
+  void set_columns_used(const char * index_data) noexcept
+  {
+    used_ = index_data == nullptr ? ~0ull : std::strtoull(index_data, nullptr, 16);
+  }
+
+  /// Check if a column is used. The last bit stands for all columns from 63 on.
+  bool column_used(std::size_t idx) const noexcept { return used_[(std::min)(idx, std::size_t(63u))]; }
+
+  /// Invoke `func(member, std::integral_constant<std::size_t, I>)` for every used member of the row.
+  template<typename Func>
+  void fill(Func && func)
+  {
+    mp11::mp_for_each<mp11::mp_iota_c<column_count>>(
+        [&](auto Idx)
+        {
+          if (column_used(Idx))
+            func(detail::container_row<Row>::template get<Idx>(row_), Idx);
+        });
+  }
+
+ protected:
+  row_cursor() : cursor<>() {}
+  explicit row_cursor(Row row) : cursor<>(), row_(std::move(row)) {}
+
+ private:
+  Row row_{};
+  std::bitset<64u> used_{~0ull};
+};
+
+#if SQLITE_VERSION_NUMBER >= 3010000
+/** @brief Store `info.columns_used()` as the index string, for `row_cursor::set_columns_used` to read in `filter`.
+    @ingroup reference
+
+    The index number has only 32 bits, so it can't carry the columns from 31 on.
+    This replaces any other index string of `info`.
+ */
+inline result<void> store_columns_used(index_info & info)
+{
+  auto str = sqlite3_mprintf("%llx", static_cast<unsigned long long>(info.columns_used().to_ullong()));
+  if (str == nullptr)
+    return error(SQLITE_NOMEM);
+  info.set_index_string(str);
+  return {};
+}
+#endif
+
+}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_ROW_CURSOR_HPP
@@ -0,0 +1,379 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_SESSION_HPP
+#define BOOST_SQLITE_SESSION_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/detail/exception.hpp>
+#include <boost/sqlite/blob.hpp>
+#include <boost/sqlite/connection_ref.hpp>
+#include <boost/sqlite/cstring_ref.hpp>
+#include <boost/sqlite/error.hpp>
+#include <boost/sqlite/value.hpp>
+#include <boost/system/result.hpp>
+
+#include <memory>
+#include <type_traits>
+
+#if defined(SQLITE_ENABLE_SESSION) && defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+/** @brief A change inside a changeset.
+    @ingroup reference
+
+    @note This is only available if sqlite was compiled with `SQLITE_ENABLE_SESSION` & `SQLITE_ENABLE_PREUPDATE_HOOK`.
+    @see [related sqlite documentation](https://www.sqlite.org/session/sqlite3changeset_op.html)
+ */
+struct change
+{
+  /// The table the change applies to.
+  cstring_ref table() const noexcept { return table_; }
+  /// The number of columns of the table.
+  int column_count() const noexcept { return columns_; }
+  /// `SQLITE_INSERT`, `SQLITE_UPDATE` or `SQLITE_DELETE`.
+  int op() const noexcept { return op_; }
+  /// Whether the change was made by a trigger or foreign key action, or a session with `indirect` set.
+  bool indirect() const noexcept { return indirect_ != 0; }
+  /// Check if `column` is part of the primary key.
+  bool is_primary_key(int column) const noexcept
+  {
+    unsigned char * pk;
+    int n;
+    return sqlite3changeset_pk(iter_, &pk, &n) == SQLITE_OK && column >= 0 && column < n && pk[column] != 0u;
+  }
+
+  ///@{
+  /** @brief The value before & after the change.
+
+      The old value is available for updates & deletes, the new value for updates & inserts.
+      The call fails with `SQLITE_NOTFOUND` if the column is not part of the change, e.g. it's unchanged by an update.
+   */
+  system::result<value> old_value(int column) const
+  {
+    sqlite3_value * val = nullptr;
+    const int res = sqlite3changeset_old(iter_, column, &val);
+    if (res != SQLITE_OK)
+      BOOST_SQLITE_RETURN_EC(res);
+    if (val == nullptr)
+      BOOST_SQLITE_RETURN_EC(SQLITE_NOTFOUND);
+    return value(val);
+  }
+
+  system::result<value> new_value(int column) const
+  {
+    sqlite3_value * val = nullptr;
+    const int res = sqlite3changeset_new(iter_, column, &val);
+    if (res != SQLITE_OK)
+      BOOST_SQLITE_RETURN_EC(res);
+    if (val == nullptr)
+      BOOST_SQLITE_RETURN_EC(SQLITE_NOTFOUND);
+    return value(val);
+  }
+  ///@}
+
+  /// The value currently in the database, only available in a conflict handler for data & conflict conflicts.
+  system::result<value> conflict_value(int column) const
+  {
+    sqlite3_value * val = nullptr;
+    const int res = sqlite3changeset_conflict(iter_, column, &val);
+    if (res != SQLITE_OK)
+      BOOST_SQLITE_RETURN_EC(res);
+    return value(val);
+  }
+
+  explicit change(sqlite3_changeset_iter * iter) noexcept : iter_(iter)
+  {
+    sqlite3changeset_op(iter_, &table_, &columns_, &op_, &indirect_);
+  }
+
+  /// The handle of the iterator.
+  using handle_type = sqlite3_changeset_iter *;
+  /// Returns the handle.
+  handle_type handle() const noexcept { return iter_; }
+
+ private:
+  sqlite3_changeset_iter * iter_;
+  const char * table_ = "";
+  int columns_ = 0, op_ = 0, indirect_ = 0;
+};
+
+/** @brief Reads the changes of a changeset or patchset.
+    @ingroup reference
+
+    @note This is only available if sqlite was compiled with `SQLITE_ENABLE_SESSION` & `SQLITE_ENABLE_PREUPDATE_HOOK`.
+
+    @par Example
+    @code{.cpp}
+    sqlite::changeset_reader rd{changeset};
+    while (rd.next())
+    {
+      auto ch = rd.current();
+      if (ch.op() == SQLITE_INSERT)
+        std::cout << ch.table() << ": " << ch.new_value(0).value().get_int() << std::endl;
+    }
+    @endcode
+ */
+struct changeset_reader
+{
+  ///@{
+  /// Start reading `changeset`, which needs to stay alive until the reader is destroyed. `invert` reads its inverse.
+  BOOST_SQLITE_DECL explicit changeset_reader(blob_view changeset, bool invert = false);
+  BOOST_SQLITE_DECL changeset_reader(blob_view changeset, bool invert, system::error_code & ec, error_info & ei);
+  ///@}
+
+  // The changeset isn't copied, so it can't be a temporary.
+  explicit changeset_reader(blob && changeset, bool invert = false) = delete;
+  changeset_reader(blob && changeset, bool invert, system::error_code & ec, error_info & ei) = delete;
+
+  ///@{
+  /// Move to the next change. Returns false at the end of the changeset.
+  BOOST_SQLITE_DECL bool next(system::error_code & ec, error_info & ei);
+  BOOST_SQLITE_DECL bool next();
+  ///@}
+
+  /// The current change, valid until the next call to `next`.
+  change current() const noexcept { return change(impl_.get()); }
+
+  /// The handle of the iterator.
+  using handle_type = sqlite3_changeset_iter *;
+  /// Returns the handle.
+  handle_type handle() const noexcept { return impl_.get(); }
+
+ private:
+  struct deleter_
+  {
+    void operator()(sqlite3_changeset_iter * it) const noexcept { sqlite3changeset_finalize(it); }
+  };
+  std::unique_ptr<sqlite3_changeset_iter, deleter_> impl_;
+};
+
+/** @brief Records the changes to the tables of a connection.
+    @ingroup reference
+
+    The session needs to be destroyed before the connection gets closed.
+
+    @note This is only available if sqlite was compiled with `SQLITE_ENABLE_SESSION` & `SQLITE_ENABLE_PREUPDATE_HOOK`.
+    @see [related sqlite documentation](https://www.sqlite.org/sessionintro.html)
+
+    @par Example
+    @code{.cpp}
+    sqlite::session sess{conn};
+    sess.attach();
+    conn.execute("update accounts set balance = balance - 10 where id = 1");
+    replica_queue.push(sess.changeset());
+    @endcode
+ */
+struct session
+{
+  ///@{
+  /// Create a session recording the changes of `database`.
+  BOOST_SQLITE_DECL explicit session(connection_ref conn, cstring_ref database = "main");
+  BOOST_SQLITE_DECL session(connection_ref conn, cstring_ref database, system::error_code & ec, error_info & ei);
+  ///@}
+
+  ///@{
+  /// Record the changes to `table`. Tables without a primary key are ignored.
+  BOOST_SQLITE_DECL void attach(cstring_ref table, system::error_code & ec, error_info & ei);
+  BOOST_SQLITE_DECL void attach(cstring_ref table);
+  ///@}
+
+  ///@{
+  /// Record the changes to all tables, including those created later.
+  BOOST_SQLITE_DECL void attach(system::error_code & ec, error_info & ei);
+  BOOST_SQLITE_DECL void attach();
+  ///@}
+
+  ///@{
+  /// Add the changes needed to turn `table` in `from_database` into the one of this session.
+  BOOST_SQLITE_DECL void diff(cstring_ref from_database, cstring_ref table, system::error_code & ec, error_info & ei);
+  BOOST_SQLITE_DECL void diff(cstring_ref from_database, cstring_ref table);
+  ///@}
+
+  ///@{
+  /// The changes recorded so far, including the old values of updated and deleted rows.
+  BOOST_SQLITE_DECL blob changeset(system::error_code & ec, error_info & ei) const;
+  BOOST_SQLITE_DECL blob changeset() const;
+  ///@}
+
+  ///@{
+  /// A smaller changeset without the old values, which can't detect data conflicts & can't be inverted.
+  BOOST_SQLITE_DECL blob patchset(system::error_code & ec, error_info & ei) const;
+  BOOST_SQLITE_DECL blob patchset() const;
+  ///@}
+
+  /// Check if no changes have been recorded.
+  bool empty() const noexcept { return sqlite3session_isempty(impl_.get()) != 0; }
+
+  /// Check if the session records changes.
+  bool enabled() const noexcept { return sqlite3session_enable(impl_.get(), -1) != 0; }
+  /// Pause or resume the recording.
+  void enable(bool value) noexcept { sqlite3session_enable(impl_.get(), value ? 1 : 0); }
+
+  /// Check if changes get marked as indirect.
+  bool indirect() const noexcept { return sqlite3session_indirect(impl_.get(), -1) != 0; }
+  /// Mark all following changes as indirect.
+  void set_indirect(bool value) noexcept { sqlite3session_indirect(impl_.get(), value ? 1 : 0); }
+
+  /// The handle of the session.
+  using handle_type = sqlite3_session *;
+  /// Returns the handle.
+  handle_type handle() const noexcept { return impl_.get(); }
+  /// Release the owned handle.
+  handle_type release() && noexcept { return impl_.release(); }
+
+ private:
+  struct deleter_
+  {
+    void operator()(sqlite3_session * s) const noexcept { sqlite3session_delete(s); }
+  };
+  std::unique_ptr<sqlite3_session, deleter_> impl_;
+  sqlite3 * db_ = nullptr;
+};
+
+/** @brief Combines multiple changesets into one.
+    @ingroup reference
+
+    Changes to the same row get merged, e.g. an insert followed by an update becomes a single insert.
+
+    @note This is only available if sqlite was compiled with `SQLITE_ENABLE_SESSION` & `SQLITE_ENABLE_PREUPDATE_HOOK`.
+    @see [related sqlite documentation](https://www.sqlite.org/session/changegroup.html)
+ */
+struct changegroup
+{
+  BOOST_SQLITE_DECL changegroup();
+
+  ///@{
+  /// Add a changeset. Changesets & patchsets can't be mixed.
+  BOOST_SQLITE_DECL void add(blob_view changeset, system::error_code & ec, error_info & ei);
+  BOOST_SQLITE_DECL void add(blob_view changeset);
+  ///@}
+
+  ///@{
+  /// The combined changeset.
+  BOOST_SQLITE_DECL blob output(system::error_code & ec, error_info & ei) const;
+  BOOST_SQLITE_DECL blob output() const;
+  ///@}
+
+  /// The handle of the changegroup.
+  using handle_type = sqlite3_changegroup *;
+  /// Returns the handle.
+  handle_type handle() const noexcept { return impl_.get(); }
+
+ private:
+  struct deleter_
+  {
+    void operator()(sqlite3_changegroup * cg) const noexcept { sqlite3changegroup_delete(cg); }
+  };
+  std::unique_ptr<sqlite3_changegroup, deleter_> impl_;
+};
+
+///@{
+/// Get the inverse of a changeset, i.e. the changes that undo it. @ingroup reference
+BOOST_SQLITE_DECL blob invert_changeset(blob_view changeset, system::error_code & ec, error_info & ei);
+BOOST_SQLITE_DECL blob invert_changeset(blob_view changeset);
+///@}
+
+/// The reason a change can't be applied. @ingroup reference
+enum class conflict_type
+{
+  /// The row exists, but the old values don't match.
+  data = SQLITE_CHANGESET_DATA,
+  /// The row to update or delete doesn't exist.
+  not_found = SQLITE_CHANGESET_NOTFOUND,
+  /// The primary key of an inserted row already exists.
+  conflict = SQLITE_CHANGESET_CONFLICT,
+  /// A constraint other than the primary key failed.
+  constraint = SQLITE_CHANGESET_CONSTRAINT,
+  /// Foreign key constraints are violated after all changes, `current` holds no change.
+  foreign_key = SQLITE_CHANGESET_FOREIGN_KEY
+};
+
+/// The action a conflict handler returns. @ingroup reference
+enum class conflict_action
+{
+  /// Skip the change.
+  omit = SQLITE_CHANGESET_OMIT,
+  /// Overwrite the row, only allowed for `data` & `conflict` conflicts.
+  replace = SQLITE_CHANGESET_REPLACE,
+  /// Roll back all changes & fail with `SQLITE_ABORT`.
+  abort = SQLITE_CHANGESET_ABORT
+};
+
+namespace detail
+{
+
+BOOST_SQLITE_DECL
+void apply_changeset(sqlite3 * db, blob_view changeset,
+                     int (*conflict)(void *, int, sqlite3_changeset_iter *), void * data,
+                     system::error_code & ec, error_info & ei);
+
+}
+
+///@{
+/**
+  @brief Apply a changeset or patchset to a database.
+  @ingroup reference
+
+  All changes are applied in a savepoint, i.e. either all or none.
+
+  The conflict handler is invoked for changes that can't be applied as recorded.
+  It must be noexcept and have the signature
+
+  @code{.cpp}
+  sqlite::conflict_action on_conflict(sqlite::conflict_type type, sqlite::change ch) noexcept;
+  @endcode
+
+  @note The conflict handler is only used during the call, so it's taken by reference.
+
+  @param conn The database connection to apply the changes to.
+  @param changeset The changes.
+  @param on_conflict The conflict handler. Without one, any conflict aborts.
+
+  @par Example
+  @code{.cpp}
+  sqlite::apply_changeset(
+      replica, changeset,
+      [](sqlite::conflict_type type, sqlite::change) noexcept
+      {
+        return type == sqlite::conflict_type::data ? sqlite::conflict_action::replace : sqlite::conflict_action::omit;
+      });
+  @endcode
+ */
+template<typename Func>
+void apply_changeset(connection_ref conn, blob_view changeset, Func && on_conflict,
+                     system::error_code & ec, error_info & ei)
+{
+  static_assert(noexcept(on_conflict(conflict_type::data, change(nullptr))), "conflict handler must be noexcept");
+  using func_type = typename std::remove_reference<Func>::type;
+  detail::apply_changeset(
+      conn.handle(), changeset,
+      [](void * data, int type, sqlite3_changeset_iter * iter) -> int
+      {
+        return static_cast<int>((*static_cast<func_type*>(data))(static_cast<conflict_type>(type), change(iter)));
+      },
+      const_cast<void*>(static_cast<const void*>(std::addressof(on_conflict))), ec, ei);
+}
+
+template<typename Func>
+void apply_changeset(connection_ref conn, blob_view changeset, Func && on_conflict)
+{
+  system::error_code ec;
+  error_info ei;
+  apply_changeset(conn, changeset, std::forward<Func>(on_conflict), ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+BOOST_SQLITE_DECL void apply_changeset(connection_ref conn, blob_view changeset,
+                                       system::error_code & ec, error_info & ei);
+BOOST_SQLITE_DECL void apply_changeset(connection_ref conn, blob_view changeset);
+///@}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif
+
+#endif //BOOST_SQLITE_SESSION_HPP
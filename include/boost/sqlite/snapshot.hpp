@@ -0,0 +1,109 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_SNAPSHOT_HPP
+#define BOOST_SQLITE_SNAPSHOT_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/detail/exception.hpp>
+#include <boost/sqlite/connection_ref.hpp>
+#include <boost/sqlite/cstring_ref.hpp>
+#include <boost/sqlite/error.hpp>
+
+#include <memory>
+
+#if defined(SQLITE_ENABLE_SNAPSHOT)
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+/** @brief A snapshot of a wal database, that other connections can read.
+    @ingroup reference
+
+    A snapshot records the state of the database seen by the read transaction of a connection.
+    Any connection to the same database can open a read transaction on it later,
+    as long as the frames it needs are still in the log, i.e. no checkpoint restarted the log.
+    This allows multiple connections to read the exact same data in parallel.
+
+    The snapshot itself is immutable, so it can be opened by multiple threads at the same time.
+
+    @note This is only available if sqlite was compiled with `SQLITE_ENABLE_SNAPSHOT` and requires the database to be in wal mode.
+    @see [related sqlite documentation](https://www.sqlite.org/c3ref/snapshot.html)
+
+    @par Example
+    @code{.cpp}
+    leader.execute("begin; select count(*) from t;");
+    sqlite::snapshot snap{leader};
+
+    // on another thread
+    snap.open(reader); // starts a read transaction
+    auto st = reader.prepare("select * from t");
+    // ...
+    reader.execute("commit");
+    @endcode
+ */
+struct snapshot
+{
+  /// Create an empty snapshot.
+  snapshot() noexcept = default;
+
+  ///@{
+  /** @brief Record the snapshot of the read transaction of `conn`.
+
+      The connection must be in a transaction that has read from `database` already.
+   */
+  BOOST_SQLITE_DECL explicit snapshot(connection_ref conn, cstring_ref database = "main");
+  BOOST_SQLITE_DECL snapshot(connection_ref conn, cstring_ref database, system::error_code & ec, error_info & ei);
+  ///@}
+
+  ///@{
+  /** @brief Start a read transaction on `conn` that sees the database as it was in the snapshot.
+
+      If `conn` isn't in a transaction, it gets started & rolled back if opening the snapshot fails.
+      Otherwise, the transaction must not have read from `database` yet.
+      Fails with `SQLITE_ERROR_SNAPSHOT` if the snapshot is no longer available.
+   */
+  BOOST_SQLITE_DECL void open(connection_ref conn, cstring_ref database, system::error_code & ec, error_info & ei) const;
+  BOOST_SQLITE_DECL void open(connection_ref conn, cstring_ref database = "main") const;
+  ///@}
+
+  /// Returns a negative value if this snapshot is older than `other`, zero if equal & a positive value if newer.
+  /// Only meaningful for snapshots of the same database file, neither may be empty.
+  int compare(const snapshot & other) const noexcept
+  {
+    return sqlite3_snapshot_cmp(impl_.get(), other.impl_.get());
+  }
+
+  ///@{
+  /** @brief Make the snapshots of `database` that are still in the log available after the database got reopened.
+
+      The log gets scanned only once after opening the database,
+      so snapshots taken by a previous process can't be opened before this.
+   */
+  BOOST_SQLITE_DECL static void recover(connection_ref conn, cstring_ref database, system::error_code & ec, error_info & ei);
+  BOOST_SQLITE_DECL static void recover(connection_ref conn, cstring_ref database = "main");
+  ///@}
+
+  /// Check if the snapshot holds a handle.
+  explicit operator bool() const noexcept { return impl_ != nullptr; }
+
+  /// The handle of the snapshot.
+  using handle_type = sqlite3_snapshot *;
+  /// Returns the handle.
+  handle_type handle() const noexcept { return impl_.get(); }
+  /// Release the owned handle.
+  handle_type release() && noexcept { return impl_.release(); }
+
+ private:
+  struct deleter_
+  {
+    void operator()(sqlite3_snapshot * s) const noexcept { sqlite3_snapshot_free(s); }
+  };
+  std::unique_ptr<sqlite3_snapshot, deleter_> impl_;
+};
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif
+
+#endif //BOOST_SQLITE_SNAPSHOT_HPP
@@ -112,6 +112,13 @@ struct param_ref
       return variant2::visit(visitor{stmt, c}, impl_);
     }
 
+    /// Invoke `func` with the held value, e.g. to hash or compare parameters.
+    template<typename Func>
+    decltype(auto) visit(Func && func) const
+    {
+      return variant2::visit(std::forward<Func>(func), impl_);
+    }
+
  private:
     struct make_visitor
     {
@@ -224,9 +231,11 @@ struct statement
   {
     system::error_code ec;
     error_info ei;
+    // the message is copied into the exception right away, so it can be taken lazily.
+    ei.set_lazy();
     const auto cc = step(ec, ei);
     if (ec)
-      throw_exception(system::system_error(ec, ei.message()));
+      detail::throw_error_code(ec, ei);
     return cc;
   }
   bool step(system::error_code& ec, error_info& ei)
@@ -242,8 +251,8 @@ struct statement
     else if (cc != SQLITE_ROW)
     {
       BOOST_SQLITE_ASSIGN_EC(ec, cc);
-      ei.set_message(sqlite3_errmsg(sqlite3_db_handle(impl_.get())));
-      }
+      ei.set_message(sqlite3_db_handle(impl_.get()));
+    }
     return !done_;
   }
 
@@ -262,6 +271,7 @@ struct statement
     {
       system::error_code ec;
       error_info ei;
+      ei.set_lazy();
       bind(std::forward<ArgRange>(params), ec, ei);
       if (ec)
         detail::throw_error_code(ec, ei);
@@ -280,6 +290,7 @@ struct statement
     {
       system::error_code ec;
       error_info ei;
+      ei.set_lazy();
       bind(std::move(params), ec, ei);
       if (ec)
         detail::throw_error_code(ec, ei);
@@ -291,7 +302,7 @@ struct statement
       if (ar != SQLITE_OK)
       {
         BOOST_SQLITE_ASSIGN_EC(ec, ar);
-        ei.set_message(sqlite3_errmsg(sqlite3_db_handle(impl_.get())));
+        ei.set_message(sqlite3_db_handle(impl_.get()));
         return;
       }
     }
@@ -300,6 +311,7 @@ struct statement
     {
       system::error_code ec;
       error_info ei;
+      ei.set_lazy();
       bind(index, std::move(param), ec, ei);
       if (ec)
         detail::throw_error_code(ec, ei);
@@ -327,6 +339,7 @@ struct statement
     {
       system::error_code ec;
       error_info ei;
+      ei.set_lazy();
       bind(name, std::move(param), ec, ei);
       if (ec)
         detail::throw_error_code(ec, ei);
@@ -354,6 +367,7 @@ struct statement
     {
       system::error_code ec;
       error_info ei;
+      ei.set_lazy();
       execute(std::forward<ArgRange>(params), ec, ei);
       if (ec)
         detail::throw_error_code(ec, ei);
@@ -376,6 +390,7 @@ struct statement
     {
       system::error_code ec;
       error_info ei;
+      ei.set_lazy();
       execute(std::move(params), ec, ei);
       if (ec)
         detail::throw_error_code(ec, ei);
@@ -436,10 +451,10 @@ struct statement
     void clear_bindings(system::error_code & ec, error_info & ei)
     {
       auto cc = sqlite3_clear_bindings(impl_.get());
-      if (cc != SQLITE_DONE)
+      if (cc != SQLITE_OK)
       {
         BOOST_SQLITE_ASSIGN_EC(ec, cc);
-        ei.set_message(sqlite3_errmsg(sqlite3_db_handle(impl_.get())));
+        ei.set_message(sqlite3_db_handle(impl_.get()));
       }
     }
 
@@ -447,19 +462,22 @@ struct statement
     {
       system::error_code ec;
       error_info ei;
+      ei.set_lazy();
       clear_bindings(ec, ei);
       if (ec)
-        throw_exception(system::system_error(ec, ei.message()));
+        detail::throw_error_code(ec, ei);
     }
 
-    /// Reset the current execution.
+    /// Reset the current execution, so the statement can be stepped again.
+    /// Reports the error of the last step, if it failed.
     void reset(system::error_code & ec, error_info & ei)
     {
+      done_ = false;
       auto cc = sqlite3_reset(impl_.get());
-      if (cc != SQLITE_DONE)
+      if (cc != SQLITE_OK)
       {
         BOOST_SQLITE_ASSIGN_EC(ec, cc);
-        ei.set_message(sqlite3_errmsg(sqlite3_db_handle(impl_.get())));
+        ei.set_message(sqlite3_db_handle(impl_.get()));
       }
     }
 
@@ -467,9 +485,10 @@ struct statement
     {
       system::error_code ec;
       error_info ei;
-      clear_bindings(ec, ei);
+      ei.set_lazy();
+      reset(ec, ei);
       if (ec)
-        throw_exception(system::system_error(ec, ei.message()));
+        detail::throw_error_code(ec, ei);
     }
 
     row current() const
@@ -505,7 +524,7 @@ struct statement
         if (ar != SQLITE_OK)
         {
           BOOST_SQLITE_ASSIGN_EC(ec, ar);
-          ei.set_message(sqlite3_errmsg(sqlite3_db_handle(impl_.get())));
+          ei.set_message(sqlite3_db_handle(impl_.get()));
           return;
         }
     }
@@ -535,7 +554,7 @@ struct statement
         if (ar != SQLITE_OK)
         {
           BOOST_SQLITE_ASSIGN_EC(ec, ar);
-          ei.set_message(sqlite3_errmsg(sqlite3_db_handle(impl_.get())));
+          ei.set_message(sqlite3_db_handle(impl_.get()));
           return;
         }
     }
@@ -559,7 +578,7 @@ struct statement
           if (ar != SQLITE_OK)
           {
             BOOST_SQLITE_ASSIGN_EC(ec, ar);
-            ei.set_message(sqlite3_errmsg(sqlite3_db_handle(impl_.get())));
+            ei.set_message(sqlite3_db_handle(impl_.get()));
             return;
           }
         }
@@ -598,7 +617,7 @@ struct statement
           {
 
             BOOST_SQLITE_ASSIGN_EC(ec, ar);
-            ei.set_message(sqlite3_errmsg(sqlite3_db_handle(impl_.get())));
+            ei.set_message(sqlite3_db_handle(impl_.get()));
             return;
           }
         }
@@ -633,7 +652,7 @@ struct statement
           {
 
             BOOST_SQLITE_ASSIGN_EC(ec, ar);
-            ei.set_message(sqlite3_errmsg(sqlite3_db_handle(impl_.get())));
+            ei.set_message(sqlite3_db_handle(impl_.get()));
             return;
           }
         }
@@ -0,0 +1,380 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_SQLITE_STATISTICS_HPP
+#define BOOST_SQLITE_STATISTICS_HPP
+
+#include <boost/sqlite/detail/config.hpp>
+#include <boost/sqlite/blob.hpp>
+#include <boost/sqlite/connection_ref.hpp>
+#include <boost/sqlite/error.hpp>
+#include <boost/sqlite/result.hpp>
+#include <boost/sqlite/value.hpp>
+
+#include <boost/core/span.hpp>
+#include <boost/variant2/variant.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace statistics
+{
+
+/// The result of a statistical aggregate, `nullptr` if there is not enough data.
+using optional_double = variant2::variant<std::nullptr_t, double>;
+
+/** @brief Running mean and variance, using Welford's algorithm.
+    @ingroup reference
+
+    Values can be removed again, which makes this usable for sliding windows.
+ */
+struct moments
+{
+  std::size_t count = 0u;
+  double mean = 0.;
+  double m2 = 0.;
+
+  void add(double x) noexcept
+  {
+    count++;
+    const auto d = x - mean;
+    mean += d / static_cast<double>(count);
+    m2 += d * (x - mean);
+  }
+
+  void remove(double x) noexcept
+  {
+    if (count <= 1u)
+    {
+      *this = moments{};
+      return;
+    }
+    count--;
+    const auto prev = mean - (x - mean) / static_cast<double>(count);
+    m2 -= (x - prev) * (x - mean);
+    mean = prev;
+    if (m2 < 0.)
+      m2 = 0.;
+  }
+
+  /// The variance, `sample` uses Bessel's correction.
+  optional_double variance(bool sample) const noexcept
+  {
+    const std::size_t ddof = sample ? 1u : 0u;
+    if (count <= ddof)
+      return nullptr;
+    return m2 / static_cast<double>(count - ddof);
+  }
+};
+
+/** @brief Running co-moments of two variables, used for covariance and correlation.
+    @ingroup reference
+
+    Values can be removed again, which makes this usable for sliding windows.
+ */
+struct co_moments
+{
+  std::size_t count = 0u;
+  double mean_x = 0., mean_y = 0.;
+  double m2_x = 0., m2_y = 0., c_xy = 0.;
+
+  void add(double x, double y) noexcept
+  {
+    count++;
+    const auto n = static_cast<double>(count);
+    const auto dx = x - mean_x;
+    const auto dy = y - mean_y;
+    mean_x += dx / n;
+    mean_y += dy / n;
+    m2_x += dx * (x - mean_x);
+    m2_y += dy * (y - mean_y);
+    c_xy += dx * (y - mean_y);
+  }
+
+  void remove(double x, double y) noexcept
+  {
+    if (count <= 1u)
+    {
+      *this = co_moments{};
+      return;
+    }
+    count--;
+    const auto n = static_cast<double>(count);
+    const auto px = mean_x - (x - mean_x) / n;
+    const auto py = mean_y - (y - mean_y) / n;
+    m2_x -= (x - px) * (x - mean_x);
+    m2_y -= (y - py) * (y - mean_y);
+    c_xy -= (x - px) * (y - mean_y);
+    mean_x = px;
+    mean_y = py;
+  }
+
+  optional_double covariance(bool sample) const noexcept
+  {
+    const std::size_t ddof = sample ? 1u : 0u;
+    if (count <= ddof)
+      return nullptr;
+    return c_xy / static_cast<double>(count - ddof);
+  }
+
+  optional_double correlation() const noexcept
+  {
+    if (count < 2u || m2_x <= 0. || m2_y <= 0.)
+      return nullptr;
+    return c_xy / std::sqrt(m2_x * m2_y);
+  }
+};
+
+/** @brief A multiset of doubles with O(log n) insertion, removal & lookup of the n-th element.
+    @ingroup reference
+
+    The values are kept in a treap, in which every node knows the size of its subtree,
+    so a sliding window doesn't move the values it keeps.
+ */
+struct order_statistic
+{
+  BOOST_SQLITE_DECL void insert(double x);
+  /// Removes one element equal to `x`, if any.
+  BOOST_SQLITE_DECL void erase(double x) noexcept;
+
+  std::size_t size() const noexcept {return size_of(root_);}
+  bool empty() const noexcept {return root_ == npos;}
+  /// The n-th smallest value.
+  BOOST_SQLITE_DECL double operator[](std::size_t n) const noexcept;
+
+  /// The continuous quantile, interpolating linearly between the closest ranks. `q` must be in [0, 1].
+  BOOST_SQLITE_DECL optional_double quantile(double q) const noexcept;
+ private:
+  constexpr static std::uint32_t npos = 0xFFFFFFFFu;
+  struct node
+  {
+    double value;
+    std::uint32_t priority, size, left, right;
+  };
+
+  std::size_t size_of(std::uint32_t n) const noexcept {return n == npos ? 0u : nodes_[n].size;}
+  void update(std::uint32_t n) noexcept;
+  void split(std::uint32_t n, double x, std::uint32_t & left, std::uint32_t & right) noexcept;
+  std::uint32_t join(std::uint32_t left, std::uint32_t right) noexcept;
+  std::uint32_t insert(std::uint32_t n, std::uint32_t x) noexcept;
+  std::uint32_t erase(std::uint32_t n, double x) noexcept;
+
+  std::vector<node> nodes_;
+  std::uint32_t root_ = npos;
+  // the erased nodes, linked through `left`.
+  std::uint32_t free_ = npos;
+  std::uint32_t seed_ = 0x9E3779B9u;
+};
+
+/** @brief A merging t-digest for approximate quantiles.
+    @ingroup reference
+
+    The digest can be serialized into a blob and blobs can be merged,
+    so that partial digests can be stored & rolled up later.
+
+    The blob layout is native endian.
+ */
+struct tdigest
+{
+  struct centroid
+  {
+    double mean;
+    double weight;
+  };
+
+  explicit tdigest(double compression = 100.) noexcept : compression_(compression) {}
+
+  BOOST_SQLITE_DECL void add(double x, double weight = 1.);
+  BOOST_SQLITE_DECL void merge(const tdigest & other);
+  /// Merge a serialized digest, fails with `SQLITE_MISMATCH` if `bv` isn't a valid digest.
+  BOOST_SQLITE_DECL result<void> merge(blob_view bv);
+
+  /// The approximate quantile, `q` must be in [0, 1].
+  BOOST_SQLITE_DECL optional_double quantile(double q);
+  /// Serialize the digest.
+  BOOST_SQLITE_DECL blob to_blob();
+
+  double total_weight() const noexcept {return total_ + buffered_;}
+  double compression() const noexcept {return compression_;}
+ private:
+  BOOST_SQLITE_DECL void compress();
+
+  double compression_;
+  double total_ = 0., buffered_ = 0.;
+  double min_ = 0., max_ = 0.;
+  std::vector<centroid> centroids_, buffer_;
+};
+
+/// `var_samp(x)`, `var_pop(x)`, `stddev_samp(x)` and `stddev_pop(x)`
+template<bool Sample, bool Sqrt>
+struct variance_function
+{
+  void step(span<sqlite::value, 1u> args) noexcept
+  {
+    if (!args[0].is_null())
+      state.add(args[0].get_double());
+  }
+  void inverse(span<sqlite::value, 1u> args) noexcept
+  {
+    if (!args[0].is_null())
+      state.remove(args[0].get_double());
+  }
+  optional_double value() const noexcept
+  {
+    auto res = state.variance(Sample);
+    if (Sqrt && res.index() == 1u)
+      return std::sqrt(variant2::get<1u>(res));
+    return res;
+  }
+
+  moments state;
+};
+
+using var_samp    = variance_function<true,  false>;
+using var_pop     = variance_function<false, false>;
+using stddev_samp = variance_function<true,  true>;
+using stddev_pop  = variance_function<false, true>;
+
+/// `covar_samp(x, y)`, `covar_pop(x, y)` and `corr(x, y)`. Rows where either value is NULL are ignored.
+template<int Kind>
+struct co_moments_function
+{
+  void step(span<sqlite::value, 2u> args) noexcept
+  {
+    if (!args[0].is_null() && !args[1].is_null())
+      state.add(args[0].get_double(), args[1].get_double());
+  }
+  void inverse(span<sqlite::value, 2u> args) noexcept
+  {
+    if (!args[0].is_null() && !args[1].is_null())
+      state.remove(args[0].get_double(), args[1].get_double());
+  }
+  optional_double value() const noexcept
+  {
+    return Kind == 2 ? state.correlation() : state.covariance(Kind == 0);
+  }
+
+  co_moments state;
+};
+
+using covar_samp = co_moments_function<0>;
+using covar_pop  = co_moments_function<1>;
+using corr       = co_moments_function<2>;
+
+/// `median(x)`
+struct median
+{
+  void step(span<sqlite::value, 1u> args)
+  {
+    if (!args[0].is_null())
+      state.insert(args[0].get_double());
+  }
+  void inverse(span<sqlite::value, 1u> args) noexcept
+  {
+    if (!args[0].is_null())
+      state.erase(args[0].get_double());
+  }
+  optional_double value() const noexcept {return state.quantile(.5);}
+
+  order_statistic state;
+};
+
+/// `percentile_cont(x, q)`, `q` must be constant and in [0, 1].
+struct percentile_cont
+{
+  BOOST_SQLITE_DECL result<void> step(span<sqlite::value, 2u> args);
+  result<void> inverse(span<sqlite::value, 2u> args) noexcept
+  {
+    if (!args[0].is_null())
+      state.erase(args[0].get_double());
+    return {};
+  }
+  optional_double value() const noexcept
+  {
+    if (q < 0.)
+      return nullptr;
+    return state.quantile(q);
+  }
+
+  order_statistic state;
+  double q = -1.;
+};
+
+/// `tdigest(x)`, returns the serialized digest of all values.
+struct tdigest_function
+{
+  void step(span<sqlite::value, 1u> args)
+  {
+    if (!args[0].is_null())
+      state.add(args[0].get_double());
+  }
+  blob final() {return state.to_blob();}
+
+  tdigest state;
+};
+
+/// `tdigest_merge(digest)`, merges serialized digests into one.
+struct tdigest_merge
+{
+  result<void> step(span<sqlite::value, 1u> args)
+  {
+    if (args[0].is_null())
+      return {};
+    return state.merge(args[0].get_blob());
+  }
+  blob final() {return state.to_blob();}
+
+  tdigest state;
+};
+
+/// `approx_percentile(x, q)`, the approximate quantile using a t-digest. `q` must be constant and in [0, 1].
+struct approx_percentile
+{
+  BOOST_SQLITE_DECL result<void> step(span<sqlite::value, 2u> args);
+  optional_double final()
+  {
+    if (q < 0.)
+      return nullptr;
+    return state.quantile(q);
+  }
+
+  tdigest state;
+  double q = -1.;
+};
+
+}
+
+///@{
+/** @brief Add the statistical aggregates to a connection.
+    @ingroup reference
+
+    The following functions get registered:
+
+    @li `var_samp(x)`, `var_pop(x)`, `stddev_samp(x)`, `stddev_pop(x)`
+    @li `covar_samp(x, y)`, `covar_pop(x, y)`, `corr(x, y)`
+    @li `median(x)`, `percentile_cont(x, q)`
+    @li `tdigest(x)`, `tdigest_merge(digest)`, `tdigest_quantile(digest, q)`, `approx_percentile(x, q)`
+
+    All but the t-digest functions are window functions supporting sliding frames.
+    Values are converted to floating point, NULLs are ignored.
+
+    @par Example
+    @code{.cpp}
+    sqlite::create_statistics_functions(conn);
+    auto st = conn.prepare("select ts, median(latency) over (order by ts rows 99 preceding) from requests;");
+    @endcode
+ */
+BOOST_SQLITE_DECL
+void create_statistics_functions(connection_ref conn, system::error_code & ec, error_info & ei);
+
+BOOST_SQLITE_DECL
+void create_statistics_functions(connection_ref conn);
+///@}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif //BOOST_SQLITE_STATISTICS_HPP
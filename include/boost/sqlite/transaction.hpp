@@ -12,10 +12,33 @@
 
 BOOST_SQLITE_BEGIN_NAMESPACE
 
+namespace detail
+{
+
+enum class control_op
+{
+  begin, begin_deferred, begin_immediate, begin_exclusive, commit, rollback,
+  savepoint, release, rollback_savepoint
+};
+
+// Run a transaction control statement, `name` is the name of the savepoint.
+// The statements get prepared once & reused if `cache` isn't null.
+BOOST_SQLITE_DECL void execute_control(connection_ref conn, control_statements * cache,
+                                       control_op op, core::string_view name,
+                                       system::error_code & ec, error_info & ei);
+
+BOOST_SQLITE_DECL void execute_control(connection_ref conn, control_statements * cache,
+                                       control_op op, core::string_view name = {});
+
+}
+
 /**
  * @brief A simple transaction guard implementing RAAI for transactions
  * @ingroup reference
  *
+ * When created from a `connection`, the statements to begin, commit & rollback
+ * get prepared once and reused by all transactions on that connection.
+ *
  *   @par Example
  *   @code{.cpp}
  *     sqlite::connection conn;
@@ -34,50 +57,68 @@ struct transaction
   constexpr static struct adopt_transaction_t {} adopt_transaction{};
 
 
+  ///@{
   /// Create transaction guard on an existing transaction
   transaction(connection_ref conn, adopt_transaction_t) : conn_(conn), completed_(false)
   {
   }
 
+  transaction(connection & conn, adopt_transaction_t)
+    : conn_(conn), control_(detail::control_statements_of(conn)), completed_(false)
+  {
+  }
+  ///@}
 
+  ///@{
   /// Create transaction guard and initiate a transaction
   transaction(connection_ref conn) : conn_(conn)
   {
-    conn.prepare("BEGIN").step();
+    detail::execute_control(conn_, control_, detail::control_op::begin);
     completed_ = false;
   }
 
+  transaction(connection & conn) : conn_(conn), control_(detail::control_statements_of(conn))
+  {
+    detail::execute_control(conn_, control_, detail::control_op::begin);
+    completed_ = false;
+  }
+  ///@}
+
+  ///@{
   /// Create transaction guard and initiate a transaction with the defined behaviour
   transaction(connection_ref conn, behaviour b) : conn_(conn)
   {
-    switch (b)
-    {
-      case deferred:  conn.prepare("BEGIN DEFERRED").step(); break;
-      case immediate: conn.prepare("BEGIN IMMEDIATE").step(); break;
-      case exclusive: conn.prepare("BEGIN EXCLUSIVE").step(); break;
-    }
+    detail::execute_control(conn_, control_, begin_op(b));
     completed_ = false;
   }
 
+  transaction(connection & conn, behaviour b) : conn_(conn), control_(detail::control_statements_of(conn))
+  {
+    detail::execute_control(conn_, control_, begin_op(b));
+    completed_ = false;
+  }
+  ///@}
+
   // see https://www.sqlite.org/lang_transaction.html re noexcept
   /// rollback the transaction if not committed.
   ~transaction() noexcept(SQLITE_VERSION_NUMBER >= 3007011)
   {
-    if (!completed_)
-      conn_.prepare("ROLLBACK").step();
+    // some errors roll back the transaction on their own.
+    if (!completed_ && !sqlite3_get_autocommit(conn_.handle()))
+      detail::execute_control(conn_, control_, detail::control_op::rollback);
   }
 
   ///@{
   /// Commit the transaction.
   void commit()
   {
-    conn_.prepare("COMMIT").step();
+    detail::execute_control(conn_, control_, detail::control_op::commit);
     completed_ = true;
   }
 
   void commit(system::error_code & ec, error_info & ei)
   {
-    conn_.prepare("COMMIT").step(ec, ei);
+    detail::execute_control(conn_, control_, detail::control_op::commit, {}, ec, ei);
     completed_ = true;
   }
   ///@}
@@ -86,19 +127,31 @@ struct transaction
   /// Rollback the transaction explicitly.
   void rollback()
   {
-    conn_.prepare("ROLLBACK").step();
+    detail::execute_control(conn_, control_, detail::control_op::rollback);
     completed_ = true;
   }
 
   void rollback(system::error_code & ec, error_info & ei)
   {
-    conn_.prepare("ROLLBACK").step(ec, ei);
+    detail::execute_control(conn_, control_, detail::control_op::rollback, {}, ec, ei);
     completed_ = true;
   }
   ///@}
 
  private:
+  static detail::control_op begin_op(behaviour b)
+  {
+    switch (b)
+    {
+      case deferred:  return detail::control_op::begin_deferred;
+      case immediate: return detail::control_op::begin_immediate;
+      case exclusive: return detail::control_op::begin_exclusive;
+    }
+    return detail::control_op::begin;
+  }
+
   connection_ref conn_;
+  detail::control_statements * control_ = nullptr;
   bool completed_ = true;
 };
 
@@ -106,6 +159,11 @@ struct transaction
  * @brief A simple transaction guard implementing RAAI for savepoints. Savepoints can be used recursively.
  * @ingroup reference
  *
+ * When created from a `connection`, the statements of the savepoint get prepared once
+ * and reused by all savepoints with the same name on that connection.
+ *
+ * Rolling back a savepoint also releases it, so it doesn't remain open.
+ *
  * @par Example
  * @code{.cpp}
  *   sqlite::connection conn;
@@ -121,50 +179,66 @@ struct savepoint
   /// A tag to use, to adopt an already initiated transaction.
   constexpr static transaction::adopt_transaction_t adopt_transaction{};
 
+  ///@{
   /// Create savepoint guard on an existing savepoint
   savepoint(connection_ref conn, std::string name, transaction::adopt_transaction_t)
-      : conn_(conn), name_(std::move(name))
+      : conn_(conn), name_(std::move(name)), completed_(false)
+  {
+  }
+
+  savepoint(connection & conn, std::string name, transaction::adopt_transaction_t)
+      : conn_(conn), control_(detail::control_statements_of(conn)), name_(std::move(name)), completed_(false)
   {
   }
+  ///@}
 
+  ///@{
   /// Create transaction guard and initiate it
   savepoint(connection_ref conn, std::string name) : conn_(conn), name_(std::move(name))
   {
-    conn.prepare("SAVEPOINT " + name_).step();
+    detail::execute_control(conn_, control_, detail::control_op::savepoint, name_);
     completed_ = false;
   }
 
+  savepoint(connection & conn, std::string name)
+      : conn_(conn), control_(detail::control_statements_of(conn)), name_(std::move(name))
+  {
+    detail::execute_control(conn_, control_, detail::control_op::savepoint, name_);
+    completed_ = false;
+  }
+  ///@}
 
   /// rollback to the savepoint if not committed.
   ~savepoint() noexcept(SQLITE_VERSION_NUMBER >= 3007011)
   {
-    if (!completed_)
-      conn_.prepare("ROLLBACK TO " + name_).step();
+    // a rollback of the whole transaction removed the savepoint already.
+    if (!completed_ && !sqlite3_get_autocommit(conn_.handle()))
+      detail::execute_control(conn_, control_, detail::control_op::rollback_savepoint, name_);
   }
 
   ///@{
   /// Commit/Release the transaction.
   void commit()
   {
-    conn_.prepare("RELEASE " + name_).step();
+    detail::execute_control(conn_, control_, detail::control_op::release, name_);
     completed_ = true;
   }
 
   void commit(system::error_code & ec, error_info & ei)
   {
-    conn_.prepare("RELEASE " + name_).step(ec, ei);
+    detail::execute_control(conn_, control_, detail::control_op::release, name_, ec, ei);
     completed_ = true;
   }
 
   void release()
   {
-    conn_.prepare("RELEASE " + name_).step();
+    detail::execute_control(conn_, control_, detail::control_op::release, name_);
     completed_ = true;
   }
 
   void release(system::error_code & ec, error_info & ei)
   {
-    conn_.prepare("RELEASE " + name_).step( ec, ei);
+    detail::execute_control(conn_, control_, detail::control_op::release, name_, ec, ei);
     completed_ = true;
   }
   ///@}
@@ -173,13 +247,13 @@ struct savepoint
   /// Rollback the transaction explicitly.
   void rollback()
   {
-    conn_.prepare("ROLLBACK TO" + name_);
+    detail::execute_control(conn_, control_, detail::control_op::rollback_savepoint, name_);
     completed_ = true;
   }
 
   void rollback(system::error_code & ec, error_info & ei)
   {
-    conn_.prepare("ROLLBACK TO " + name_).step( ec, ei);
+    detail::execute_control(conn_, control_, detail::control_op::rollback_savepoint, name_, ec, ei);
     completed_ = true;
   }
   ///@}
@@ -188,6 +262,7 @@ struct savepoint
   const std::string & name() const {return name_;}
  private:
   connection_ref conn_;
+  detail::control_statements * control_ = nullptr;
   std::string name_;
   bool completed_ = true;
 };
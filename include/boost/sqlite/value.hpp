@@ -9,6 +9,8 @@
 #include <boost/sqlite/blob.hpp>
 #include <boost/sqlite/cstring_ref.hpp>
 
+#include <memory>
+
 
 BOOST_SQLITE_BEGIN_NAMESPACE
 
@@ -125,6 +127,36 @@ struct value
 
 static_assert(sizeof(value) == sizeof(sqlite3_value*), "value must be same as sqlite3_value* pointer");
 
+/** @brief An owning copy of a value, e.g. to keep it past the current row.
+    @ingroup reference
+
+    [related sqlite documentation](https://www.sqlite.org/c3ref/value_dup.html)
+ */
+struct unique_value
+{
+    unique_value() noexcept = default;
+    /// Copy the value. Holds no value if sqlite ran out of memory.
+    explicit unique_value(value v) noexcept : impl_(sqlite3_value_dup(v.handle())) {}
+
+    /// The held value. Requires `*this` to hold a value.
+    value get() const noexcept {return value(impl_.get());}
+    /// Check if a value is held.
+    explicit operator bool () const noexcept {return impl_ != nullptr;}
+
+    /// The handle of the value.
+    using handle_type = sqlite3_value *;
+    /// Returns the handle.
+    handle_type handle() const noexcept {return impl_.get();}
+    /// Release the owned handle.
+    handle_type release() && noexcept {return impl_.release();}
+  private:
+    struct deleter_
+    {
+      void operator()(sqlite3_value * v) const noexcept {sqlite3_value_free(v);}
+    };
+    std::unique_ptr<sqlite3_value, deleter_> impl_;
+};
+
 BOOST_SQLITE_END_NAMESPACE
 
 #endif //BOOST_SQLITE_VALUE_HPP
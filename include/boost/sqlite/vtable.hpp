@@ -12,10 +12,13 @@
 #include <boost/sqlite/detail/catch.hpp>
 #include <boost/sqlite/function.hpp>
 
+#include <boost/assert.hpp>
 #include <boost/core/span.hpp>
 #include <boost/core/demangle.hpp>
 
+#include <algorithm>
 #include <bitset>
+#include <utility>
 
 BOOST_SQLITE_BEGIN_NAMESPACE
 namespace detail
@@ -150,7 +153,9 @@ struct in
             if (value == nullptr)
                 return ;
             auto res = sqlite3_vtab_in_first(value, &out_.handle());
-            if (res != SQLITE_OK)
+            if (res == SQLITE_DONE)
+              value_ = nullptr;
+            else if (res != SQLITE_OK)
             {
               system::error_code ec;
               BOOST_SQLITE_ASSIGN_EC(ec, res);
@@ -161,7 +166,12 @@ struct in
         iterator & operator++()
         {
           auto res = sqlite3_vtab_in_next(value_, &out_.handle());
-          if (res != SQLITE_OK)
+          if (res == SQLITE_DONE)
+          {
+            value_ = nullptr;
+            out_.handle() = nullptr;
+          }
+          else if (res != SQLITE_OK)
           {
             system::error_code ec;
             BOOST_SQLITE_ASSIGN_EC(ec, res);
@@ -248,12 +258,35 @@ struct index_info
   sqlite3_index_info::sqlite3_index_constraint_usage & usage_of(
       const sqlite3_index_info::sqlite3_index_constraint & info)
   {
-    auto dist = std::distance(constraints().begin(), &info);
-    auto itr = usage().begin() + dist;
+    auto itr = usage().begin() + index_of(info);
     BOOST_ASSERT(itr < usage().end());
     return *itr;
   }
 
+  /// The position of the constraint, as used by `collation`, `rhs_value` & `is_in`.
+  std::size_t index_of(const sqlite3_index_info::sqlite3_index_constraint & info) const
+  {
+    return static_cast<std::size_t>(std::distance(constraints().begin(), &info));
+  }
+
+  /** @brief Pass the right hand side of the constraint to `cursor::filter`.
+
+      @param info The constraint.
+      @param omit If true, sqlite won't double check the constraint, i.e. the cursor must enforce it.
+      @returns The position of the value in the `values` passed to `filter`.
+   */
+  std::size_t claim(const sqlite3_index_info::sqlite3_index_constraint & info, bool omit = false)
+  {
+    int argv = 0;
+    for (auto & u : usage())
+      argv = (std::max)(argv, u.argvIndex);
+    auto & u = usage_of(info);
+    BOOST_ASSERT(u.argvIndex == 0);
+    u.argvIndex = argv + 1;
+    u.omit = omit ? 1 : 0;
+    return static_cast<std::size_t>(argv);
+  }
+
 #if SQLITE_VERSION_NUMBER >= 3022000
 
   /// Receive the collation for the contrainst of the position.
@@ -269,15 +302,79 @@ struct index_info
   /// Returns true if the constraint is
   bool   distinct() const {return sqlite3_vtab_distinct(info_);}
 
-  value * rhs_value(std::size_t idx) const
+  /** @brief The right hand side of the constraint at `idx`, if it is known during planning.
+
+      Fails with `SQLITE_NOTFOUND` if the value isn't a constant, e.g. a parameter or a column of another table.
+      The value is only valid during `best_index`.
+   */
+  result<value> rhs_value(std::size_t idx) const
+  {
+    sqlite3_value * v = nullptr;
+    const auto res = sqlite3_vtab_rhs_value(info_, static_cast<int>(idx), &v);
+    if (res != SQLITE_OK)
+      return error(res);
+    return value{v};
+  }
+
+  /// Returns true if the `==` constraint at `idx` is an `IN` operator that can be processed all at once.
+  bool is_in(std::size_t idx) const
+  {
+    return sqlite3_vtab_in(info_, static_cast<int>(idx), -1) != 0;
+  }
+
+  /** @brief Receive the whole `IN` list of the constraint in `filter`, instead of one `filter` call per element.
+
+      The list can be iterated with `vtab::in` in `filter`. It must be claimed with `omit`.
+
+      @returns false if the constraint isn't an `IN` that can be processed all at once.
+   */
+  bool claim_in(const sqlite3_index_info::sqlite3_index_constraint & info)
+  {
+    const auto idx = static_cast<int>(index_of(info));
+    if (sqlite3_vtab_in(info_, idx, -1) == 0)
+      return false;
+    sqlite3_vtab_in(info_, idx, 1);
+    claim(info, true);
+    return true;
+  }
+
+  /// Returns the `LIMIT` constraint, or nullptr if the query doesn't have one that can be pushed into the table.
+  const sqlite3_index_info::sqlite3_index_constraint * limit() const
+  {
+    return find_constraint(SQLITE_INDEX_CONSTRAINT_LIMIT);
+  }
+
+  /// Returns the `OFFSET` constraint, or nullptr if the query doesn't have one that can be pushed into the table.
+  const sqlite3_index_info::sqlite3_index_constraint * offset() const
+  {
+    return find_constraint(SQLITE_INDEX_CONSTRAINT_OFFSET);
+  }
+
+  /** @brief Pass the LIMIT & OFFSET to `filter`.
+
+      This is only valid if all other constraints are claimed with `omit`, because the cursor can only
+      apply the limit if no row it returns gets filtered out by sqlite.
+      The cursor must then skip `offset` rows & return at most `limit`.
+
+      @returns The positions of the values in `filter`, `-1` if there's no such constraint.
+   */
+  std::pair<int, int> claim_limit_and_offset()
   {
-    value * v = nullptr;
-    if (sqlite3_vtab_rhs_value(
-          info_, static_cast<int>(idx),
-          reinterpret_cast<sqlite3_value**>(v)) == SQLITE_OK)
-      return v;
-    else
-      return nullptr;
+    std::pair<int, int> res{-1, -1};
+    for (auto & ct : constraints())
+    {
+      if (ct.op == SQLITE_INDEX_CONSTRAINT_LIMIT || ct.op == SQLITE_INDEX_CONSTRAINT_OFFSET)
+        continue;
+      const auto & u = usage_of(ct);
+      if (!ct.usable || u.argvIndex == 0 || !u.omit)
+        return res;
+    }
+
+    if (auto l = limit())
+      res.first = static_cast<int>(claim(*l, true));
+    if (auto o = offset())
+      res.second = static_cast<int>(claim(*o, true));
+    return res;
   }
 #endif
 
@@ -308,6 +405,14 @@ struct index_info
   sqlite3 * db() const { return db_; }
 
  private:
+  const sqlite3_index_info::sqlite3_index_constraint * find_constraint(unsigned char op) const
+  {
+    for (auto & ct : constraints())
+      if (ct.usable && ct.op == op)
+        return &ct;
+    return nullptr;
+  }
+
   explicit index_info(sqlite3 * db, sqlite3_index_info * info) : db_(db), info_(info) {}
   sqlite3 * db_;
   sqlite3_index_info * info_{nullptr};
@@ -532,6 +637,46 @@ struct recursive_transaction
 };
 #endif
 
+/** @brief Keep closed cursors of a table for reuse. @ingroup reference
+
+  When a table inherits this, closed cursors get `reset()` and kept,
+  so the next open takes one from the pool instead of calling `open()` & allocating a new one.
+  This helps with nested loop joins, where sqlite opens a cursor once for every outer row.
+
+  The cursor_type needs the following member, which needs to bring it into the state `open()` would produce:
+
+  @code{.cpp}
+  result<void> reset();
+  @endcode
+
+  If `reset` fails the cursor gets destroyed instead.
+ */
+struct cursor_pool
+{
+  /// The maximum number of cursors kept in the pool.
+  constexpr static std::size_t capacity = 4u;
+
+  cursor_pool() = default;
+  cursor_pool(cursor_pool && lhs) noexcept : size_(lhs.size_), destroy_(lhs.destroy_)
+  {
+    std::copy_n(lhs.free_, size_, free_);
+    lhs.size_ = 0u;
+  }
+  cursor_pool& operator=(cursor_pool && ) = delete;
+
+  ~cursor_pool()
+  {
+    for (std::size_t i = 0u; i < size_; i++)
+      destroy_(free_[i]);
+  }
+ private:
+  friend struct detail::vtab_impl;
+
+  sqlite3_vtab_cursor * free_[capacity];
+  std::size_t size_ = 0u;
+  void (*destroy_)(sqlite3_vtab_cursor *) = nullptr;
+};
+
 }
 
 
@@ -0,0 +1,502 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/arrow.hpp>
+#include <boost/sqlite/detail/exception.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <string>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+namespace arrow
+{
+
+namespace
+{
+
+// the arrow format strings double as the type tags: int64, float64, large_utf8 & large_binary
+constexpr char int64_type  = 'l';
+constexpr char real_type   = 'g';
+constexpr char text_type   = 'U';
+constexpr char blob_type   = 'Z';
+constexpr char unknown_type = '?';
+
+const char * format_of(char type) noexcept
+{
+  switch (type)
+  {
+    case int64_type: return "l";
+    case real_type:  return "g";
+    case blob_type:  return "Z";
+    default:         return "U";
+  }
+}
+
+// the affinity rules from https://www.sqlite.org/datatype3.html#determination_of_column_affinity,
+// numeric affinity is left to the values.
+char type_of_decl(const char * decl) noexcept
+{
+  if (decl == nullptr || *decl == '\0')
+    return unknown_type;
+
+  std::string upper{decl};
+  std::transform(upper.begin(), upper.end(), upper.begin(),
+                 [](char c) { return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c; });
+  const auto has = [&](const char * s) { return upper.find(s) != std::string::npos; };
+
+  if (has("INT"))
+    return int64_type;
+  if (has("CHAR") || has("CLOB") || has("TEXT"))
+    return text_type;
+  if (has("BLOB"))
+    return blob_type;
+  if (has("REAL") || has("FLOA") || has("DOUB"))
+    return real_type;
+  return unknown_type;
+}
+
+// the type able to hold both, an integer column with a single real becomes a real one.
+char widen(char current, int sqlite_type) noexcept
+{
+  const auto rank = [](char t)
+  {
+    switch (t)
+    {
+      case int64_type: return 1;
+      case real_type:  return 2;
+      case text_type:  return 3;
+      case blob_type:  return 4;
+      default:         return 0;
+    }
+  };
+  char next;
+  switch (sqlite_type)
+  {
+    case SQLITE_INTEGER: next = int64_type; break;
+    case SQLITE_FLOAT:   next = real_type;  break;
+    case SQLITE_TEXT:    next = text_type;  break;
+    case SQLITE_BLOB:    next = blob_type;  break;
+    default: return current;
+  }
+  return rank(next) > rank(current) ? next : current;
+}
+
+// reads a value from the current row of a statement
+struct column_source
+{
+  sqlite3_stmt * stmt;
+  int col;
+
+  int type() const { return sqlite3_column_type(stmt, col); }
+  sqlite3_int64 int64() const { return sqlite3_column_int64(stmt, col); }
+  double real() const { return sqlite3_column_double(stmt, col); }
+  const void * text() const { return sqlite3_column_text(stmt, col); }
+  const void * blob() const { return sqlite3_column_blob(stmt, col); }
+  int bytes() const { return sqlite3_column_bytes(stmt, col); }
+};
+
+// reads a buffered value of the first batch
+struct value_source
+{
+  sqlite3_value * value;
+
+  int type() const { return sqlite3_value_type(value); }
+  sqlite3_int64 int64() const { return sqlite3_value_int64(value); }
+  double real() const { return sqlite3_value_double(value); }
+  const void * text() const { return sqlite3_value_text(value); }
+  const void * blob() const { return sqlite3_value_blob(value); }
+  int bytes() const { return sqlite3_value_bytes(value); }
+};
+
+// The buffers of one column of a batch. It's the private_data of the exported child array.
+struct column_builder
+{
+  char type;
+  std::int64_t length = 0;
+  std::int64_t null_count = 0;
+  std::size_t capacity;
+
+  // empty until the first null is appended
+  std::vector<std::uint8_t> validity;
+  // the values for int64, the offsets for text & blob
+  std::vector<std::int64_t> ints;
+  std::vector<double> reals;
+  std::vector<char> data;
+
+  const void * buffers[3] = {nullptr, nullptr, nullptr};
+
+  column_builder(char type, std::size_t capacity) : type(type), capacity(capacity)
+  {
+    switch (type)
+    {
+      case int64_type:
+        ints.reserve(capacity);
+        break;
+      case real_type:
+        reals.reserve(capacity);
+        break;
+      default:
+        ints.reserve(capacity + 1u);
+        ints.push_back(0);
+        // consumers expect a data buffer, even if all values are empty.
+        data.reserve(64u);
+    }
+  }
+
+  void append_null()
+  {
+    if (validity.empty())
+      validity.assign((capacity + 7u) / 8u, 0xFFu);
+    validity[static_cast<std::size_t>(length) / 8u] &= static_cast<std::uint8_t>(~(1u << (length % 8u)));
+    null_count++;
+    length++;
+    switch (type)
+    {
+      case int64_type: ints.push_back(0);           break;
+      case real_type:  reals.push_back(0.);         break;
+      default:         ints.push_back(ints.back()); break;
+    }
+  }
+
+  template<typename Source>
+  void append(const Source & src)
+  {
+    if (src.type() == SQLITE_NULL)
+      return append_null();
+
+    switch (type)
+    {
+      case int64_type: ints.push_back(src.int64()); break;
+      case real_type:  reals.push_back(src.real()); break;
+      default:
+      {
+        // text before bytes, so the conversion to text is accounted for.
+        const auto p = static_cast<const char*>(type == text_type ? src.text() : src.blob());
+        const auto n = static_cast<std::size_t>(src.bytes());
+        data.insert(data.end(), p, p + n);
+        ints.push_back(static_cast<std::int64_t>(data.size()));
+      }
+    }
+    length++;
+  }
+
+  void export_to(ArrowArray * out)
+  {
+    const void * values = type == int64_type ? static_cast<const void*>(ints.data()) :
+                          type == real_type  ? static_cast<const void*>(reals.data()) :
+                                               static_cast<const void*>(ints.data());
+    buffers[0] = validity.empty() ? nullptr : validity.data();
+    buffers[1] = values;
+    buffers[2] = data.data();
+
+    out->length = length;
+    out->null_count = null_count;
+    out->offset = 0;
+    out->n_buffers = (type == int64_type || type == real_type) ? 2 : 3;
+    out->n_children = 0;
+    out->buffers = buffers;
+    out->children = nullptr;
+    out->dictionary = nullptr;
+    out->private_data = this;
+    out->release = +[](ArrowArray * array)
+    {
+      delete static_cast<column_builder*>(array->private_data);
+      array->release = nullptr;
+    };
+  }
+};
+
+// The private data of an exported batch, the children may be moved out by the consumer.
+struct batch_data
+{
+  std::vector<ArrowArray> children;
+  std::vector<ArrowArray*> child_ptrs;
+  const void * buffers[1] = {nullptr};
+};
+
+void release_batch(ArrowArray * array)
+{
+  const auto data = static_cast<batch_data*>(array->private_data);
+  for (auto child : data->child_ptrs)
+    if (child->release != nullptr)
+      child->release(child);
+  delete data;
+  array->release = nullptr;
+}
+
+struct schema_data
+{
+  std::vector<ArrowSchema> children;
+  std::vector<ArrowSchema*> child_ptrs;
+};
+
+void release_schema(ArrowSchema * schema)
+{
+  const auto data = static_cast<schema_data*>(schema->private_data);
+  for (auto child : data->child_ptrs)
+    if (child->release != nullptr)
+      child->release(child);
+  delete data;
+  schema->release = nullptr;
+}
+
+void release_field(ArrowSchema * schema)
+{
+  delete static_cast<std::string*>(schema->private_data);
+  schema->release = nullptr;
+}
+
+}
+
+void batch_reader::fail(const system::error_code & ec, const error_info & ei)
+{
+  buffered_.clear();
+  buffered_.shrink_to_fit();
+  error_ = ec;
+  error_info_.set_message(ei.message());
+}
+
+bool batch_reader::failed(system::error_code & ec, error_info & ei) const
+{
+  if (!error_)
+    return false;
+  ec = error_;
+  ei.set_message(error_info_.message());
+  return true;
+}
+
+void batch_reader::resolve_types(system::error_code & ec, error_info & ei)
+{
+  const auto handle = stmt_->handle();
+  const auto columns = sqlite3_column_count(handle);
+  types_.resize(static_cast<std::size_t>(columns));
+  std::vector<bool> unknown(types_.size());
+  for (int i = 0; i < columns; i++)
+  {
+    types_[static_cast<std::size_t>(i)] = type_of_decl(sqlite3_column_decltype(handle, i));
+    unknown[static_cast<std::size_t>(i)] = types_[static_cast<std::size_t>(i)] == unknown_type;
+  }
+
+  if (std::find(unknown.begin(), unknown.end(), true) != unknown.end())
+  {
+    // Buffer the first batch, so the type can be derived from the values.
+    buffered_.reserve(batch_size_ * static_cast<std::size_t>(columns));
+    for (std::size_t row = 0u; !ec && row < batch_size_ && stmt_->step(ec, ei); row++)
+      for (int i = 0; i < columns; i++)
+      {
+        const auto value = sqlite3_column_value(handle, i);
+        if (unknown[static_cast<std::size_t>(i)])
+          types_[static_cast<std::size_t>(i)] = widen(types_[static_cast<std::size_t>(i)], sqlite3_value_type(value));
+        buffered_.emplace_back(sqlite3_value_dup(value));
+        if (!buffered_.back())
+          BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_NOMEM);
+      }
+    if (ec)
+      return fail(ec, ei);
+
+    // all null
+    for (auto & type : types_)
+      if (type == unknown_type)
+        type = text_type;
+  }
+  resolved_ = true;
+}
+
+void batch_reader::read_schema(ArrowSchema * out, system::error_code & ec, error_info & ei)
+{
+  out->release = nullptr;
+  if (failed(ec, ei))
+    return;
+  if (!resolved_)
+    resolve_types(ec, ei);
+  if (ec)
+    return;
+
+  const auto handle = stmt_->handle();
+  std::unique_ptr<schema_data> data{new schema_data()};
+  data->children.resize(types_.size());
+  for (std::size_t i = 0u; i < types_.size(); i++)
+  {
+    auto & child = data->children[i];
+    const auto name = new std::string(sqlite3_column_name(handle, static_cast<int>(i)));
+    child.format = format_of(types_[i]);
+    child.name = name->c_str();
+    child.metadata = nullptr;
+    child.flags = ARROW_FLAG_NULLABLE;
+    child.n_children = 0;
+    child.children = nullptr;
+    child.dictionary = nullptr;
+    child.release = &release_field;
+    child.private_data = name;
+    data->child_ptrs.push_back(&child);
+  }
+
+  out->format = "+s";
+  out->name = "";
+  out->metadata = nullptr;
+  out->flags = 0;
+  out->n_children = static_cast<std::int64_t>(types_.size());
+  out->children = data->child_ptrs.data();
+  out->dictionary = nullptr;
+  out->private_data = data.release();
+  out->release = &release_schema;
+}
+
+void batch_reader::read_schema(ArrowSchema * out)
+{
+  system::error_code ec;
+  error_info ei;
+  read_schema(out, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+bool batch_reader::read_next(ArrowArray * out, system::error_code & ec, error_info & ei)
+{
+  out->release = nullptr;
+  if (failed(ec, ei))
+    return false;
+  if (!resolved_)
+    resolve_types(ec, ei);
+  if (ec)
+    return false;
+
+  const auto columns = types_.size();
+  std::vector<std::unique_ptr<column_builder>> builders;
+  builders.reserve(columns);
+  for (auto type : types_)
+    builders.emplace_back(new column_builder(type, batch_size_));
+
+  std::size_t rows = 0u;
+  if (!buffered_.empty())
+  {
+    rows = buffered_.size() / columns;
+    for (std::size_t i = 0u; i < buffered_.size(); i++)
+      builders[i % columns]->append(value_source{buffered_[i].get()});
+    buffered_.clear();
+    buffered_.shrink_to_fit();
+  }
+  else
+  {
+    const auto handle = stmt_->handle();
+    for (; !ec && rows < batch_size_ && stmt_->step(ec, ei); rows++)
+      for (std::size_t i = 0u; i < columns; i++)
+        builders[i]->append(column_source{handle, static_cast<int>(i)});
+    if (ec)
+    {
+      fail(ec, ei);
+      return false;
+    }
+  }
+
+  if (rows == 0u)
+    return false;
+
+  std::unique_ptr<batch_data> data{new batch_data()};
+  data->children.resize(columns);
+  for (std::size_t i = 0u; i < columns; i++)
+  {
+    builders[i]->export_to(&data->children[i]);
+    builders[i].release();
+    data->child_ptrs.push_back(&data->children[i]);
+  }
+
+  out->length = static_cast<std::int64_t>(rows);
+  out->null_count = 0;
+  out->offset = 0;
+  out->n_buffers = 1;
+  out->n_children = static_cast<std::int64_t>(columns);
+  out->buffers = data->buffers;
+  out->children = data->child_ptrs.data();
+  out->dictionary = nullptr;
+  out->private_data = data.release();
+  out->release = &release_batch;
+  return true;
+}
+
+bool batch_reader::read_next(ArrowArray * out)
+{
+  system::error_code ec;
+  error_info ei;
+  const auto res = read_next(out, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+  return res;
+}
+
+namespace
+{
+
+struct stream_data
+{
+  statement stmt;
+  batch_reader reader;
+  std::string error;
+
+  stream_data(statement stmt, std::size_t batch_size)
+      : stmt(std::move(stmt)), reader(this->stmt, batch_size)
+  {
+  }
+
+  // the callbacks are invoked from C, so nothing may be thrown.
+  template<typename Func>
+  int invoke(Func func) noexcept
+  {
+    error.clear();
+    BOOST_TRY
+    {
+      system::error_code ec;
+      error_info ei;
+      func(ec, ei);
+      if (!ec)
+        return 0;
+      error = ei.message().empty() ? ec.message() : std::string(ei.message().c_str());
+      return (ec.category() == sqlite_category() && ec.value() == SQLITE_NOMEM) ? ENOMEM : EIO;
+    }
+    BOOST_CATCH(std::bad_alloc &)
+    {
+      return ENOMEM;
+    }
+    BOOST_CATCH(...)
+    {
+      return EIO;
+    }
+    BOOST_CATCH_END
+  }
+};
+
+}
+
+void export_stream(statement stmt, std::size_t batch_size, ArrowArrayStream * out)
+{
+  out->private_data = new stream_data(std::move(stmt), batch_size);
+  out->get_schema = +[](ArrowArrayStream * stream, ArrowSchema * schema)
+  {
+    auto & data = *static_cast<stream_data*>(stream->private_data);
+    return data.invoke([&](system::error_code & ec, error_info & ei) { data.reader.read_schema(schema, ec, ei); });
+  };
+  out->get_next = +[](ArrowArrayStream * stream, ArrowArray * array)
+  {
+    auto & data = *static_cast<stream_data*>(stream->private_data);
+    return data.invoke([&](system::error_code & ec, error_info & ei) { data.reader.read_next(array, ec, ei); });
+  };
+  out->get_last_error = +[](ArrowArrayStream * stream) -> const char *
+  {
+    auto & data = *static_cast<stream_data*>(stream->private_data);
+    return data.error.empty() ? nullptr : data.error.c_str();
+  };
+  out->release = +[](ArrowArrayStream * stream)
+  {
+    delete static_cast<stream_data*>(stream->private_data);
+    stream->release = nullptr;
+  };
+}
+
+}
+BOOST_SQLITE_END_NAMESPACE
@@ -0,0 +1,521 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/arrow_table.hpp>
+#include <boost/sqlite/container_table.hpp>
+#include <boost/sqlite/detail/exception.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+namespace vtab
+{
+
+namespace
+{
+
+using kind = arrow_batches::kind;
+
+bool kind_of_format(const char * format, kind & k) noexcept
+{
+  if (format == nullptr || format[0] == '\0')
+    return false;
+
+  // temporal types are stored as plain integers
+  if (format[0] == 't')
+  {
+    if (std::strcmp(format, "tdD") == 0 || std::strcmp(format, "tts") == 0 || std::strcmp(format, "ttm") == 0)
+      return k = kind::int32, true;
+    if (std::strcmp(format, "tdm") == 0 || std::strcmp(format, "ttu") == 0 || std::strcmp(format, "ttn") == 0
+        || std::strncmp(format, "ts", 2u) == 0 || std::strncmp(format, "tD", 2u) == 0)
+      return k = kind::int64, true;
+    return false;
+  }
+
+  if (format[1] != '\0')
+    return false;
+
+  switch (format[0])
+  {
+    case 'c': k = kind::int8;         return true;
+    case 's': k = kind::int16;        return true;
+    case 'i': k = kind::int32;        return true;
+    case 'l': k = kind::int64;        return true;
+    case 'C': k = kind::uint8;        return true;
+    case 'S': k = kind::uint16;       return true;
+    case 'I': k = kind::uint32;       return true;
+    case 'L': k = kind::uint64;       return true;
+    case 'f': k = kind::float32;      return true;
+    case 'g': k = kind::float64;      return true;
+    case 'b': k = kind::boolean;      return true;
+    case 'u': k = kind::utf8;         return true;
+    case 'U': k = kind::large_utf8;   return true;
+    case 'z': k = kind::binary;       return true;
+    case 'Z': k = kind::large_binary; return true;
+    default: return false;
+  }
+}
+
+bool is_integer(kind k) noexcept
+{
+  return k <= kind::uint32 || k == kind::boolean;
+}
+
+bool is_real(kind k) noexcept
+{
+  return k == kind::float32 || k == kind::float64;
+}
+
+bool is_text(kind k) noexcept
+{
+  return k == kind::utf8 || k == kind::large_utf8;
+}
+
+const char * declared_type(kind k) noexcept
+{
+  if (is_integer(k) || k == kind::uint64)
+    return " INTEGER";
+  if (is_real(k))
+    return " REAL";
+  if (is_text(k))
+    return " TEXT";
+  return " BLOB";
+}
+
+bool bit(const void * bitmap, std::size_t idx) noexcept
+{
+  return (static_cast<const std::uint8_t*>(bitmap)[idx / 8u] >> (idx % 8u)) & 1u;
+}
+
+template<typename T>
+T load(const void * buffer, std::size_t idx) noexcept
+{
+  T res;
+  std::memcpy(&res, static_cast<const char*>(buffer) + idx * sizeof(T), sizeof(T));
+  return res;
+}
+
+// A column of the current batch, `idx` is the row in the batch.
+struct column_view
+{
+  const ArrowArray & parent;
+  const ArrowArray & array;
+  kind type;
+
+  std::size_t physical(std::size_t idx) const noexcept
+  {
+    return static_cast<std::size_t>(array.offset + parent.offset) + idx;
+  }
+
+  bool is_null(std::size_t idx) const noexcept
+  {
+    if (parent.null_count != 0 && parent.buffers[0] != nullptr
+        && !bit(parent.buffers[0], static_cast<std::size_t>(parent.offset) + idx))
+      return true;
+    return array.null_count != 0 && array.buffers[0] != nullptr && !bit(array.buffers[0], physical(idx));
+  }
+
+  sqlite3_int64 integer(std::size_t idx) const noexcept
+  {
+    const auto i = physical(idx);
+    const auto values = array.buffers[1];
+    switch (type)
+    {
+      case kind::int8:    return load<std::int8_t>  (values, i);
+      case kind::int16:   return load<std::int16_t> (values, i);
+      case kind::int32:   return load<std::int32_t> (values, i);
+      case kind::int64:   return load<std::int64_t> (values, i);
+      case kind::uint8:   return load<std::uint8_t> (values, i);
+      case kind::uint16:  return load<std::uint16_t>(values, i);
+      case kind::uint32:  return load<std::uint32_t>(values, i);
+      case kind::uint64:  return static_cast<sqlite3_int64>(load<std::uint64_t>(values, i));
+      case kind::boolean: return bit(values, i);
+      default: return 0;
+    }
+  }
+
+  double real(std::size_t idx) const noexcept
+  {
+    return type == kind::float32 ? static_cast<double>(load<float>(array.buffers[1], physical(idx)))
+                                 : load<double>(array.buffers[1], physical(idx));
+  }
+
+  string_view bytes(std::size_t idx) const noexcept
+  {
+    const auto i = physical(idx);
+    std::int64_t begin, end;
+    if (type == kind::utf8 || type == kind::binary)
+    {
+      begin = load<std::int32_t>(array.buffers[1], i);
+      end   = load<std::int32_t>(array.buffers[1], i + 1u);
+    }
+    else
+    {
+      begin = load<std::int64_t>(array.buffers[1], i);
+      end   = load<std::int64_t>(array.buffers[1], i + 1u);
+    }
+    // sqlite would turn a null pointer into NULL instead of an empty string
+    const auto data = array.buffers[2] != nullptr ? static_cast<const char*>(array.buffers[2]) : "";
+    return string_view(data + begin, static_cast<std::size_t>(end - begin));
+  }
+};
+
+// text & blobs are handed to sqlite without a copy, the batches outlive every statement using the table.
+struct static_text { string_view value; };
+struct static_blob { string_view value; };
+
+void tag_invoke(set_result_tag, sqlite3_context * ctx, static_text txt) noexcept
+{
+  sqlite3_result_text64(ctx, txt.value.data(), txt.value.size(), SQLITE_STATIC, SQLITE_UTF8);
+}
+
+void tag_invoke(set_result_tag, sqlite3_context * ctx, static_blob blb) noexcept
+{
+  sqlite3_result_blob64(ctx, blb.value.data(), blb.value.size(), SQLITE_STATIC);
+}
+
+// ops as encoded in the index string.
+constexpr char op_eq = '=', op_lt = '<', op_le = 'l', op_gt = '>', op_ge = 'g';
+
+}
+
+void arrow_batches::import(ArrowArrayStream * stream, system::error_code & ec, error_info & ei)
+{
+  clear();
+  ArrowArrayStream str = *stream;
+  stream->release = nullptr;
+
+  const auto fail = [&](int rc)
+  {
+    const auto msg = str.get_last_error(&str);
+    if (msg != nullptr)
+      ei.set_message(msg);
+    else
+      ei.format("arrow stream error %d", rc);
+    BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_ERROR);
+    str.release(&str);
+    clear();
+  };
+
+  const auto rc = str.get_schema(&str, &schema_);
+  if (rc != 0)
+    return fail(rc);
+
+  if (std::strcmp(schema_.format, "+s") != 0)
+  {
+    ei.format("arrow stream must produce struct arrays, got '%s'", schema_.format);
+    BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_MISMATCH);
+    str.release(&str);
+    return clear();
+  }
+
+  columns_.reserve(static_cast<std::size_t>(schema_.n_children));
+  for (std::int64_t i = 0; i < schema_.n_children; i++)
+  {
+    const auto & child = *schema_.children[i];
+    column col{child.name != nullptr ? child.name : "", kind::int8};
+    if (child.dictionary != nullptr || !kind_of_format(child.format, col.type))
+    {
+      ei.format("unsupported arrow format '%s' of column '%s'", child.format, col.name.c_str());
+      BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_MISMATCH);
+      str.release(&str);
+      return clear();
+    }
+    columns_.push_back(std::move(col));
+  }
+
+  offsets_.push_back(0u);
+  while (true)
+  {
+    ArrowArray array;
+    const auto rc = str.get_next(&str, &array);
+    if (rc != 0)
+      return fail(rc);
+    if (array.release == nullptr)
+      break;
+    if (array.n_children != schema_.n_children)
+    {
+      array.release(&array);
+      ei.format("arrow batch has %lld columns instead of %lld",
+                static_cast<long long>(array.n_children), static_cast<long long>(schema_.n_children));
+      BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_MISMATCH);
+      str.release(&str);
+      return clear();
+    }
+    batches_.push_back(array);
+    offsets_.push_back(offsets_.back() + static_cast<std::size_t>(array.length));
+  }
+  str.release(&str);
+}
+
+void arrow_batches::import(ArrowArrayStream * stream)
+{
+  system::error_code ec;
+  error_info ei;
+  import(stream, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+void arrow_batches::clear() noexcept
+{
+  for (auto & b : batches_)
+    if (b.release != nullptr)
+      b.release(&b);
+  batches_.clear();
+  offsets_.clear();
+  columns_.clear();
+  if (schema_.release != nullptr)
+    schema_.release(&schema_);
+  schema_ = ArrowSchema{};
+}
+
+bool arrow_cursor::matches() const noexcept
+{
+  const auto & batch = data_->batch(batch_);
+  for (auto & ct : constraints_)
+  {
+    const column_view col{batch, *batch.children[ct.column], data_->column_kind(ct.column)};
+    if (col.is_null(row_))
+      return false;
+
+    if (is_integer(col.type))
+    {
+      const auto v = col.integer(row_);
+      if (v < ct.lo || v > ct.hi)
+        return false;
+    }
+    else if (is_real(col.type))
+    {
+      const auto v = col.real(row_);
+      switch (ct.op)
+      {
+        case op_eq: if (!(v == ct.real)) return false; break;
+        case op_lt: if (!(v <  ct.real)) return false; break;
+        case op_le: if (!(v <= ct.real)) return false; break;
+        case op_gt: if (!(v >  ct.real)) return false; break;
+        case op_ge: if (!(v >= ct.real)) return false; break;
+        default: break;
+      }
+    }
+    else if (col.bytes(row_) != ct.text)
+      return false;
+  }
+  return true;
+}
+
+// advance to the first matching row, starting at the current one.
+void arrow_cursor::seek() noexcept
+{
+  for (; batch_ < data_->batch_count(); batch_++, row_ = 0u)
+  {
+    const auto length = static_cast<std::size_t>(data_->batch(batch_).length);
+    for (; row_ < length; row_++)
+      if (constraints_.empty() || matches())
+        return;
+  }
+}
+
+result<void> arrow_cursor::filter(int index, const char * index_data, span<sqlite::value> values)
+{
+  batch_ = row_ = 0u;
+  constraints_.clear();
+  bool none = false;
+
+  if (index != 0 && index_data != nullptr)
+  {
+    auto arg = values.begin();
+    for (auto p = index_data; *p != '\0';)
+    {
+      BOOST_ASSERT(arg != values.end());
+      const auto v = *arg++;
+      char * end;
+      const auto col = static_cast<std::size_t>(std::strtoul(p, &end, 10));
+      const auto op = *end;
+      p = end + 1;
+
+      constraint ct{col, op,
+                    (std::numeric_limits<sqlite3_int64>::min)(), (std::numeric_limits<sqlite3_int64>::max)(),
+                    0., {}};
+      const auto type = data_->column_kind(col);
+      if (is_integer(type))
+      {
+        // the conversion rules of rowid constraints apply to integer columns
+        switch (op)
+        {
+          case op_eq: none |= !detail::container_rowid_eq(v, ct.lo); ct.hi = ct.lo; break;
+          case op_lt: none |= !detail::container_rowid_upper(v, true,  ct.hi); break;
+          case op_le: none |= !detail::container_rowid_upper(v, false, ct.hi); break;
+          case op_gt: none |= !detail::container_rowid_lower(v, true,  ct.lo); break;
+          case op_ge: none |= !detail::container_rowid_lower(v, false, ct.lo); break;
+          default: break;
+        }
+      }
+      else if (is_real(type))
+      {
+        switch (sqlite3_value_numeric_type(v.handle()))
+        {
+          case SQLITE_INTEGER: BOOST_FALLTHROUGH;
+          case SQLITE_FLOAT:
+            ct.real = v.get_double();
+            break;
+          case SQLITE_NULL:
+            none = true;
+            break;
+          default: // numbers compare lower than text & blobs
+            none |= op != op_lt && op != op_le;
+            continue;
+        }
+      }
+      else
+      {
+        // sqlite double checks text constraints, so other types of values can be left to it.
+        if (v.type() != value_type::text)
+          continue;
+        const auto txt = v.get_text();
+        ct.text.assign(txt.data(), txt.size());
+      }
+      constraints_.push_back(std::move(ct));
+    }
+  }
+
+  if (none)
+    batch_ = data_->batch_count();
+  else
+    seek();
+  return {};
+}
+
+result<void> arrow_cursor::next()
+{
+  row_++;
+  seek();
+  return {};
+}
+
+void arrow_cursor::column(context<> ctx, int idx, bool /* no_change */)
+{
+  const auto & batch = data_->batch(batch_);
+  const auto i = static_cast<std::size_t>(idx);
+  const column_view col{batch, *batch.children[i], data_->column_kind(i)};
+  if (col.is_null(row_))
+    return ctx.set_result(nullptr);
+
+  switch (col.type)
+  {
+    case kind::uint64:
+    {
+      const auto v = load<std::uint64_t>(col.array.buffers[1], col.physical(row_));
+      if (v > static_cast<std::uint64_t>((std::numeric_limits<sqlite3_int64>::max)()))
+        return ctx.set_result(static_cast<double>(v));
+      return ctx.set_result(static_cast<sqlite3_int64>(v));
+    }
+    case kind::float32: BOOST_FALLTHROUGH;
+    case kind::float64:
+      return ctx.set_result(col.real(row_));
+    case kind::utf8: BOOST_FALLTHROUGH;
+    case kind::large_utf8:
+      return ctx.set_result(static_text{col.bytes(row_)});
+    case kind::binary: BOOST_FALLTHROUGH;
+    case kind::large_binary:
+      return ctx.set_result(static_blob{col.bytes(row_)});
+    default:
+      return ctx.set_result(col.integer(row_));
+  }
+}
+
+arrow_table::arrow_table(std::shared_ptr<const arrow_batches> data) : data_(std::move(data))
+{
+  declaration_ = "create table x(";
+  for (std::size_t i = 0u; i < data_->column_count(); i++)
+  {
+    if (i != 0u)
+      declaration_ += ", ";
+    declaration_ += '"';
+    for (auto c : data_->column_name(i))
+    {
+      if (c == '"')
+        declaration_ += '"';
+      declaration_ += c;
+    }
+    declaration_ += '"';
+    declaration_ += declared_type(data_->column_kind(i));
+  }
+  declaration_ += ");";
+}
+
+result<void> arrow_table::best_index(index_info & info)
+{
+  const auto rows = static_cast<double>(data_->size());
+  std::string plan;
+  double selectivity = 1.;
+
+  for (auto & ct : info.constraints())
+  {
+    if (!ct.usable || ct.iColumn < 0)
+      continue;
+
+    const auto type = data_->column_kind(static_cast<std::size_t>(ct.iColumn));
+    char op;
+    if (is_integer(type) || is_real(type))
+    {
+      switch (ct.op)
+      {
+        case SQLITE_INDEX_CONSTRAINT_EQ: op = op_eq; selectivity *= .1;  break;
+        case SQLITE_INDEX_CONSTRAINT_LT: op = op_lt; selectivity *= .25; break;
+        case SQLITE_INDEX_CONSTRAINT_LE: op = op_le; selectivity *= .25; break;
+        case SQLITE_INDEX_CONSTRAINT_GT: op = op_gt; selectivity *= .25; break;
+        case SQLITE_INDEX_CONSTRAINT_GE: op = op_ge; selectivity *= .25; break;
+        default:
+          continue;
+      }
+      info.claim(ct, true);
+    }
+    else if (is_text(type) && ct.op == SQLITE_INDEX_CONSTRAINT_EQ
+#if SQLITE_VERSION_NUMBER >= 3022000
+             && sqlite3_stricmp(info.collation(info.index_of(ct)), "BINARY") == 0
+#endif
+        )
+    {
+      op = op_eq;
+      selectivity *= .1;
+      info.claim(ct, false);
+    }
+    else
+      continue;
+
+    plan += std::to_string(ct.iColumn);
+    plan += op;
+  }
+
+  const auto estimate = (std::max)(rows * selectivity, 1.);
+  if (plan.empty())
+  {
+    info.set_index(0);
+    info.set_estimated_cost((std::max)(rows, 1.));
+#if SQLITE_VERSION_NUMBER >= 3008200
+    info.set_estimated_rows(static_cast<sqlite3_int64>(rows));
+#endif
+    return {};
+  }
+
+  auto str = sqlite3_mprintf("%s", plan.c_str());
+  if (str == nullptr)
+    return error(SQLITE_NOMEM);
+  info.set_index(1);
+  info.set_index_string(str);
+
+  // checking a row on the buffers is much cheaper than handing it to sqlite.
+  info.set_estimated_cost(rows * .05 + estimate);
+#if SQLITE_VERSION_NUMBER >= 3008200
+  info.set_estimated_rows(static_cast<sqlite3_int64>(estimate));
+#endif
+  return {};
+}
+
+}
+BOOST_SQLITE_END_NAMESPACE
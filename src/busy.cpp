@@ -0,0 +1,180 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/busy.hpp>
+
+#include <algorithm>
+#include <thread>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace
+{
+
+std::minstd_rand::result_type make_seed(const void * p) noexcept
+{
+  const auto t = static_cast<std::uintptr_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+  return static_cast<std::minstd_rand::result_type>(t ^ reinterpret_cast<std::uintptr_t>(p));
+}
+
+// The delay before retry number `n` (starting at zero), somewhere between half and the full exponential value.
+std::chrono::microseconds backoff_delay(const backoff_options & options, int n, std::minstd_rand & rng) noexcept
+{
+  const std::chrono::microseconds initial = options.initial_delay;
+  const std::chrono::microseconds max_delay = options.max_delay;
+  auto delay = initial * (std::int64_t(1) << (std::min)(n, 30));
+  if (delay > max_delay || delay < initial)
+    delay = max_delay;
+  if (delay.count() <= 1)
+    return delay;
+  std::uniform_int_distribution<std::int64_t> dist{delay.count() / 2, delay.count()};
+  return std::chrono::microseconds(dist(rng));
+}
+
+std::size_t bucket_of(std::uint64_t value) noexcept
+{
+  std::size_t n = 0u;
+  while (value > 1u && n + 1u < lock_wait_metrics::buckets)
+  {
+    value >>= 1;
+    n++;
+  }
+  return n;
+}
+
+// Move one entry from the bucket of `from` to the bucket of `to`.
+void move_entry(std::array<std::atomic<std::uint64_t>, lock_wait_metrics::buckets> & histogram,
+                std::uint64_t from, std::uint64_t to) noexcept
+{
+  const auto f = bucket_of(from), t = bucket_of(to);
+  if (f == t)
+    return;
+  histogram[t].fetch_add(1u, std::memory_order_relaxed);
+  histogram[f].fetch_sub(1u, std::memory_order_relaxed);
+}
+
+bool is_transient(const system::error_code & ec) noexcept
+{
+  if (ec.category() != sqlite_category())
+    return false;
+  const auto primary = ec.value() & 0xFF;
+  return primary == SQLITE_BUSY || primary == SQLITE_LOCKED;
+}
+
+}
+
+void busy_timeout(connection_ref conn, std::chrono::milliseconds timeout) noexcept
+{
+  sqlite3_busy_timeout(conn.handle(), static_cast<int>(timeout.count()));
+}
+
+backoff_busy_handler::backoff_busy_handler(backoff_options options) noexcept
+  : options_(options), rng_(make_seed(this))
+{
+}
+
+bool backoff_busy_handler::operator()(int count) noexcept
+{
+  using std::chrono::steady_clock;
+  if (count == 0)
+  {
+    // a new wait, which is kept in the histograms while it grows.
+    start_ = steady_clock::now();
+    current_retries_ = current_wait_ = 0u;
+    waits_.fetch_add(1u, std::memory_order_relaxed);
+    retry_histogram_[0].fetch_add(1u, std::memory_order_relaxed);
+    wait_histogram_[0].fetch_add(1u, std::memory_order_relaxed);
+  }
+
+  const auto elapsed = steady_clock::now() - start_;
+  if (elapsed >= options_.timeout)
+  {
+    timeouts_.fetch_add(1u, std::memory_order_relaxed);
+    return false;
+  }
+
+  const auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(options_.timeout - elapsed);
+  std::this_thread::sleep_for((std::min)(backoff_delay(options_, count, rng_), remaining));
+
+  retries_.fetch_add(1u, std::memory_order_relaxed);
+  move_entry(retry_histogram_, current_retries_, current_retries_ + 1u);
+  current_retries_++;
+
+  const auto waited = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(steady_clock::now() - start_).count());
+  move_entry(wait_histogram_, current_wait_, waited);
+  current_wait_ = waited;
+  return true;
+}
+
+lock_wait_metrics backoff_busy_handler::metrics() const noexcept
+{
+  lock_wait_metrics res;
+  res.waits = waits_.load(std::memory_order_relaxed);
+  res.retries = retries_.load(std::memory_order_relaxed);
+  res.timeouts = timeouts_.load(std::memory_order_relaxed);
+  for (std::size_t i = 0u; i < lock_wait_metrics::buckets; i++)
+  {
+    res.retry_histogram[i] = retry_histogram_[i].load(std::memory_order_relaxed);
+    res.wait_histogram[i] = wait_histogram_[i].load(std::memory_order_relaxed);
+  }
+  return res;
+}
+
+namespace detail
+{
+
+retry_state::retry_state(const retry_options & options) noexcept
+  : options_(options), rng_(make_seed(this)), start_(std::chrono::steady_clock::now())
+{
+}
+
+void retry_state::begin(connection_ref conn, system::error_code & ec, error_info & ei)
+{
+  const char * sql = "BEGIN";
+  switch (options_.behaviour)
+  {
+    case transaction::deferred:  sql = "BEGIN DEFERRED";  break;
+    case transaction::immediate: sql = "BEGIN IMMEDIATE"; break;
+    case transaction::exclusive: sql = "BEGIN EXCLUSIVE"; break;
+  }
+  conn.execute(sql, ec, ei);
+}
+
+void retry_state::end(connection_ref conn, system::error_code & ec, error_info & ei)
+{
+  // a lazy message of `func` would be overwritten by the COMMIT or ROLLBACK.
+  ei.detach();
+  if (!ec)
+  {
+    const auto cc = sqlite3_exec(conn.handle(), "COMMIT", nullptr, nullptr, nullptr);
+    if (cc == SQLITE_OK)
+      return;
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    ei.set_message(sqlite3_errmsg(conn.handle()));
+  }
+  // some errors roll back the transaction on their own.
+  if (!sqlite3_get_autocommit(conn.handle()))
+    sqlite3_exec(conn.handle(), "ROLLBACK", nullptr, nullptr, nullptr);
+}
+
+bool retry_state::retry(const system::error_code & ec) noexcept
+{
+  if (!is_transient(ec) || attempts_ >= options_.max_attempts)
+    return false;
+
+  const auto elapsed = std::chrono::steady_clock::now() - start_;
+  if (elapsed >= options_.backoff.timeout)
+    return false;
+
+  const auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(options_.backoff.timeout - elapsed);
+  std::this_thread::sleep_for((std::min)(backoff_delay(options_.backoff, attempts_ - 1, rng_), remaining));
+  attempts_++;
+  return true;
+}
+
+}
+
+BOOST_SQLITE_END_NAMESPACE
@@ -0,0 +1,243 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/change_capture.hpp>
+#include <boost/sqlite/hooks.hpp>
+#include <boost/core/ignore_unused.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+// A slot of the ring, as in Dmitry Vyukov's bounded MPMC queue:
+// `seq == pos` means free for the producer at `pos`, `seq == pos + 1` filled for the consumer at `pos`.
+struct change_capture::cell
+{
+  std::atomic<std::size_t> seq{0u};
+  change_batch * data = nullptr;
+};
+
+// The hooks of one connection, collecting the changes of the current transaction.
+struct change_capture::connection_state
+{
+  change_capture & owner;
+  sqlite3 * db;
+  std::unique_ptr<change_batch> pending;
+  // an allocation failed, so the batch would be incomplete.
+  bool failed = false;
+
+  template<typename Func>
+  void record(Func && func) noexcept
+  {
+    if (failed)
+      return;
+    BOOST_TRY
+    {
+      if (!pending)
+        pending.reset(new change_batch());
+      func(*pending);
+    }
+    BOOST_CATCH(...)
+    {
+      failed = true;
+    }
+    BOOST_CATCH_END
+  }
+
+  struct on_update
+  {
+    connection_state * state;
+    void operator()(int op, const char * db_name, const char * table, sqlite3_int64 rowid) noexcept
+    {
+      state->record([&](change_batch & b)
+                    {
+                      b.changes.push_back(row_change{op, db_name, table, rowid, rowid, {}, {}});
+                    });
+    }
+  } update{this};
+
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+  struct on_preupdate
+  {
+    connection_state * state;
+    void operator()(preupdate_context ctx, int op, const char * db_name, const char * table,
+                    sqlite3_int64 old_rowid, sqlite3_int64 new_rowid) noexcept
+    {
+      state->record([&](change_batch & b)
+                    {
+                      row_change ch{op, db_name, table, old_rowid, new_rowid, {}, {}};
+                      const auto n = static_cast<std::size_t>(ctx.count());
+                      const auto copy = [&](system::result<value> v, std::vector<unique_value> & out)
+                      {
+                        out.emplace_back(v ? unique_value(*v) : unique_value());
+                        if (v && !out.back())
+                          throw_exception(std::bad_alloc());
+                      };
+                      if (op != SQLITE_INSERT)
+                      {
+                        ch.old_values.reserve(n);
+                        for (std::size_t i = 0u; i < n; i++)
+                          copy(ctx.old(static_cast<int>(i)), ch.old_values);
+                      }
+                      if (op != SQLITE_DELETE)
+                      {
+                        ch.new_values.reserve(n);
+                        for (std::size_t i = 0u; i < n; i++)
+                          copy(ctx.new_(static_cast<int>(i)), ch.new_values);
+                      }
+                      b.changes.push_back(std::move(ch));
+                    });
+    }
+  } preupdate{this};
+#endif
+
+  struct on_commit
+  {
+    connection_state * state;
+    bool operator()() noexcept
+    {
+      state->owner.publish(*state);
+      return false;
+    }
+  } commit{this};
+
+  struct on_rollback
+  {
+    connection_state * state;
+    void operator()() noexcept
+    {
+      if (state->pending)
+        state->pending->changes.clear();
+      state->failed = false;
+    }
+  } rollback{this};
+
+  connection_state(change_capture & owner, sqlite3 * db) : owner(owner), db(db) {}
+};
+
+change_capture::change_capture(std::size_t capacity)
+{
+  std::size_t sz = 2u;
+  while (sz < capacity)
+    sz *= 2u;
+  cells_.reset(new cell[sz]);
+  for (std::size_t i = 0u; i < sz; i++)
+    cells_[i].seq.store(i, std::memory_order_relaxed);
+  mask_ = sz - 1u;
+}
+
+change_capture::~change_capture()
+{
+  change_batch batch;
+  while (try_pop(batch))
+    ;
+}
+
+void change_capture::publish(connection_state & state) noexcept
+{
+  const bool any = state.pending && !state.pending->changes.empty();
+  if (!any && !state.failed)
+    return;
+
+  const auto seq = sequence_.fetch_add(1u, std::memory_order_relaxed);
+  if (!state.failed)
+  {
+    state.pending->sequence = seq;
+    if (push(state.pending))
+      return;
+  }
+
+  dropped_.fetch_add(1u, std::memory_order_relaxed);
+  if (state.pending)
+    state.pending->changes.clear();
+  state.failed = false;
+}
+
+bool change_capture::push(std::unique_ptr<change_batch> & batch) noexcept
+{
+  auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+  cell * c;
+  while (true)
+  {
+    c = &cells_[pos & mask_];
+    const auto seq = c->seq.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+    if (diff == 0)
+    {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed))
+        break;
+    }
+    else if (diff < 0) // full
+      return false;
+    else
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+  }
+  c->data = batch.release();
+  c->seq.store(pos + 1u, std::memory_order_release);
+  return true;
+}
+
+bool change_capture::try_pop(change_batch & batch)
+{
+  auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+  cell * c;
+  while (true)
+  {
+    c = &cells_[pos & mask_];
+    const auto seq = c->seq.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1u);
+    if (diff == 0)
+    {
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed))
+        break;
+    }
+    else if (diff < 0) // empty
+      return false;
+    else
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+  }
+  std::unique_ptr<change_batch> data{c->data};
+  c->seq.store(pos + mask_ + 1u, std::memory_order_release);
+  batch = std::move(*data);
+  return true;
+}
+
+void change_capture::attach(connection_ref conn, bool capture_values)
+{
+  detach(conn);
+  std::unique_ptr<connection_state> state{new connection_state(*this, conn.handle())};
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+  if (capture_values)
+    preupdate_hook(conn, state->preupdate);
+  else
+#endif
+    update_hook(conn, state->update);
+  commit_hook(conn, state->commit);
+  rollback_hook(conn, state->rollback);
+  connections_.push_back(std::move(state));
+  boost::ignore_unused(capture_values);
+}
+
+void change_capture::detach(connection_ref conn)
+{
+  const auto itr = std::find_if(connections_.begin(), connections_.end(),
+                                [&](const std::unique_ptr<connection_state> & st) { return st->db == conn.handle(); });
+  if (itr == connections_.end())
+    return;
+
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+  preupdate_hook(conn, nullptr);
+#endif
+  update_hook(conn, nullptr);
+  commit_hook(conn, nullptr);
+  rollback_hook(conn, nullptr);
+  connections_.erase(itr);
+}
+
+BOOST_SQLITE_END_NAMESPACE
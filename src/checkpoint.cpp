@@ -0,0 +1,159 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/checkpoint.hpp>
+#include <boost/sqlite/hooks.hpp>
+#include <boost/sqlite/detail/exception.hpp>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+checkpoint_result wal_checkpoint(connection_ref conn, checkpoint_mode mode, cstring_ref database,
+                                 system::error_code & ec, error_info & ei)
+{
+  checkpoint_result res;
+  const auto cc = sqlite3_wal_checkpoint_v2(conn.handle(), database.c_str(), static_cast<int>(mode),
+                                            &res.log_frames, &res.checkpointed_frames);
+  if (cc != SQLITE_OK)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    ei.set_message(sqlite3_errmsg(conn.handle()));
+  }
+  return res;
+}
+
+checkpoint_result wal_checkpoint(connection_ref conn, checkpoint_mode mode, cstring_ref database)
+{
+  system::error_code ec;
+  error_info ei;
+  auto res = wal_checkpoint(conn, mode, database, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+  return res;
+}
+
+void wal_autocheckpoint(connection_ref conn, int frames, system::error_code & ec, error_info & ei)
+{
+  const auto cc = sqlite3_wal_autocheckpoint(conn.handle(), frames);
+  if (cc != SQLITE_OK)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    ei.set_message(sqlite3_errmsg(conn.handle()));
+  }
+}
+
+void wal_autocheckpoint(connection_ref conn, int frames)
+{
+  system::error_code ec;
+  error_info ei;
+  wal_autocheckpoint(conn, frames, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+void checkpoint_manager::on_wal::operator()(const char *, int pages) noexcept
+{
+  if (pages >= self->options_.passive_frames)
+    self->request();
+}
+
+checkpoint_manager::checkpoint_manager(cstring_ref filename, checkpoint_options options)
+    : options_(options), conn_(filename, SQLITE_OPEN_READWRITE)
+{
+  sqlite3_busy_timeout(conn_.handle(), static_cast<int>(options_.busy_timeout.count()));
+  // the manager's own connection must not run a checkpoint inline either.
+  wal_autocheckpoint(conn_, 0);
+  // a connection only opens the log once it read the database, before that checkpoints do nothing.
+  conn_.execute("pragma schema_version");
+  thread_ = std::thread(&checkpoint_manager::run, this);
+}
+
+checkpoint_manager::~checkpoint_manager()
+{
+  stop();
+}
+
+void checkpoint_manager::attach(connection_ref writer)
+{
+  // the wal hook replaces the one of wal_autocheckpoint, which disables automatic checkpoints.
+  wal_hook(writer, hook_);
+}
+
+void checkpoint_manager::detach(connection_ref writer)
+{
+  // sqlite's default
+  wal_autocheckpoint(writer, 1000);
+}
+
+void checkpoint_manager::request() noexcept
+{
+  {
+    std::lock_guard<std::mutex> l{mtx_};
+    requested_ = true;
+  }
+  cv_.notify_one();
+}
+
+void checkpoint_manager::stop() noexcept
+{
+  {
+    std::lock_guard<std::mutex> l{mtx_};
+    stopped_ = true;
+  }
+  cv_.notify_one();
+  if (thread_.joinable())
+    thread_.join();
+}
+
+checkpoint_metrics checkpoint_manager::metrics() const noexcept
+{
+  checkpoint_metrics res;
+  res.passive = passive_.load(std::memory_order_relaxed);
+  res.restart = restart_.load(std::memory_order_relaxed);
+  res.truncate = truncate_.load(std::memory_order_relaxed);
+  res.failed = failed_.load(std::memory_order_relaxed);
+  res.log_frames = log_frames_.load(std::memory_order_relaxed);
+  res.checkpointed_frames = checkpointed_frames_.load(std::memory_order_relaxed);
+  return res;
+}
+
+void checkpoint_manager::checkpoint(checkpoint_mode mode, std::atomic<std::uint64_t> & counter) noexcept
+{
+  system::error_code ec;
+  error_info ei;
+  const auto res = wal_checkpoint(conn_, mode, "main", ec, ei);
+  counter.fetch_add(1u, std::memory_order_relaxed);
+  if (ec)
+    failed_.fetch_add(1u, std::memory_order_relaxed);
+  log_frames_.store(res.log_frames, std::memory_order_relaxed);
+  checkpointed_frames_.store(res.checkpointed_frames, std::memory_order_relaxed);
+}
+
+void checkpoint_manager::run() noexcept
+{
+  std::unique_lock<std::mutex> l{mtx_};
+  while (!stopped_)
+  {
+    const auto woken = [this]{ return requested_ || stopped_; };
+    if (options_.interval.count() > 0)
+      cv_.wait_for(l, options_.interval, woken);
+    else
+      cv_.wait(l, woken);
+    if (stopped_)
+      break;
+    requested_ = false;
+    l.unlock();
+
+    checkpoint(checkpoint_mode::passive, passive_);
+    const auto frames = log_frames_.load(std::memory_order_relaxed);
+    if (frames >= options_.truncate_frames)
+      checkpoint(checkpoint_mode::truncate, truncate_);
+    else if (frames >= options_.restart_frames)
+      checkpoint(checkpoint_mode::restart, restart_);
+
+    l.lock();
+  }
+}
+
+BOOST_SQLITE_END_NAMESPACE
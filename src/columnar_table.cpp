@@ -0,0 +1,342 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/columnar_table.hpp>
+#include <boost/sqlite/container_table.hpp>
+#include <boost/sqlite/detail/exception.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+namespace vtab
+{
+
+void column_store::add_column(std::string name, std::vector<sqlite3_int64> data)
+{
+  const auto sz = data.size();
+  add_column_impl(std::move(name), std::move(data), sz);
+}
+
+void column_store::add_column(std::string name, std::vector<double> data)
+{
+  const auto sz = data.size();
+  add_column_impl(std::move(name), std::move(data), sz);
+}
+
+void column_store::add_column(std::string name, std::vector<std::string> data)
+{
+  const auto sz = data.size();
+  add_column_impl(std::move(name), std::move(data), sz);
+}
+
+void column_store::add_column_impl(std::string name, column_data data, std::size_t size)
+{
+  if (!columns_.empty() && size != size_)
+    detail::throw_invalid_argument("column size mismatch", BOOST_CURRENT_LOCATION);
+  if (size > (std::numeric_limits<std::uint32_t>::max)())
+    detail::throw_invalid_argument("too many rows", BOOST_CURRENT_LOCATION);
+  columns_.push_back({std::move(name), std::move(data)});
+  size_ = size;
+}
+
+namespace
+{
+
+// The kernels run over a whole column & a byte mask without branches,
+// so that the compiler can vectorize them.
+template<typename T, typename Op>
+void compare_kernel(const T * data, std::uint8_t * mask, std::size_t n, T rhs, Op op)
+{
+  for (std::size_t i = 0u; i < n; i++)
+    mask[i] &= static_cast<std::uint8_t>(op(data[i], rhs));
+}
+
+void range_kernel(const sqlite3_int64 * data, std::uint8_t * mask, std::size_t n, sqlite3_int64 lo, sqlite3_int64 hi)
+{
+  for (std::size_t i = 0u; i < n; i++)
+    mask[i] &= static_cast<std::uint8_t>((data[i] >= lo) & (data[i] <= hi));
+}
+
+template<typename T>
+void in_kernel(const T * data, std::uint8_t * mask, std::size_t n, std::vector<T> & set)
+{
+  std::sort(set.begin(), set.end());
+  set.erase(std::unique(set.begin(), set.end()), set.end());
+  if (set.empty())
+    return void(std::fill_n(mask, n, std::uint8_t(0)));
+
+  if (set.size() <= 8u)
+    for (std::size_t i = 0u; i < n; i++)
+    {
+      std::uint8_t hit = 0u;
+      for (auto v : set)
+        hit |= static_cast<std::uint8_t>(data[i] == v);
+      mask[i] &= hit;
+    }
+  else
+    for (std::size_t i = 0u; i < n; i++)
+      if (mask[i])
+        mask[i] = std::binary_search(set.begin(), set.end(), data[i]);
+}
+
+// ops as encoded in the index string.
+constexpr char op_eq = '=', op_lt = '<', op_le = 'l', op_gt = '>', op_ge = 'g', op_in = 'i',
+               op_limit = 'L', op_offset = 'O';
+
+void apply_constraint(const std::vector<sqlite3_int64> & col, std::uint8_t * mask, char op, value v)
+{
+  const auto n = col.size();
+#if SQLITE_VERSION_NUMBER >= 3038000
+  if (op == op_in)
+  {
+    std::vector<sqlite3_int64> set;
+    for (auto & e : in(v))
+    {
+      sqlite3_int64 id;
+      if (detail::container_rowid_eq(e, id))
+        set.push_back(id);
+    }
+    return in_kernel(col.data(), mask, n, set);
+  }
+#endif
+
+  // integer columns compare against inclusive bounds, with the conversion rules of rowid constraints.
+  auto lo = (std::numeric_limits<sqlite3_int64>::min)();
+  auto hi = (std::numeric_limits<sqlite3_int64>::max)();
+  bool any = true;
+  switch (op)
+  {
+    case op_eq: any = detail::container_rowid_eq(v, lo); hi = lo; break;
+    case op_lt: any = detail::container_rowid_upper(v, true,  hi); break;
+    case op_le: any = detail::container_rowid_upper(v, false, hi); break;
+    case op_gt: any = detail::container_rowid_lower(v, true,  lo); break;
+    case op_ge: any = detail::container_rowid_lower(v, false, lo); break;
+    default: break;
+  }
+  if (!any)
+    return void(std::fill_n(mask, n, std::uint8_t(0)));
+  if (lo != (std::numeric_limits<sqlite3_int64>::min)() || hi != (std::numeric_limits<sqlite3_int64>::max)())
+    range_kernel(col.data(), mask, n, lo, hi);
+}
+
+void apply_constraint(const std::vector<double> & col, std::uint8_t * mask, char op, value v)
+{
+  const auto n = col.size();
+#if SQLITE_VERSION_NUMBER >= 3038000
+  if (op == op_in)
+  {
+    std::vector<double> set;
+    for (auto & e : in(v))
+    {
+      const auto tp = sqlite3_value_numeric_type(e.handle());
+      if (tp == SQLITE_INTEGER || tp == SQLITE_FLOAT)
+        set.push_back(e.get_double());
+    }
+    return in_kernel(col.data(), mask, n, set);
+  }
+#endif
+
+  switch (sqlite3_value_numeric_type(v.handle()))
+  {
+    case SQLITE_INTEGER: BOOST_FALLTHROUGH;
+    case SQLITE_FLOAT:
+      break;
+    case SQLITE_NULL:
+      return void(std::fill_n(mask, n, std::uint8_t(0)));
+    default: // numbers compare lower than text & blobs
+      if (op != op_lt && op != op_le)
+        std::fill_n(mask, n, std::uint8_t(0));
+      return;
+  }
+
+  const auto rhs = v.get_double();
+  switch (op)
+  {
+    case op_eq: return compare_kernel(col.data(), mask, n, rhs, [](double l, double r) {return l == r;});
+    case op_lt: return compare_kernel(col.data(), mask, n, rhs, [](double l, double r) {return l <  r;});
+    case op_le: return compare_kernel(col.data(), mask, n, rhs, [](double l, double r) {return l <= r;});
+    case op_gt: return compare_kernel(col.data(), mask, n, rhs, [](double l, double r) {return l >  r;});
+    case op_ge: return compare_kernel(col.data(), mask, n, rhs, [](double l, double r) {return l >= r;});
+    default: break;
+  }
+}
+
+void apply_constraint(const std::vector<std::string> &, std::uint8_t *, char, value)
+{
+  // text constraints are never claimed by best_index
+  BOOST_ASSERT(false);
+}
+
+}
+
+result<void> columnar_cursor::filter(int index, const char * index_data, span<sqlite::value> values)
+{
+  const auto n = store_->size();
+  pos_ = 0u;
+  end_ = n;
+  filtered_ = false;
+  if (index == 0 || index_data == nullptr)
+    return {};
+
+  auto limit  = (std::numeric_limits<std::size_t>::max)();
+  auto offset = std::size_t(0u);
+
+  auto arg = values.begin();
+  for (auto p = index_data; *p != '\0';)
+  {
+    BOOST_ASSERT(arg != values.end());
+    const auto v = *arg++;
+    if (*p == op_limit || *p == op_offset)
+    {
+      // negative limits mean no limit
+      const auto i = v.get_int();
+      if (i >= 0)
+        (*p == op_limit ? limit : offset) = static_cast<std::size_t>(i);
+      p++;
+      continue;
+    }
+
+    char * end;
+    const auto col = static_cast<std::size_t>(std::strtoul(p, &end, 10));
+    const auto op = *end;
+    p = end + 1;
+    if (!filtered_)
+      mask_.assign(n, 1u);
+    filtered_ = true;
+    visit([&](const auto & data) { apply_constraint(data, mask_.data(), op, v); },
+          store_->column(col));
+  }
+
+  const auto wanted = limit > n - (std::min)(offset, n) ? n : offset + limit;
+  if (!filtered_)
+  {
+    pos_ = (std::min)(offset, n);
+    end_ = wanted;
+    return {};
+  }
+
+  // compress the mask into the selection vector, until the limit is reached.
+  selection_.resize(n);
+  std::size_t cnt = 0u;
+  for (std::size_t i = 0u; i < n && cnt < wanted; i++)
+  {
+    selection_[cnt] = static_cast<std::uint32_t>(i);
+    cnt += mask_[i];
+  }
+  selection_.resize(cnt);
+  pos_ = (std::min)(offset, cnt);
+  end_ = cnt;
+  return {};
+}
+
+void columnar_cursor::column(context<> ctx, int idx, bool /* no_change */)
+{
+  const auto row = current();
+  visit([&](const auto & data) { ctx.set_result(data[row]); },
+        store_->column(static_cast<std::size_t>(idx)));
+}
+
+columnar_table::columnar_table(const column_store & store) : store_(&store)
+{
+  declaration_ = "create table x(";
+  for (std::size_t i = 0u; i < store.column_count(); i++)
+  {
+    if (i != 0u)
+      declaration_ += ", ";
+    declaration_ += '"';
+    for (auto c : store.column_name(i))
+    {
+      if (c == '"')
+        declaration_ += '"';
+      declaration_ += c;
+    }
+    declaration_ += '"';
+    const auto & col = store.column(i);
+    declaration_ += col.index() == 0u ? " INTEGER" : col.index() == 1u ? " REAL" : " TEXT";
+  }
+  declaration_ += ");";
+}
+
+result<void> columnar_table::best_index(index_info & info)
+{
+  const auto rows = static_cast<double>(store_->size());
+  std::string plan;
+  double selectivity = 1.;
+
+  for (auto & ct : info.constraints())
+  {
+    if (!ct.usable || ct.iColumn < 0 || store_->column(static_cast<std::size_t>(ct.iColumn)).index() == 2u)
+      continue;
+
+    char op;
+    switch (ct.op)
+    {
+      case SQLITE_INDEX_CONSTRAINT_EQ:
+#if SQLITE_VERSION_NUMBER >= 3038000
+        if (info.claim_in(ct))
+        {
+          op = op_in;
+          selectivity *= .25;
+          break;
+        }
+#endif
+        op = op_eq;
+        selectivity *= .1;
+        info.claim(ct, true);
+        break;
+      case SQLITE_INDEX_CONSTRAINT_LT: op = op_lt; selectivity *= .25; info.claim(ct, true); break;
+      case SQLITE_INDEX_CONSTRAINT_LE: op = op_le; selectivity *= .25; info.claim(ct, true); break;
+      case SQLITE_INDEX_CONSTRAINT_GT: op = op_gt; selectivity *= .25; info.claim(ct, true); break;
+      case SQLITE_INDEX_CONSTRAINT_GE: op = op_ge; selectivity *= .25; info.claim(ct, true); break;
+      default:
+        continue;
+    }
+
+    plan += std::to_string(ct.iColumn);
+    plan += op;
+  }
+
+  auto estimate = (std::max)(rows * selectivity, 1.);
+#if SQLITE_VERSION_NUMBER >= 3038000
+  const auto lo = info.claim_limit_and_offset();
+  if (lo.first >= 0)
+  {
+    plan += op_limit;
+    auto l = info.rhs_value(info.index_of(*info.limit()));
+    if (l && l->type() == value_type::integer && l->get_int() >= 0)
+      estimate = (std::min)(estimate, static_cast<double>(l->get_int()));
+  }
+  if (lo.second >= 0)
+    plan += op_offset;
+#endif
+
+  if (plan.empty())
+  {
+    info.set_index(0);
+    info.set_estimated_cost((std::max)(rows, 1.));
+#if SQLITE_VERSION_NUMBER >= 3008200
+    info.set_estimated_rows(static_cast<sqlite3_int64>(rows));
+#endif
+    return {};
+  }
+
+  auto str = sqlite3_mprintf("%s", plan.c_str());
+  if (str == nullptr)
+    return error(SQLITE_NOMEM);
+  info.set_index(1);
+  info.set_index_string(str);
+
+  // the kernels are much cheaper per row than handing a row to sqlite.
+  info.set_estimated_cost(rows * .05 + estimate);
+#if SQLITE_VERSION_NUMBER >= 3008200
+  info.set_estimated_rows(static_cast<sqlite3_int64>(estimate));
+#endif
+  return {};
+}
+
+}
+BOOST_SQLITE_END_NAMESPACE
@@ -29,7 +29,10 @@ void connection::connect(cstring_ref filename, int flags, system::error_code & e
     if (r != SQLITE_OK)
         BOOST_SQLITE_ASSIGN_EC(ec, r);
     else
+    {
+      control_.reset();
       impl_.reset(res);
+    }
     sqlite3_extended_result_codes(impl_.get(), true);
 }
 
@@ -47,6 +50,7 @@ void connection::close(system::error_code & ec,
 {
     if (impl_)
     {
+        control_.reset();
         auto tmp = impl_.release();
         auto cc = sqlite3_close(tmp);
         if (SQLITE_OK != cc)
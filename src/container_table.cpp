@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/container_table.hpp>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+namespace detail
+{
+
+namespace
+{
+
+constexpr double int64_min = -9223372036854775808.;
+constexpr double int64_max =  9223372036854775808.; // exclusive
+
+// integers compare lower than text & blobs, NULL matches nothing.
+enum class rowid_operand { integer, floating, null, greater };
+
+rowid_operand classify(value & v)
+{
+  switch (sqlite3_value_numeric_type(v.handle()))
+  {
+    case SQLITE_INTEGER: return rowid_operand::integer;
+    case SQLITE_FLOAT:   return rowid_operand::floating;
+    case SQLITE_NULL:    return rowid_operand::null;
+    default:             return rowid_operand::greater;
+  }
+}
+
+}
+
+bool container_rowid_eq(value v, sqlite3_int64 & id)
+{
+  switch (classify(v))
+  {
+    case rowid_operand::integer:
+      id = v.get_int();
+      return true;
+    case rowid_operand::floating:
+    {
+      const auto d = v.get_double();
+      if (d < int64_min || d >= int64_max || std::trunc(d) != d)
+        return false;
+      id = static_cast<sqlite3_int64>(d);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+bool container_rowid_lower(value v, bool strict, sqlite3_int64 & lo)
+{
+  switch (classify(v))
+  {
+    case rowid_operand::integer:
+      lo = v.get_int();
+      if (!strict)
+        return true;
+      if (lo == (std::numeric_limits<sqlite3_int64>::max)())
+        return false;
+      lo++;
+      return true;
+    case rowid_operand::floating:
+    {
+      const auto d = strict ? std::floor(v.get_double()) + 1. : std::ceil(v.get_double());
+      if (d >= int64_max)
+        return false;
+      lo = d < int64_min ? (std::numeric_limits<sqlite3_int64>::min)() : static_cast<sqlite3_int64>(d);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+bool container_rowid_upper(value v, bool strict, sqlite3_int64 & hi)
+{
+  switch (classify(v))
+  {
+    case rowid_operand::integer:
+      hi = v.get_int();
+      if (!strict)
+        return true;
+      if (hi == (std::numeric_limits<sqlite3_int64>::min)())
+        return false;
+      hi--;
+      return true;
+    case rowid_operand::floating:
+    {
+      const auto d = strict ? std::ceil(v.get_double()) - 1. : std::floor(v.get_double());
+      if (d < int64_min)
+        return false;
+      hi = d >= int64_max ? (std::numeric_limits<sqlite3_int64>::max)() : static_cast<sqlite3_int64>(d);
+      return true;
+    }
+    case rowid_operand::greater:
+      hi = (std::numeric_limits<sqlite3_int64>::max)();
+      return true;
+    default:
+      return false;
+  }
+}
+
+}
+BOOST_SQLITE_END_NAMESPACE
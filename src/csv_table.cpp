@@ -0,0 +1,792 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/csv_table.hpp>
+#include <boost/sqlite/container_table.hpp>
+#include <boost/sqlite/detail/exception.hpp>
+#include <boost/sqlite/detail/scan.hpp>
+
+#include <boost/core/no_exceptions_support.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <thread>
+
+#if defined(BOOST_WINDOWS_API)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+namespace vtab
+{
+
+namespace
+{
+
+// The bitmasks of quotes & newlines of a block of up to 16 characters.
+struct block_masks
+{
+  std::uint32_t quotes = 0u, newlines = 0u;
+};
+
+constexpr std::size_t block_size = 16u;
+
+block_masks classify(const char * p, std::size_t n, char quote) noexcept
+{
+  block_masks res;
+#if defined(BOOST_SQLITE_SSE2)
+  if (n == block_size)
+  {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    res.quotes   = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(quote))));
+    res.newlines = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n'))));
+    return res;
+  }
+#endif
+  for (std::size_t i = 0u; i < n; i++)
+  {
+    res.quotes   |= static_cast<std::uint32_t>(p[i] == quote) << i;
+    res.newlines |= static_cast<std::uint32_t>(p[i] == '\n')  << i;
+  }
+  return res;
+}
+
+// bit i is set if an odd number of quotes is at or before i, i.e. i is inside a quoted field.
+std::uint32_t prefix_xor(std::uint32_t m) noexcept
+{
+  m ^= m << 1;
+  m ^= m << 2;
+  m ^= m << 4;
+  m ^= m << 8;
+  return m & 0xFFFFu;
+}
+
+// The row ends of a chunk, for both possible quote states at its start.
+struct chunk_count
+{
+  bool odd_quotes = false;
+  std::uint64_t rows[2] = {0u, 0u};
+};
+
+chunk_count count_chunk(const char * p, const char * end, char quote) noexcept
+{
+  chunk_count res;
+  std::uint32_t parity = 0u;
+  while (p != end)
+  {
+    const auto n = (std::min)(block_size, static_cast<std::size_t>(end - p));
+    const auto m = classify(p, n, quote);
+    const auto inside = prefix_xor(m.quotes) ^ parity;
+    res.rows[0] += static_cast<std::uint64_t>(core::popcount(m.newlines & ~inside & 0xFFFFu));
+    res.rows[1] += static_cast<std::uint64_t>(core::popcount(m.newlines &  inside & 0xFFFFu));
+    if (core::popcount(m.quotes) & 1)
+      parity ^= 0xFFFFu;
+    p += n;
+  }
+  res.odd_quotes = parity != 0u;
+  return res;
+}
+
+// Record the offsets of every stride-th row starting in the chunk.
+// `row` is the index of the row that gets started by the next newline.
+void index_chunk(const char * base, const char * p, const char * end, char quote, bool in_quotes,
+                 std::uint64_t row, std::size_t stride, std::vector<std::uint64_t> & offsets)
+{
+  std::uint32_t parity = in_quotes ? 0xFFFFu : 0u;
+  auto next_entry = (row + stride - 1u) / stride * stride;
+  while (p != end)
+  {
+    const auto n = (std::min)(block_size, static_cast<std::size_t>(end - p));
+    const auto m = classify(p, n, quote);
+    auto rows = m.newlines & ~(prefix_xor(m.quotes) ^ parity) & 0xFFFFu;
+    const auto cnt = static_cast<std::uint64_t>(core::popcount(rows));
+    if (row + cnt > next_entry)
+    {
+      for (; rows != 0u; rows &= rows - 1u, row++)
+        if (row == next_entry)
+        {
+          offsets.push_back(static_cast<std::uint64_t>(p - base) + core::countr_zero(rows) + 1u);
+          next_entry += stride;
+        }
+    }
+    else
+      row += cnt;
+
+    if (core::popcount(m.quotes) & 1)
+      parity ^= 0xFFFFu;
+    p += n;
+  }
+}
+
+// Run `func(i)` for every `i` below `n`, all but the first on their own threads.
+// The threads are joined on every path & the first exception gets rethrown afterwards.
+template<typename Func>
+void run_parallel(std::size_t n, Func func)
+{
+  std::vector<std::exception_ptr> errors(n);
+  auto run =
+      [&](std::size_t i)
+      {
+        BOOST_TRY
+        {
+          func(i);
+        }
+        BOOST_CATCH(...)
+        {
+          errors[i] = std::current_exception();
+        }
+        BOOST_CATCH_END
+      };
+
+  std::vector<std::thread> workers;
+  workers.reserve(n - 1u);
+  BOOST_TRY
+  {
+    for (std::size_t i = 1u; i < n; i++)
+      workers.emplace_back(run, i);
+  }
+  BOOST_CATCH(...)
+  {
+    // destroying a joinable thread would terminate.
+    for (auto & w : workers)
+      w.join();
+    BOOST_RETHROW
+  }
+  BOOST_CATCH_END
+
+  run(0u);
+  for (auto & w : workers)
+    w.join();
+  for (auto & e : errors)
+    if (e)
+      std::rethrow_exception(e);
+}
+
+}
+
+csv_file::csv_file(csv_file && lhs) noexcept
+  : data_(lhs.data_), size_(lhs.size_), is_open_(lhs.is_open_),
+#if defined(BOOST_WINDOWS_API)
+    file_(lhs.file_), mapping_(lhs.mapping_),
+#endif
+    options_(lhs.options_), names_(std::move(lhs.names_)), index_(std::move(lhs.index_)), rows_(lhs.rows_)
+{
+  lhs.data_ = nullptr;
+  lhs.size_ = 0u;
+  lhs.is_open_ = false;
+#if defined(BOOST_WINDOWS_API)
+  lhs.file_ = lhs.mapping_ = nullptr;
+#endif
+  lhs.rows_ = 0u;
+}
+
+csv_file& csv_file::operator=(csv_file && lhs) noexcept
+{
+  if (this != &lhs)
+  {
+    close();
+    std::swap(data_, lhs.data_);
+    std::swap(size_, lhs.size_);
+    std::swap(is_open_, lhs.is_open_);
+#if defined(BOOST_WINDOWS_API)
+    std::swap(file_, lhs.file_);
+    std::swap(mapping_, lhs.mapping_);
+#endif
+    options_ = lhs.options_;
+    names_ = std::move(lhs.names_);
+    index_ = std::move(lhs.index_);
+    std::swap(rows_, lhs.rows_);
+  }
+  return *this;
+}
+
+csv_file::~csv_file()
+{
+  close();
+}
+
+void csv_file::close() noexcept
+{
+#if defined(BOOST_WINDOWS_API)
+  if (data_)
+    UnmapViewOfFile(data_);
+  if (mapping_)
+    CloseHandle(mapping_);
+  if (file_)
+    CloseHandle(file_);
+  file_ = mapping_ = nullptr;
+#else
+  if (data_)
+    ::munmap(const_cast<char*>(data_), size_);
+#endif
+  data_ = nullptr;
+  size_ = 0u;
+  is_open_ = false;
+  names_.clear();
+  index_.clear();
+  rows_ = 0u;
+}
+
+void csv_file::open(cstring_ref path, const csv_options & options,
+                    system::error_code & ec, error_info & ei)
+{
+  close();
+  if (options.delimiter == '\n' || options.quote == '\n' || options.delimiter == options.quote)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_MISUSE);
+    ei.set_message("invalid csv delimiter or quote");
+    return;
+  }
+  options_ = options;
+  if (options_.index_stride == 0u)
+    options_.index_stride = 1u;
+
+#if defined(BOOST_WINDOWS_API)
+  file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file_ == INVALID_HANDLE_VALUE)
+  {
+    file_ = nullptr;
+    BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_CANTOPEN);
+    ei.format("cannot open %s", path.c_str());
+    return;
+  }
+  LARGE_INTEGER sz;
+  if (!GetFileSizeEx(file_, &sz))
+  {
+    close();
+    BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_IOERR);
+    ei.format("cannot read the size of %s", path.c_str());
+    return;
+  }
+  size_ = static_cast<std::size_t>(sz.QuadPart);
+  if (size_ != 0u)
+  {
+    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_)
+      data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (!data_)
+    {
+      close();
+      BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_IOERR);
+      ei.format("cannot map %s", path.c_str());
+      return;
+    }
+  }
+#else
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_CANTOPEN);
+    ei.format("cannot open %s", path.c_str());
+    return;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0)
+  {
+    ::close(fd);
+    BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_IOERR);
+    ei.format("cannot read the size of %s", path.c_str());
+    return;
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+  if (size_ != 0u)
+  {
+    auto p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED)
+    {
+      ::close(fd);
+      size_ = 0u;
+      BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_IOERR);
+      ei.format("cannot map %s", path.c_str());
+      return;
+    }
+    data_ = static_cast<const char*>(p);
+  }
+  // the mapping keeps the file alive
+  ::close(fd);
+#endif
+
+  is_open_ = true;
+  BOOST_TRY
+  {
+    build_index();
+  }
+  BOOST_CATCH(...)
+  {
+    close();
+    BOOST_RETHROW
+  }
+  BOOST_CATCH_END
+}
+
+void csv_file::open(cstring_ref path, const csv_options & options)
+{
+  system::error_code ec;
+  error_info ei;
+  open(path, options, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+void csv_file::build_index()
+{
+  const char * p = data_;
+  const char * const e = end();
+  // skip a utf-8 byte order mark
+  if (size_ >= 3u && std::memcmp(p, "\xEF\xBB\xBF", 3u) == 0)
+    p += 3;
+
+  rows_ = 0u;
+  index_.clear();
+  if (p == e)
+    return;
+
+  std::vector<csv_field> fields;
+  std::string buf;
+  const auto first = split_row(p, (std::numeric_limits<std::size_t>::max)(), fields);
+  for (std::size_t i = 0u; i < fields.size(); i++)
+    names_.push_back(options_.header ? std::string(decode(fields[i], buf)) : "c" + std::to_string(i));
+  if (options_.header)
+    p = first;
+  if (p == e)
+    return;
+
+  const auto base = static_cast<std::uint64_t>(p - data_);
+  index_.push_back(base);
+  const auto stride = options_.index_stride;
+  const auto total = static_cast<std::size_t>(e - p);
+
+  std::size_t threads = options_.threads == 0u ? std::thread::hardware_concurrency() : options_.threads;
+  if (total < options_.parallel_threshold || threads < 2u)
+    threads = 1u;
+  // chunks below 64KiB aren't worth a thread
+  threads = (std::min)(threads, (std::max)(total / (64u << 10u), std::size_t(1u)));
+
+  std::uint64_t newlines = 0u;
+  if (threads == 1u)
+  {
+    newlines = count_chunk(p, e, options_.quote).rows[0];
+    index_chunk(data_, p, e, options_.quote, false, 1u, stride, index_);
+  }
+  else
+  {
+    // first pass: count the quotes & rows of every chunk in parallel,
+    // then the quote state at the start of every chunk is known & the second pass records the offsets.
+    const auto chunk_size = total / threads;
+    std::vector<const char *> bounds(threads + 1u);
+    for (std::size_t i = 0u; i < threads; i++)
+      bounds[i] = p + i * chunk_size;
+    bounds[threads] = e;
+
+    std::vector<chunk_count> counts(threads);
+    run_parallel(threads, [&](std::size_t i){ counts[i] = count_chunk(bounds[i], bounds[i + 1u], options_.quote); });
+
+    std::vector<bool> in_quotes(threads);
+    std::vector<std::uint64_t> first_row(threads);
+    bool quoted = false;
+    std::uint64_t row = 1u;
+    for (std::size_t i = 0u; i < threads; i++)
+    {
+      in_quotes[i] = quoted;
+      first_row[i] = row;
+      row += counts[i].rows[quoted ? 1 : 0];
+      quoted ^= counts[i].odd_quotes;
+    }
+    newlines = row - 1u;
+
+    std::vector<std::vector<std::uint64_t>> offsets(threads);
+    run_parallel(
+        threads,
+        [&](std::size_t i)
+        {
+          index_chunk(data_, bounds[i], bounds[i + 1u], options_.quote, in_quotes[i], first_row[i], stride, offsets[i]);
+        });
+    for (auto & o : offsets)
+      index_.insert(index_.end(), o.begin(), o.end());
+  }
+
+  // a trailing newline doesn't start a row
+  rows_ = static_cast<std::size_t>(newlines) + (e[-1] == '\n' ? 0u : 1u);
+  while (!index_.empty() && index_.back() >= size_)
+    index_.pop_back();
+}
+
+const char * csv_file::row_begin(std::size_t idx) const noexcept
+{
+  BOOST_ASSERT(idx < rows_);
+  const auto stride = options_.index_stride;
+  const char * p = data_ + index_[idx / stride];
+  for (auto i = idx % stride; i != 0u; i--)
+    p = skip_row(p);
+  return p;
+}
+
+const char * csv_file::skip_row(const char * row) const noexcept
+{
+  const auto e = end();
+  bool in_quotes = false;
+  for (auto p = row; ; p++)
+  {
+    p = detail::find_any(p, e, options_.quote, '\n', '\n', '\n');
+    if (p == e)
+      return e;
+    if (*p == '\n')
+    {
+      if (!in_quotes)
+        return p + 1;
+    }
+    else
+      in_quotes = !in_quotes;
+  }
+}
+
+const char * csv_file::split_row(const char * row, std::size_t count, std::vector<csv_field> & fields) const
+{
+  const auto e = end();
+  const auto quote = options_.quote, delim = options_.delimiter;
+  fields.clear();
+  auto p = row;
+  while (true)
+  {
+    if (fields.size() == count)
+      return skip_row(p);
+
+    csv_field f;
+    if (p != e && *p == quote)
+    {
+      f.begin = ++p;
+      while (true)
+      {
+        p = std::find(p, e, quote);
+        if (p == e || p + 1 == e || p[1] != quote)
+          break;
+        f.escaped = true;
+        p += 2;
+      }
+      f.end = p;
+      if (p != e)
+        p++;
+      // characters after the closing quote are ignored
+      p = detail::find_any(p, e, delim, '\n', '\n', '\n');
+    }
+    else
+    {
+      f.begin = p;
+      p = detail::find_any(p, e, delim, '\n', '\n', '\n');
+      f.end = p;
+      if (f.end != f.begin && f.end[-1] == '\r' && (p == e || *p == '\n'))
+        f.end--;
+    }
+    fields.push_back(f);
+
+    if (p == e)
+      return e;
+    if (*p++ == '\n')
+      return p;
+  }
+}
+
+string_view csv_file::decode(const csv_field & field, std::string & buffer) const
+{
+  if (!field.escaped)
+    return string_view(field.begin, static_cast<std::size_t>(field.end - field.begin));
+
+  buffer.clear();
+  for (auto p = field.begin; p != field.end; p++)
+  {
+    buffer += *p;
+    if (*p == options_.quote && p + 1 != field.end)
+      p++;
+  }
+  return buffer;
+}
+
+result<void> csv_cursor::filter(int index, const char * index_data, span<sqlite::value> values)
+{
+  row_ = 0u;
+  end_row_ = file_->size();
+
+  // the index string holds the used columns, see csv_table::best_index
+  split_count_ = file_->column_count();
+  if (index_data != nullptr)
+  {
+    const auto used = std::strtoull(index_data, nullptr, 16);
+    split_count_ = (used & (1ull << 63u)) != 0u
+        ? file_->column_count()
+        : static_cast<std::size_t>(64 - core::countl_zero(static_cast<std::uint64_t>(used)));
+  }
+
+  auto arg = values.begin();
+  sqlite3_int64 lo = 1, hi = static_cast<sqlite3_int64>(end_row_);
+  bool any = true;
+  if (index & detail::container_index_eq)
+  {
+    any = detail::container_rowid_eq(*arg++, lo);
+    hi = lo;
+  }
+  if (index & detail::container_index_lower)
+  {
+    // not written if the operand can't match, e.g. null.
+    sqlite3_int64 l = lo;
+    any = detail::container_rowid_lower(*arg++, (index & detail::container_index_lower_strict) != 0, l) && any;
+    lo = (std::max)(lo, l);
+  }
+  if (index & detail::container_index_upper)
+  {
+    sqlite3_int64 h = hi;
+    any = detail::container_rowid_upper(*arg++, (index & detail::container_index_upper_strict) != 0, h) && any;
+    hi = (std::min)(hi, h);
+  }
+
+  lo = (std::max)(lo, sqlite3_int64(1));
+  hi = (std::min)(hi, static_cast<sqlite3_int64>(end_row_));
+  if (!any || lo > hi)
+  {
+    end_row_ = 0u;
+    return {};
+  }
+  row_ = static_cast<std::size_t>(lo - 1);
+  end_row_ = static_cast<std::size_t>(hi);
+  next_ = file_->row_begin(row_);
+  load();
+  return {};
+}
+
+result<void> csv_cursor::next()
+{
+  if (++row_ < end_row_)
+    load();
+  return {};
+}
+
+void csv_cursor::load()
+{
+  const auto row = next_;
+  if (split_count_ == 0u)
+  {
+    fields_.clear();
+    next_ = file_->skip_row(row);
+  }
+  else
+    next_ = file_->split_row(row, split_count_, fields_);
+}
+
+void csv_cursor::column(context<> ctx, int idx, bool /* no_change */)
+{
+  const auto i = static_cast<std::size_t>(idx);
+  if (i >= split_count_)
+  {
+    // sqlite asked for a column it didn't announce in best_index.
+    split_count_ = file_->column_count();
+    std::vector<csv_field> fields;
+    const char * row = file_->row_begin(row_);
+    file_->split_row(row, split_count_, fields);
+    fields_ = std::move(fields);
+  }
+  if (i < fields_.size())
+    ctx.set_result(file_->decode(fields_[i], buffer_));
+}
+
+csv_table::csv_table(csv_file file) : file_(std::move(file))
+{
+  declaration_ = "create table x(";
+  for (std::size_t i = 0u; i < file_.column_count(); i++)
+  {
+    if (i != 0u)
+      declaration_ += ", ";
+    declaration_ += '"';
+    for (auto c : file_.column_name(i))
+    {
+      if (c == '"')
+        declaration_ += '"';
+      declaration_ += c;
+    }
+    declaration_ += '"';
+  }
+  if (file_.column_count() == 0u)
+    declaration_ += "c0";
+  declaration_ += ");";
+}
+
+result<void> csv_table::best_index(index_info & info)
+{
+  const auto rows = static_cast<double>(file_.size());
+  const sqlite3_index_info::sqlite3_index_constraint * eq = nullptr, * lower = nullptr, * upper = nullptr;
+  for (auto & ct : info.constraints())
+  {
+    if (!ct.usable || ct.iColumn != -1)
+      continue;
+    switch (ct.op)
+    {
+      case SQLITE_INDEX_CONSTRAINT_EQ:
+        if (!eq) eq = &ct;
+        break;
+      case SQLITE_INDEX_CONSTRAINT_GT: BOOST_FALLTHROUGH;
+      case SQLITE_INDEX_CONSTRAINT_GE:
+        if (!lower) lower = &ct;
+        break;
+      case SQLITE_INDEX_CONSTRAINT_LT: BOOST_FALLTHROUGH;
+      case SQLITE_INDEX_CONSTRAINT_LE:
+        if (!upper) upper = &ct;
+        break;
+      default:
+        break;
+    }
+  }
+
+  // sqlite still checks the constraints, so non-integral operands keep their usual semantics.
+  int index = 0;
+  double estimate = rows;
+  if (eq)
+  {
+    index = detail::container_index_eq;
+    info.claim(*eq);
+    estimate = 1.;
+#if SQLITE_VERSION_NUMBER >= 3009000
+    info.set_index_scan_flags(SQLITE_INDEX_SCAN_UNIQUE);
+#endif
+  }
+  else
+  {
+    if (lower)
+    {
+      index |= detail::container_index_lower;
+      if (lower->op == SQLITE_INDEX_CONSTRAINT_GT)
+        index |= detail::container_index_lower_strict;
+      info.claim(*lower);
+      estimate /= 4.;
+    }
+    if (upper)
+    {
+      index |= detail::container_index_upper;
+      if (upper->op == SQLITE_INDEX_CONSTRAINT_LT)
+        index |= detail::container_index_upper_strict;
+      info.claim(*upper);
+      estimate /= 4.;
+    }
+  }
+
+  const auto order_by = info.order_by();
+  if (order_by.size() == 1u && order_by[0].iColumn == -1 && !order_by[0].desc)
+    info.set_already_ordered();
+
+#if SQLITE_VERSION_NUMBER >= 3010000
+  // only split as many fields as the statement reads.
+  const auto used = info.columns_used().to_ullong();
+  auto str = sqlite3_mprintf("%llx", static_cast<unsigned long long>(used));
+  if (str == nullptr)
+    return error(SQLITE_NOMEM);
+  info.set_index_string(str);
+#endif
+
+  // positioning the cursor scans up to index_stride rows.
+  const auto seek = static_cast<double>(file_.options().index_stride) / 2.;
+  estimate = (std::max)(estimate, 1.);
+  info.set_index(index);
+  info.set_estimated_cost(index == 0 ? (std::max)(rows, 1.) : seek + estimate);
+#if SQLITE_VERSION_NUMBER >= 3008200
+  info.set_estimated_rows(static_cast<sqlite3_int64>(index == 0 ? rows : estimate));
+#endif
+  return {};
+}
+
+namespace
+{
+
+string_view unquote(string_view s)
+{
+  while (!s.empty() && (s.front() == ' ' || s.front() == '\t'))
+    s.remove_prefix(1u);
+  while (!s.empty() && (s.back() == ' ' || s.back() == '\t'))
+    s.remove_suffix(1u);
+  if (s.size() >= 2u && (s.front() == '\'' || s.front() == '"') && s.back() == s.front())
+    s = s.substr(1u, s.size() - 2u);
+  return s;
+}
+
+result<csv_table> make_csv_table(csv_options options, int argc, const char * const argv[])
+{
+  std::string filename;
+  // argv[0..2] are the module, database & table names.
+  for (int i = 3; i < argc; i++)
+  {
+    const string_view arg = argv[i];
+    const auto eq = arg.find('=');
+    if (eq == string_view::npos)
+    {
+      if (!filename.empty())
+        return error(SQLITE_ERROR, "csv: more than one filename");
+      filename = std::string(unquote(arg));
+      continue;
+    }
+
+    const auto key = unquote(arg.substr(0u, eq));
+    const auto val = unquote(arg.substr(eq + 1u));
+    if (key == "filename")
+      filename = std::string(val);
+    else if (key == "header")
+    {
+      if (val == "yes" || val == "true" || val == "1")
+        options.header = true;
+      else if (val == "no" || val == "false" || val == "0")
+        options.header = false;
+      else
+        return error(SQLITE_ERROR, "csv: header must be yes or no");
+    }
+    else if (key == "delimiter" || key == "quote")
+    {
+      char c;
+      if (val == "tab" || val == "\\t")
+        c = '\t';
+      else if (val.size() == 1u)
+        c = val.front();
+      else
+        return error(SQLITE_ERROR, "csv: delimiter & quote must be a single character");
+      (key == "delimiter" ? options.delimiter : options.quote) = c;
+    }
+    else if (key == "threads")
+      options.threads = static_cast<std::size_t>(std::strtoul(std::string(val).c_str(), nullptr, 10));
+    else
+    {
+      error_info ei;
+      ei.format("csv: unknown argument %.*s", static_cast<int>(key.size()), key.data());
+      return error(SQLITE_ERROR, std::move(ei));
+    }
+  }
+
+  if (filename.empty())
+    return error(SQLITE_ERROR, "csv: missing filename");
+
+  system::error_code ec;
+  error_info ei;
+  csv_file file;
+  file.open(filename, options, ec, ei);
+  if (ec)
+    return error(ec, std::move(ei));
+  return csv_table{std::move(file)};
+}
+
+}
+
+result<csv_table> csv_module::create(connection_ref, int argc, const char * const argv[])
+{
+  return make_csv_table(options_, argc, argv);
+}
+
+result<csv_table> csv_module::connect(connection_ref, int argc, const char * const argv[])
+{
+  return make_csv_table(options_, argc, argv);
+}
+
+}
+BOOST_SQLITE_END_NAMESPACE
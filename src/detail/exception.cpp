@@ -23,7 +23,11 @@ void throw_error_code(const boost::system::error_code & ec,
                       const error_info & ei,
                       const boost::source_location & loc)
 {
-  boost::throw_exception(system::system_error(ec, ei.message()),
+  // the message might be taken lazily from the connection, so it's copied only once, into the exception.
+  const auto msg = ei.message();
+  if (msg.empty())
+    throw_error_code(ec, loc);
+  boost::throw_exception(system::system_error(ec, msg.c_str()),
                          ec.has_location() ? ec.location() : loc);
 }
 
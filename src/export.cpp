@@ -0,0 +1,397 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/export.hpp>
+#include <boost/sqlite/detail/scan.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__has_include)
+# if __has_include(<charconv>) && __cplusplus >= 201703L
+#  include <charconv>
+# endif
+#endif
+
+#if defined(BOOST_WINDOWS_API)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace
+{
+
+constexpr char digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// writes the digits backwards from `end`, two at a time.
+char * format_integer(sqlite3_int64 value, char * end) noexcept
+{
+  const bool negative = value < 0;
+  auto v = negative ? 0u - static_cast<sqlite3_uint64>(value) : static_cast<sqlite3_uint64>(value);
+  while (v >= 100u)
+  {
+    const auto idx = static_cast<std::size_t>(v % 100u) * 2u;
+    v /= 100u;
+    *--end = digit_pairs[idx + 1u];
+    *--end = digit_pairs[idx];
+  }
+  if (v >= 10u)
+  {
+    const auto idx = static_cast<std::size_t>(v) * 2u;
+    *--end = digit_pairs[idx + 1u];
+    *--end = digit_pairs[idx];
+  }
+  else
+    *--end = static_cast<char>('0' + v);
+  if (negative)
+    *--end = '-';
+  return end;
+}
+
+// the shortest representation that reads back to the same value, always marked as a real.
+std::size_t format_double(double value, char * out, std::size_t size) noexcept
+{
+  std::size_t n;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  n = static_cast<std::size_t>(std::to_chars(out, out + size, value).ptr - out);
+#else
+  n = static_cast<std::size_t>(std::snprintf(out, size, "%.15g", value));
+  if (std::strtod(out, nullptr) != value)
+    n = static_cast<std::size_t>(std::snprintf(out, size, "%.17g", value));
+#endif
+  if (std::find_if(out, out + n, [](char c) {return c == '.' || c == 'e';}) == out + n)
+  {
+    out[n++] = '.';
+    out[n++] = '0';
+  }
+  return n;
+}
+
+struct export_writer
+{
+  export_sink sink;
+  const export_options & options;
+  system::error_code & ec;
+  std::string buf;
+
+  export_writer(export_sink sink, const export_options & options, system::error_code & ec)
+      : sink(sink), options(options), ec(ec)
+  {
+    buf.reserve(options.buffer_size + 256u);
+  }
+
+  void flush()
+  {
+    if (!buf.empty() && !ec)
+      sink(buf, ec);
+    buf.clear();
+  }
+
+  void end_row()
+  {
+    buf += '\n';
+    if (buf.size() >= options.buffer_size)
+      flush();
+  }
+
+  void integer(sqlite3_int64 value)
+  {
+    char tmp[24];
+    const auto end = tmp + sizeof(tmp);
+    const auto begin = format_integer(value, end);
+    buf.append(begin, end);
+  }
+
+  void real(double value)
+  {
+    if (std::isinf(value))
+    {
+      // what sqlite uses for infinity in json, which also reads back as a real in csv.
+      buf += value < 0 ? "-9e999" : "9e999";
+      return;
+    }
+    char tmp[40];
+    buf.append(tmp, format_double(value, tmp, sizeof(tmp) - 2u));
+  }
+
+  void blob(const unsigned char * data, std::size_t size)
+  {
+    if (options.blobs == blob_encoding::hex)
+    {
+      constexpr char hex[] = "0123456789abcdef";
+      const auto pos = buf.size();
+      buf.resize(pos + size * 2u);
+      auto out = &buf[pos];
+      for (std::size_t i = 0u; i < size; i++)
+      {
+        *out++ = hex[data[i] >> 4u];
+        *out++ = hex[data[i] & 0xFu];
+      }
+      return;
+    }
+
+    constexpr char b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const auto pos = buf.size();
+    buf.resize(pos + (size + 2u) / 3u * 4u);
+    auto out = &buf[pos];
+    std::size_t i = 0u;
+    for (; i + 3u <= size; i += 3u)
+    {
+      const auto v = (static_cast<std::uint32_t>(data[i]) << 16u) | (static_cast<std::uint32_t>(data[i + 1u]) << 8u) | data[i + 2u];
+      *out++ = b64[(v >> 18u) & 0x3Fu];
+      *out++ = b64[(v >> 12u) & 0x3Fu];
+      *out++ = b64[(v >>  6u) & 0x3Fu];
+      *out++ = b64[ v         & 0x3Fu];
+    }
+    if (i < size)
+    {
+      const auto v = (static_cast<std::uint32_t>(data[i]) << 16u) | (i + 1u < size ? static_cast<std::uint32_t>(data[i + 1u]) << 8u : 0u);
+      *out++ = b64[(v >> 18u) & 0x3Fu];
+      *out++ = b64[(v >> 12u) & 0x3Fu];
+      *out++ = i + 1u < size ? b64[(v >> 6u) & 0x3Fu] : '=';
+      *out++ = '=';
+    }
+  }
+
+  void csv_text(const char * p, std::size_t n)
+  {
+    const auto end = p + n;
+    if (detail::find_any(p, end, options.delimiter, '"', '\n', '\r') == end)
+      return void(buf.append(p, n));
+
+    buf += '"';
+    for (auto q = p; q != end; q = p)
+    {
+      p = std::find(q, end, '"');
+      buf.append(q, p);
+      if (p != end)
+      {
+        buf += "\"\"";
+        p++;
+      }
+    }
+    buf += '"';
+  }
+
+  void tsv_text(const char * p, std::size_t n)
+  {
+    const auto end = p + n;
+    while (p != end)
+    {
+      const auto q = detail::find_any(p, end, '\t', '\n', '\r', '\\');
+      buf.append(p, q);
+      if (q == end)
+        break;
+      buf += '\\';
+      buf += *q == '\t' ? 't' : *q == '\n' ? 'n' : *q == '\r' ? 'r' : '\\';
+      p = q + 1;
+    }
+  }
+
+  void json_text(const char * p, std::size_t n)
+  {
+    const auto end = p + n;
+    buf += '"';
+    while (p != end)
+    {
+      const auto q = detail::find_json_escape(p, end);
+      buf.append(p, q);
+      if (q == end)
+        break;
+      switch (*q)
+      {
+        case '"':  buf += "\\\""; break;
+        case '\\': buf += "\\\\"; break;
+        case '\n': buf += "\\n";  break;
+        case '\r': buf += "\\r";  break;
+        case '\t': buf += "\\t";  break;
+        case '\b': buf += "\\b";  break;
+        case '\f': buf += "\\f";  break;
+        default:
+        {
+          constexpr char hex[] = "0123456789abcdef";
+          const auto c = static_cast<unsigned char>(*q);
+          const char esc[6] = {'\\', 'u', '0', '0', hex[c >> 4u], hex[c & 0xFu]};
+          buf.append(esc, sizeof(esc));
+        }
+      }
+      p = q + 1;
+    }
+    buf += '"';
+  }
+
+  void text(const char * p, std::size_t n)
+  {
+    switch (options.format)
+    {
+      case export_format::csv:    return csv_text(p, n);
+      case export_format::tsv:    return tsv_text(p, n);
+      case export_format::ndjson: return json_text(p, n);
+    }
+  }
+
+  void value(sqlite3_stmt * stmt, int col)
+  {
+    switch (sqlite3_column_type(stmt, col))
+    {
+      case SQLITE_INTEGER: return integer(sqlite3_column_int64(stmt, col));
+      case SQLITE_FLOAT:   return real(sqlite3_column_double(stmt, col));
+      case SQLITE_TEXT:
+      {
+        const auto p = reinterpret_cast<const char*>(sqlite3_column_text(stmt, col));
+        return text(p, static_cast<std::size_t>(sqlite3_column_bytes(stmt, col)));
+      }
+      case SQLITE_BLOB:
+      {
+        const auto p = static_cast<const unsigned char*>(sqlite3_column_blob(stmt, col));
+        const auto n = static_cast<std::size_t>(sqlite3_column_bytes(stmt, col));
+        if (options.format == export_format::ndjson)
+          buf += '"';
+        blob(p, n);
+        if (options.format == export_format::ndjson)
+          buf += '"';
+        return;
+      }
+      default:
+        if (options.format == export_format::ndjson)
+          buf += "null";
+        else if (options.format == export_format::tsv)
+          buf += "\\N";
+    }
+  }
+};
+
+struct fd_sink
+{
+  int fd;
+  void operator()(string_view data, system::error_code & ec) const
+  {
+    while (!data.empty())
+    {
+#if defined(BOOST_WINDOWS_API)
+      const auto n = ::_write(fd, data.data(), static_cast<unsigned>((std::min)(data.size(), std::size_t(1u) << 30u)));
+#else
+      const auto n = ::write(fd, data.data(), data.size());
+#endif
+      if (n < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        ec.assign(errno, system::generic_category());
+        return;
+      }
+      data.remove_prefix(static_cast<std::size_t>(n));
+    }
+  }
+};
+
+}
+
+std::size_t export_rows(statement & stmt, export_sink sink, const export_options & options,
+                        system::error_code & ec, error_info & ei)
+{
+  export_writer w{sink, options, ec};
+  const auto handle = stmt.handle();
+  const int columns = sqlite3_column_count(handle);
+  const char sep = options.format == export_format::tsv ? '\t' : options.delimiter;
+
+  // the json keys are written once per row, so they are escaped upfront.
+  std::vector<std::string> keys;
+  if (options.format == export_format::ndjson)
+  {
+    keys.reserve(static_cast<std::size_t>(columns));
+    for (int i = 0; i < columns; i++)
+    {
+      w.json_text(sqlite3_column_name(handle, i), std::strlen(sqlite3_column_name(handle, i)));
+      w.buf += ':';
+      keys.push_back(std::move(w.buf));
+      w.buf.clear();
+    }
+  }
+  else if (options.header)
+  {
+    for (int i = 0; i < columns; i++)
+    {
+      if (i != 0)
+        w.buf += sep;
+      const auto name = sqlite3_column_name(handle, i);
+      w.text(name, std::strlen(name));
+    }
+    w.end_row();
+  }
+
+  std::size_t rows = 0u;
+  while (!ec && stmt.step(ec, ei))
+  {
+    if (options.format == export_format::ndjson)
+    {
+      w.buf += '{';
+      for (int i = 0; i < columns; i++)
+      {
+        if (i != 0)
+          w.buf += ',';
+        w.buf += keys[static_cast<std::size_t>(i)];
+        w.value(handle, i);
+      }
+      w.buf += '}';
+    }
+    else
+      for (int i = 0; i < columns; i++)
+      {
+        if (i != 0)
+          w.buf += sep;
+        w.value(handle, i);
+      }
+    w.end_row();
+    rows++;
+  }
+  if (!ec)
+    w.flush();
+  return rows;
+}
+
+std::size_t export_rows(statement & stmt, export_sink sink, const export_options & options)
+{
+  system::error_code ec;
+  error_info ei;
+  const auto res = export_rows(stmt, sink, options, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+  return res;
+}
+
+std::size_t export_rows(statement & stmt, int fd, const export_options & options,
+                        system::error_code & ec, error_info & ei)
+{
+  fd_sink sink{fd};
+  return export_rows(stmt, sink, options, ec, ei);
+}
+
+std::size_t export_rows(statement & stmt, int fd, const export_options & options)
+{
+  fd_sink sink{fd};
+  return export_rows(stmt, sink, options);
+}
+
+BOOST_SQLITE_END_NAMESPACE
@@ -0,0 +1,229 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/hyperloglog.hpp>
+#include <boost/sqlite/function.hpp>
+#include <boost/sqlite/memory.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace
+{
+
+struct hyperloglog_header
+{
+  std::uint32_t magic;
+  std::uint8_t precision;
+  std::uint8_t reserved[3];
+};
+
+constexpr std::uint32_t hyperloglog_magic = 0x314c4c48u; // "HLL1"
+
+std::uint64_t mix(std::uint64_t x) noexcept
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ull;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebull;
+  x ^= x >> 31;
+  return x;
+}
+
+// MurmurHash64A
+std::uint64_t hash_bytes(const void * data, std::size_t len, std::uint64_t seed) noexcept
+{
+  constexpr std::uint64_t m = 0xc6a4a7935bd1e995ull;
+  constexpr int r = 47;
+  auto p = static_cast<const unsigned char*>(data);
+  std::uint64_t h = seed ^ (len * m);
+
+  for (const auto end = p + (len & ~std::size_t(7u)); p != end; p += 8)
+  {
+    std::uint64_t k;
+    std::memcpy(&k, p, sizeof(k));
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+    h ^= k;
+    h *= m;
+  }
+
+  switch (len & 7u)
+  {
+    case 7: h ^= std::uint64_t(p[6]) << 48; BOOST_FALLTHROUGH;
+    case 6: h ^= std::uint64_t(p[5]) << 40; BOOST_FALLTHROUGH;
+    case 5: h ^= std::uint64_t(p[4]) << 32; BOOST_FALLTHROUGH;
+    case 4: h ^= std::uint64_t(p[3]) << 24; BOOST_FALLTHROUGH;
+    case 3: h ^= std::uint64_t(p[2]) << 16; BOOST_FALLTHROUGH;
+    case 2: h ^= std::uint64_t(p[1]) << 8;  BOOST_FALLTHROUGH;
+    case 1: h ^= std::uint64_t(p[0]);
+            h *= m;
+  }
+
+  h ^= h >> r;
+  h *= m;
+  h ^= h >> r;
+  return h;
+}
+
+// Ertl, "New cardinality estimation algorithms for HyperLogLog sketches", 2017
+double sigma(double x) noexcept
+{
+  if (x == 1.)
+    return HUGE_VAL;
+  double y = 1., z = x, prev;
+  do
+  {
+    x *= x;
+    prev = z;
+    z += x * y;
+    y += y;
+  }
+  while (z != prev);
+  return z;
+}
+
+double tau(double x) noexcept
+{
+  if (x == 0. || x == 1.)
+    return 0.;
+  double y = 1., z = 1. - x, prev;
+  do
+  {
+    x = std::sqrt(x);
+    prev = z;
+    y *= .5;
+    z -= (1. - x) * (1. - x) * y;
+  }
+  while (z != prev);
+  return z / 3.;
+}
+
+}
+
+std::uint64_t hyperloglog::hash(const value & v) noexcept
+{
+  switch (v.type())
+  {
+    case value_type::integer:
+      return mix(static_cast<std::uint64_t>(v.get_int()));
+    case value_type::floating:
+    {
+      const auto d = v.get_double();
+      // integral doubles compare equal to integers in sqlite
+      if (d >= -9223372036854775808. && d < 9223372036854775808. && std::trunc(d) == d)
+        return mix(static_cast<std::uint64_t>(static_cast<sqlite3_int64>(d)));
+      std::uint64_t bits;
+      std::memcpy(&bits, &d, sizeof(bits));
+      return mix(bits ^ 0x9e3779b97f4a7c15ull);
+    }
+    case value_type::text:
+    {
+      auto t = v.get_text();
+      return hash_bytes(t.data(), t.size(), 0x7465787474657874ull);
+    }
+    case value_type::blob:
+    {
+      auto b = v.get_blob();
+      return hash_bytes(b.data(), b.size(), 0x626c6f62626c6f62ull);
+    }
+    default:
+      return 0u;
+  }
+}
+
+void hyperloglog::merge(const hyperloglog & other) noexcept
+{
+  for (std::size_t i = 0u; i < register_count; i++)
+    registers[i] = (std::max)(registers[i], other.registers[i]);
+}
+
+result<void> hyperloglog::merge(blob_view bv) noexcept
+{
+  hyperloglog_header hdr;
+  if (bv.size() != sizeof(hdr) + register_count)
+    return error(SQLITE_MISMATCH, "invalid hyperloglog sketch");
+  std::memcpy(&hdr, bv.data(), sizeof(hdr));
+  if (hdr.magic != hyperloglog_magic || hdr.precision != precision)
+    return error(SQLITE_MISMATCH, "invalid hyperloglog sketch");
+
+  // a register holds the position of the first set bit of the remaining 64 - precision bits, or one past it.
+  constexpr std::uint8_t max_register = 64u - precision + 1u;
+  const auto regs = static_cast<const std::uint8_t*>(bv.data()) + sizeof(hdr);
+  if (std::any_of(regs, regs + register_count, [](std::uint8_t r) { return r > max_register; }))
+    return error(SQLITE_MISMATCH, "invalid hyperloglog sketch");
+
+  for (std::size_t i = 0u; i < register_count; i++)
+    registers[i] = (std::max)(registers[i], regs[i]);
+  return {};
+}
+
+double hyperloglog::estimate() const noexcept
+{
+  constexpr unsigned q = 64u - precision;
+  std::uint32_t histogram[q + 2u] = {};
+  for (auto r : registers)
+    histogram[(std::min)(static_cast<unsigned>(r), q + 1u)]++;
+
+  const auto m = static_cast<double>(register_count);
+  auto z = m * tau(1. - histogram[q + 1u] / m);
+  for (auto k = q; k >= 1u; k--)
+    z = .5 * (z + histogram[k]);
+  z += m * sigma(histogram[0] / m);
+
+  constexpr double alpha_inf = 0.7213475204444817; // 1 / (2 ln 2)
+  return alpha_inf * m * m / z;
+}
+
+blob hyperloglog::to_blob() const
+{
+  const hyperloglog_header hdr{hyperloglog_magic, precision, {}};
+  blob res{sizeof(hdr) + register_count};
+  std::memcpy(res.data(), &hdr, sizeof(hdr));
+  std::memcpy(static_cast<char*>(res.data()) + sizeof(hdr), registers, register_count);
+  return res;
+}
+
+void create_hyperloglog_functions(connection_ref conn, system::error_code & ec, error_info & ei)
+{
+  const auto flags = deterministic;
+  create_aggregate_function<detail::approx_count_distinct>(conn, "approx_count_distinct", std::tuple<>{}, flags, ec, ei);
+  if (!ec)
+    create_aggregate_function<detail::hll_sketch>(conn, "hll_sketch", std::tuple<>{}, flags, ec, ei);
+  if (!ec)
+    create_aggregate_function<detail::hll_merge>(conn, "hll_merge", std::tuple<>{}, flags, ec, ei);
+  if (!ec)
+    create_scalar_function(
+        conn, "hll_estimate",
+        [](blob_view sketch) -> result<sqlite3_int64>
+        {
+          // ~16KiB, so keep it off the stack
+          unique_ptr<hyperloglog> hll{new (memory_tag{}) hyperloglog()};
+          if (!hll)
+            return error(SQLITE_NOMEM);
+          auto res = hll->merge(sketch);
+          if (res.has_error())
+            return std::move(res).error();
+          return static_cast<sqlite3_int64>(hll->estimate() + .5);
+        }, flags, ec, ei);
+
+  if (ec && ei.message().empty())
+    ei.set_message(sqlite3_errmsg(conn.handle()));
+}
+
+void create_hyperloglog_functions(connection_ref conn)
+{
+  system::error_code ec;
+  error_info ei;
+  create_hyperloglog_functions(conn, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+BOOST_SQLITE_END_NAMESPACE
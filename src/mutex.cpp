@@ -0,0 +1,205 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/mutex.hpp>
+#include <boost/sqlite/detail/exception.hpp>
+
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <thread>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace
+{
+
+// SQLITE_MUTEX_FAST up to SQLITE_MUTEX_STATIC_VFS3
+constexpr int mutex_types = SQLITE_MUTEX_STATIC_VFS3 + 1;
+
+struct adaptive_mutex
+{
+  explicit adaptive_mutex(int type = SQLITE_MUTEX_FAST) noexcept : type(type) {}
+
+  std::mutex mtx;
+  std::atomic<std::thread::id> owner{};
+  int depth = 0;
+  // only set for FAST & RECURSIVE, the static ones are identified by their address.
+  int type;
+  // only written by the owner, so it doesn't need a read-modify-write.
+  std::atomic<std::uint64_t> acquisitions{0u};
+
+  void acquired(std::thread::id self) noexcept
+  {
+    owner.store(self, std::memory_order_relaxed);
+    depth = 1;
+    count();
+  }
+
+  void count() noexcept
+  {
+    acquisitions.store(acquisitions.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+  }
+};
+
+// keeps the counters of different classes on separate cache lines.
+struct alignas(64) class_counters
+{
+  std::atomic<std::uint64_t> acquisitions{0u};
+  std::atomic<std::uint64_t> contended{0u};
+  std::atomic<std::int64_t>  wait_ns{0};
+};
+
+class_counters counters[mutex_types];
+// the static mutexes, indexed by type. The first two are unused.
+adaptive_mutex statics[mutex_types];
+int spin_count = 100;
+
+adaptive_mutex * get(sqlite3_mutex * m) noexcept
+{
+  return reinterpret_cast<adaptive_mutex*>(m);
+}
+
+int type_of(const adaptive_mutex * m) noexcept
+{
+  if (m >= std::begin(statics) && m < std::end(statics))
+    return static_cast<int>(m - std::begin(statics));
+  return m->type;
+}
+
+int mutex_init() { return SQLITE_OK; }
+int mutex_end()  { return SQLITE_OK; }
+
+sqlite3_mutex * mutex_alloc(int type)
+{
+  adaptive_mutex * m = nullptr;
+  if (type == SQLITE_MUTEX_FAST || type == SQLITE_MUTEX_RECURSIVE)
+    m = new (std::nothrow) adaptive_mutex(type);
+  else if (type > SQLITE_MUTEX_RECURSIVE && type < mutex_types)
+    m = &statics[type];
+  return reinterpret_cast<sqlite3_mutex*>(m);
+}
+
+void mutex_free(sqlite3_mutex * p)
+{
+  auto m = get(p);
+  if (type_of(m) > SQLITE_MUTEX_RECURSIVE)
+    return;
+  counters[m->type].acquisitions.fetch_add(m->acquisitions.load(std::memory_order_relaxed),
+                                           std::memory_order_relaxed);
+  delete m;
+}
+
+void mutex_enter(sqlite3_mutex * p)
+{
+  auto m = get(p);
+  const auto self = std::this_thread::get_id();
+  if (m->type == SQLITE_MUTEX_RECURSIVE && m->owner.load(std::memory_order_relaxed) == self)
+  {
+    m->depth++;
+    m->count();
+    return;
+  }
+
+  if (m->mtx.try_lock())
+    return m->acquired(self);
+
+  const auto start = std::chrono::steady_clock::now();
+  bool locked = false;
+  for (int i = 0; i < spin_count && !locked; i++)
+  {
+    if (i >= spin_count / 2)
+      std::this_thread::yield();
+    locked = m->mtx.try_lock();
+  }
+  if (!locked)
+    m->mtx.lock();
+
+  auto & cc = counters[type_of(m)];
+  cc.contended.fetch_add(1u, std::memory_order_relaxed);
+  cc.wait_ns.fetch_add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(),
+      std::memory_order_relaxed);
+  m->acquired(self);
+}
+
+int mutex_try(sqlite3_mutex * p)
+{
+  auto m = get(p);
+  const auto self = std::this_thread::get_id();
+  if (m->type == SQLITE_MUTEX_RECURSIVE && m->owner.load(std::memory_order_relaxed) == self)
+  {
+    m->depth++;
+    m->count();
+    return SQLITE_OK;
+  }
+  if (!m->mtx.try_lock())
+    return SQLITE_BUSY;
+  m->acquired(self);
+  return SQLITE_OK;
+}
+
+void mutex_leave(sqlite3_mutex * p)
+{
+  auto m = get(p);
+  if (--m->depth == 0)
+  {
+    m->owner.store(std::thread::id(), std::memory_order_relaxed);
+    m->mtx.unlock();
+  }
+}
+
+int mutex_held(sqlite3_mutex * p)
+{
+  return p == nullptr || get(p)->owner.load(std::memory_order_relaxed) == std::this_thread::get_id();
+}
+
+int mutex_notheld(sqlite3_mutex * p)
+{
+  return p == nullptr || get(p)->owner.load(std::memory_order_relaxed) != std::this_thread::get_id();
+}
+
+const sqlite3_mutex_methods adaptive_methods =
+{
+  &mutex_init, &mutex_end, &mutex_alloc, &mutex_free,
+  &mutex_enter, &mutex_try, &mutex_leave,
+  &mutex_held, &mutex_notheld
+};
+
+}
+
+void install_adaptive_mutex(const adaptive_mutex_options & options, system::error_code & ec)
+{
+  const auto cc = sqlite3_config(SQLITE_CONFIG_MUTEX, &adaptive_methods);
+  if (cc != SQLITE_OK)
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+  else
+    spin_count = options.spin;
+}
+
+void install_adaptive_mutex(const adaptive_mutex_options & options)
+{
+  system::error_code ec;
+  install_adaptive_mutex(options, ec);
+  if (ec)
+    detail::throw_error_code(ec);
+}
+
+mutex_metrics mutex_contention(int type) noexcept
+{
+  mutex_metrics res;
+  if (type < 0 || type >= mutex_types)
+    return res;
+  const auto & cc = counters[type];
+  res.acquisitions = cc.acquisitions.load(std::memory_order_relaxed);
+  if (type > SQLITE_MUTEX_RECURSIVE)
+    res.acquisitions += statics[type].acquisitions.load(std::memory_order_relaxed);
+  res.contended = cc.contended.load(std::memory_order_relaxed);
+  res.wait_time = std::chrono::nanoseconds(cc.wait_ns.load(std::memory_order_relaxed));
+  return res;
+}
+
+BOOST_SQLITE_END_NAMESPACE
@@ -0,0 +1,487 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/page_cache.hpp>
+#include <boost/sqlite/detail/exception.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace
+{
+
+struct page_cache;
+struct cache;
+
+// The header of a page, followed by the page buffer & the extra data in the same allocation.
+struct alignas(8) page
+{
+  sqlite3_pcache_page base;
+  cache * owner;
+  unsigned key;
+  std::size_t size;
+  bool pinned;
+  // the CLOCK bit, set by every fetch & cleared when the hand passes.
+  bool referenced;
+  // the ring of the shard, only used by purgeable pages.
+  page * prev = nullptr;
+  page * next = nullptr;
+  // the pages of the owner in the same shard.
+  page * owner_prev = nullptr;
+  page * owner_next = nullptr;
+};
+
+struct page_key
+{
+  const cache * owner;
+  unsigned key;
+
+  bool operator==(const page_key & rhs) const noexcept
+  {
+    return owner == rhs.owner && key == rhs.key;
+  }
+};
+
+struct page_key_hash
+{
+  std::size_t operator()(const page_key & k) const noexcept
+  {
+    auto h = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(k.owner));
+    h ^= static_cast<std::uint64_t>(k.key) * 0x9E3779B97F4A7C15ull;
+    h ^= h >> 29;
+    return static_cast<std::size_t>(h);
+  }
+};
+
+struct shard
+{
+  std::size_t index = 0u;
+  std::mutex mtx;
+  std::unordered_map<page_key, page *, page_key_hash> pages;
+  // the CLOCK hand, pointing into the ring of purgeable pages.
+  page * hand = nullptr;
+  std::size_t ring_size = 0u;
+  // memory of the purgeable pages, limited by the budget, and of all pages.
+  std::size_t purgeable = 0u, memory = 0u;
+  std::size_t budget = 0u;
+  std::uint64_t hits = 0u, misses = 0u, evictions = 0u;
+
+  void link(page * p) noexcept
+  {
+    if (hand == nullptr)
+    {
+      p->prev = p->next = p;
+      hand = p;
+    }
+    else
+    {
+      // insert behind the hand, so it's the last page to be visited.
+      p->next = hand;
+      p->prev = hand->prev;
+      hand->prev->next = p;
+      hand->prev = p;
+    }
+    ring_size++;
+  }
+
+  void unlink(page * p) noexcept
+  {
+    if (p->next == p)
+      hand = nullptr;
+    else
+    {
+      if (hand == p)
+        hand = p->next;
+      p->prev->next = p->next;
+      p->next->prev = p->prev;
+    }
+    p->prev = p->next = nullptr;
+    ring_size--;
+  }
+};
+
+struct cache
+{
+  page_cache * pc;
+  int page_size;
+  int extra_size;
+  bool purgeable;
+  std::atomic<int> pages{0};
+  // the pages of the cache in each shard, guarded by the mutex of the shard,
+  // so truncating doesn't need to visit the pages of other caches.
+  std::vector<page*> heads;
+
+  void link(const shard & s, page * p) noexcept
+  {
+    auto & head = heads[s.index];
+    p->owner_prev = nullptr;
+    p->owner_next = head;
+    if (head != nullptr)
+      head->owner_prev = p;
+    head = p;
+  }
+
+  void unlink(const shard & s, page * p) noexcept
+  {
+    if (p->owner_prev != nullptr)
+      p->owner_prev->owner_next = p->owner_next;
+    else
+      heads[s.index] = p->owner_next;
+    if (p->owner_next != nullptr)
+      p->owner_next->owner_prev = p->owner_prev;
+    p->owner_prev = p->owner_next = nullptr;
+  }
+
+  std::size_t block_size() const noexcept
+  {
+    return sizeof(page) + static_cast<std::size_t>(page_size) + static_cast<std::size_t>(extra_size);
+  }
+};
+
+struct page_cache
+{
+  explicit page_cache(const page_cache_options & options)
+    : shards((std::max)(options.shards, std::size_t(1u)))
+  {
+    for (auto & s : shards)
+    {
+      s.index = static_cast<std::size_t>(&s - shards.data());
+      s.budget = options.max_memory / shards.size();
+    }
+  }
+
+  std::vector<shard> shards;
+
+  shard & shard_of(const cache * c, unsigned key) noexcept
+  {
+    return shards[page_key_hash()(page_key{c, key}) % shards.size()];
+  }
+};
+
+std::unique_ptr<page_cache> installed;
+
+// add a page, that is in the map of the shard already, to the lists & the memory of the shard.
+void add(shard & s, page * p) noexcept
+{
+  if (p->owner->purgeable)
+  {
+    s.link(p);
+    s.purgeable += p->size;
+  }
+  p->owner->link(s, p);
+  s.memory += p->size;
+  p->owner->pages.fetch_add(1, std::memory_order_relaxed);
+}
+
+// remove a page from the lists & the memory of the shard, but not from its map.
+void subtract(shard & s, page * p) noexcept
+{
+  if (p->owner->purgeable)
+  {
+    s.unlink(p);
+    s.purgeable -= p->size;
+  }
+  p->owner->unlink(s, p);
+  s.memory -= p->size;
+  p->owner->pages.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// remove the page from the shard, without freeing it.
+void remove(shard & s, page * p) noexcept
+{
+  s.pages.erase(page_key{p->owner, p->key});
+  subtract(s, p);
+}
+
+// add a slot for `key` of `c` to the map of the shard, returns false if the map couldn't allocate.
+bool reserve(shard & s, const cache * c, unsigned key, page * p) noexcept
+{
+  BOOST_TRY
+  {
+    s.pages.emplace(page_key{c, key}, p);
+  }
+  BOOST_CATCH(...)
+  {
+    return false;
+  }
+  BOOST_CATCH_END
+  return true;
+}
+
+// insert a page into the shard, returns false if the map couldn't allocate.
+bool insert(shard & s, page * p) noexcept
+{
+  if (!reserve(s, p->owner, p->key, p))
+    return false;
+  add(s, p);
+  return true;
+}
+
+// evict an unpinned page, of any cache, that hasn't been used since the hand passed it.
+page * evict_one(shard & s) noexcept
+{
+  for (std::size_t i = 0u, n = 2u * s.ring_size; i < n && s.hand != nullptr; i++)
+  {
+    page * p = s.hand;
+    s.hand = p->next;
+    if (p->pinned)
+      continue;
+    if (p->referenced)
+    {
+      p->referenced = false;
+      continue;
+    }
+    remove(s, p);
+    s.evictions++;
+    return p;
+  }
+  return nullptr;
+}
+
+void enforce_budget(shard & s) noexcept
+{
+  while (s.purgeable > s.budget)
+  {
+    auto p = evict_one(s);
+    if (p == nullptr)
+      break;
+    sqlite3_free(p);
+  }
+}
+
+// remove all pages of `c` from `s` that `pred` returns true for.
+template<typename Pred>
+void remove_if(shard & s, const cache * c, Pred pred) noexcept
+{
+  std::lock_guard<std::mutex> l{s.mtx};
+  for (page * p = c->heads[s.index]; p != nullptr;)
+  {
+    page * next = p->owner_next;
+    if (pred(p))
+    {
+      remove(s, p);
+      sqlite3_free(p);
+    }
+    p = next;
+  }
+}
+
+int pcache_init(void *) { return SQLITE_OK; }
+void pcache_shutdown(void *) {}
+
+sqlite3_pcache * pcache_create(int page_size, int extra_size, int purgeable)
+{
+  auto c = static_cast<cache*>(sqlite3_malloc64(sizeof(cache)));
+  if (c == nullptr)
+    return nullptr;
+  new (c) cache();
+  BOOST_TRY
+  {
+    c->heads.resize(installed->shards.size(), nullptr);
+  }
+  BOOST_CATCH(...)
+  {
+    c->~cache();
+    sqlite3_free(c);
+    return nullptr;
+  }
+  BOOST_CATCH_END
+  c->pc = installed.get();
+  c->page_size = page_size;
+  c->extra_size = extra_size;
+  c->purgeable = purgeable != 0;
+  return reinterpret_cast<sqlite3_pcache*>(c);
+}
+
+// the memory budget is shared by all caches, so the size of one is ignored.
+void pcache_cachesize(sqlite3_pcache *, int) {}
+
+int pcache_pagecount(sqlite3_pcache * p)
+{
+  return reinterpret_cast<cache*>(p)->pages.load(std::memory_order_relaxed);
+}
+
+sqlite3_pcache_page * pcache_fetch(sqlite3_pcache * pc, unsigned key, int create)
+{
+  auto c = reinterpret_cast<cache*>(pc);
+  auto & s = c->pc->shard_of(c, key);
+  std::lock_guard<std::mutex> l{s.mtx};
+
+  auto itr = s.pages.find(page_key{c, key});
+  if (itr != s.pages.end())
+  {
+    s.hits++;
+    itr->second->pinned = true;
+    itr->second->referenced = true;
+    return &itr->second->base;
+  }
+  s.misses++;
+  if (create == 0)
+    return nullptr;
+
+  const auto size = c->block_size();
+  page * block = nullptr;
+  if (c->purgeable)
+  {
+    while (s.purgeable + size > s.budget)
+    {
+      auto victim = evict_one(s);
+      if (victim == nullptr)
+        break;
+      // reuse a page of the same size, e.g. of another connection to the same database.
+      if (block == nullptr && victim->size == size)
+        block = victim;
+      else
+        sqlite3_free(victim);
+    }
+    // 1 means only allocate if that's easy, 2 to try harder.
+    if (block == nullptr && create == 1 && s.purgeable + size > s.budget)
+      return nullptr;
+  }
+
+  void * mem = block != nullptr ? static_cast<void*>(block) : sqlite3_malloc64(size);
+  if (mem == nullptr)
+    return nullptr;
+
+  auto p = new (mem) page();
+  p->base.pBuf = reinterpret_cast<unsigned char*>(p) + sizeof(page);
+  p->base.pExtra = static_cast<unsigned char*>(p->base.pBuf) + c->page_size;
+  std::memset(p->base.pExtra, 0, static_cast<std::size_t>(c->extra_size));
+  p->owner = c;
+  p->key = key;
+  p->size = size;
+  p->pinned = true;
+  p->referenced = true;
+  if (!insert(s, p))
+  {
+    sqlite3_free(p);
+    return nullptr;
+  }
+  return &p->base;
+}
+
+void pcache_unpin(sqlite3_pcache * pc, sqlite3_pcache_page * pg, int discard)
+{
+  auto c = reinterpret_cast<cache*>(pc);
+  auto p = reinterpret_cast<page*>(pg);
+  auto & s = c->pc->shard_of(c, p->key);
+  std::lock_guard<std::mutex> l{s.mtx};
+  p->pinned = false;
+  if (discard)
+  {
+    remove(s, p);
+    sqlite3_free(p);
+  }
+  else
+    // pages allocated over the budget get evicted once they're unpinned.
+    enforce_budget(s);
+}
+
+void pcache_rekey(sqlite3_pcache * pc, sqlite3_pcache_page * pg, unsigned old_key, unsigned new_key)
+{
+  auto c = reinterpret_cast<cache*>(pc);
+  auto p = reinterpret_cast<page*>(pg);
+  auto & from = c->pc->shard_of(c, old_key);
+  auto & to = c->pc->shard_of(c, new_key);
+  std::unique_lock<std::mutex> lf{from.mtx, std::defer_lock}, lt{to.mtx, std::defer_lock};
+  if (&from == &to)
+    lf.lock();
+  else
+    std::lock(lf, lt);
+
+  // a page with the new key is never pinned & gets discarded.
+  auto itr = to.pages.find(page_key{c, new_key});
+  if (itr != to.pages.end())
+  {
+    auto existing = itr->second;
+    remove(to, existing);
+    sqlite3_free(existing);
+  }
+
+  // the page is pinned by sqlite, so it must not be freed.
+  // If the map can't allocate the new slot, it keeps its old key until it's unpinned or truncated.
+  if (!reserve(to, c, new_key, p))
+    return;
+  remove(from, p);
+  p->key = new_key;
+  add(to, p);
+}
+
+void pcache_truncate(sqlite3_pcache * pc, unsigned limit)
+{
+  auto c = reinterpret_cast<cache*>(pc);
+  for (auto & s : c->pc->shards)
+    remove_if(s, c, [limit](const page * p) { return p->key >= limit; });
+}
+
+void pcache_destroy(sqlite3_pcache * pc)
+{
+  auto c = reinterpret_cast<cache*>(pc);
+  for (auto & s : c->pc->shards)
+    remove_if(s, c, [](const page *) { return true; });
+  c->~cache();
+  sqlite3_free(c);
+}
+
+void pcache_shrink(sqlite3_pcache * pc)
+{
+  auto c = reinterpret_cast<cache*>(pc);
+  for (auto & s : c->pc->shards)
+    remove_if(s, c, [](const page * p) { return !p->pinned; });
+}
+
+}
+
+void install_page_cache(const page_cache_options & options, system::error_code & ec)
+{
+  std::unique_ptr<page_cache> pc{new page_cache(options)};
+  const sqlite3_pcache_methods2 methods =
+  {
+    1, nullptr,
+    &pcache_init, &pcache_shutdown, &pcache_create, &pcache_cachesize, &pcache_pagecount,
+    &pcache_fetch, &pcache_unpin, &pcache_rekey, &pcache_truncate, &pcache_destroy, &pcache_shrink
+  };
+  const auto cc = sqlite3_config(SQLITE_CONFIG_PCACHE2, &methods);
+  if (cc != SQLITE_OK)
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+  else
+    // sqlite isn't initialized, so no cache can use the previous one.
+    installed = std::move(pc);
+}
+
+void install_page_cache(const page_cache_options & options)
+{
+  system::error_code ec;
+  install_page_cache(options, ec);
+  if (ec)
+    detail::throw_error_code(ec);
+}
+
+page_cache_metrics page_cache_stats() noexcept
+{
+  page_cache_metrics res;
+  if (!installed)
+    return res;
+  for (auto & s : installed->shards)
+  {
+    std::lock_guard<std::mutex> l{s.mtx};
+    res.hits += s.hits;
+    res.misses += s.misses;
+    res.evictions += s.evictions;
+    res.pages += s.pages.size();
+    res.memory_used += s.memory;
+  }
+  return res;
+}
+
+BOOST_SQLITE_END_NAMESPACE
@@ -0,0 +1,293 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/sqlite/parallel_query.hpp>
+#include <boost/sqlite/snapshot.hpp>
+#include <boost/sqlite/statement.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+namespace detail
+{
+
+namespace
+{
+
+struct parallel_query_state
+{
+  void (*func)(void * data, std::size_t partition, const row & r);
+  void * data;
+
+  sqlite3_int64 lower;
+  sqlite3_uint64 width;
+  std::size_t partitions;
+
+#if defined(SQLITE_ENABLE_SNAPSHOT)
+  snapshot snap;
+#endif
+
+  std::atomic<bool> stopped{false};
+  std::mutex mtx;
+  system::error_code ec;
+  error_info ei;
+  std::exception_ptr exception;
+
+  void fail(const system::error_code & ec_, const error_info & ei_)
+  {
+    std::lock_guard<std::mutex> l{mtx};
+    if (!ec && !exception)
+    {
+      ec = ec_;
+      ei.set_message(ei_.message());
+    }
+    stopped = true;
+  }
+
+  void fail(std::exception_ptr ex)
+  {
+    std::lock_guard<std::mutex> l{mtx};
+    if (!ec && !exception)
+      exception = std::move(ex);
+    stopped = true;
+  }
+};
+
+// the integer bound of the partitions for a value of the partition column.
+sqlite3_int64 bound_of(field v, bool upper) noexcept
+{
+  if (v.type() != value_type::floating)
+    return v.get_int();
+  const auto d = upper ? std::ceil(v.get_double()) : std::floor(v.get_double());
+  if (!(d > -9223372036854775808.))
+    return (std::numeric_limits<sqlite3_int64>::min)();
+  if (d >= 9223372036854775808.)
+    return (std::numeric_limits<sqlite3_int64>::max)();
+  return static_cast<sqlite3_int64>(d);
+}
+
+// partition p covers [lower + p * width, lower + (p + 1) * width), the first & the last one are open-ended,
+// so no real value falls between two partitions.
+void run_partitions(parallel_query_state & st,
+                    connection_ref conn,
+                    statement & stmt,
+                    std::size_t first,
+                    std::size_t stride)
+{
+  system::error_code ec;
+  error_info ei;
+  for (std::size_t p = first; p < st.partitions && !st.stopped; p += stride)
+  {
+    const auto lo = static_cast<sqlite3_int64>(static_cast<sqlite3_uint64>(st.lower) + p * st.width);
+    const auto hi = static_cast<sqlite3_int64>(static_cast<sqlite3_uint64>(lo) + st.width);
+    constexpr auto inf = std::numeric_limits<double>::infinity();
+
+    sqlite3_reset(stmt.handle());
+    if (p == 0u)
+      stmt.bind(1u, -inf, ec, ei);
+    else
+      stmt.bind(1u, lo, ec, ei);
+    if (!ec && p + 1u == st.partitions)
+      stmt.bind(2u, inf, ec, ei);
+    else if (!ec)
+      stmt.bind(2u, hi, ec, ei);
+
+    while (!ec && !st.stopped)
+    {
+      const auto cc = sqlite3_step(stmt.handle());
+      if (cc == SQLITE_DONE)
+        break;
+      else if (cc != SQLITE_ROW)
+      {
+        BOOST_SQLITE_ASSIGN_EC(ec, cc);
+        ei.set_message(sqlite3_errmsg(conn.handle()));
+        break;
+      }
+      st.func(st.data, p, stmt.current());
+    }
+
+    if (ec)
+    {
+      st.fail(ec, ei);
+      break;
+    }
+  }
+  sqlite3_reset(stmt.handle());
+}
+
+void run_worker(parallel_query_state & st,
+                connection_ref conn,
+                core::string_view partition_sql,
+                std::size_t first,
+                std::size_t stride,
+                bool in_transaction)
+{
+  system::error_code ec;
+  error_info ei;
+  BOOST_TRY
+  {
+    if (!in_transaction)
+    {
+#if defined(SQLITE_ENABLE_SNAPSHOT)
+      st.snap.open(conn, "main", ec, ei);
+#else
+      conn.execute("BEGIN", ec, ei);
+#endif
+    }
+
+    statement stmt;
+    if (!ec)
+      stmt = conn.prepare(partition_sql, ec, ei);
+
+    if (ec)
+      st.fail(ec, ei);
+    else
+      run_partitions(st, conn, stmt, first, stride);
+  }
+  BOOST_CATCH(...)
+  {
+    st.fail(std::current_exception());
+  }
+  BOOST_CATCH_END
+
+  if (sqlite3_get_autocommit(conn.handle()) == 0)
+  {
+    ec.clear();
+    conn.execute("COMMIT", ec, ei);
+  }
+}
+
+}
+
+void parallel_query(span<const connection_ref> pool,
+                    core::string_view sql,
+                    cstring_ref partition_column,
+                    std::size_t partitions,
+                    void (*func)(void * data, std::size_t partition, const row & r),
+                    void * data,
+                    system::error_code & ec,
+                    error_info & ei)
+{
+  if (pool.empty() || partitions == 0u)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_MISUSE);
+    ei.set_message("parallel_query requires at least one connection and one partition");
+    return;
+  }
+
+  const auto sql_len = static_cast<int>(sql.size());
+  unique_ptr<char> bounds_sql{sqlite3_mprintf("select min(\"%w\"), max(\"%w\"), count(*) - count(\"%w\") from (%.*s)",
+                                              partition_column.c_str(), partition_column.c_str(),
+                                              partition_column.c_str(), sql_len, sql.data())};
+  // sqlite may drop the order by of a subquery, so every partition gets sorted itself.
+  unique_ptr<char> partition_sql{sqlite3_mprintf("select * from (%.*s) where \"%w\" >= ?1 and \"%w\" < ?2 order by \"%w\"",
+                                                 sql_len, sql.data(), partition_column.c_str(),
+                                                 partition_column.c_str(), partition_column.c_str())};
+  if (!bounds_sql || !partition_sql)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_NOMEM);
+    return;
+  }
+
+  auto leader = pool.front();
+  leader.execute("BEGIN", ec, ei);
+  if (ec)
+    return;
+
+  struct transaction_reaper
+  {
+    connection_ref conn;
+    ~transaction_reaper()
+    {
+      if (sqlite3_get_autocommit(conn.handle()) == 0)
+        sqlite3_exec(conn.handle(), "COMMIT", nullptr, nullptr, nullptr);
+    }
+  } reaper{leader};
+
+  // starts the read transaction all partitions share.
+  auto bounds = leader.prepare(bounds_sql.get(), ec, ei);
+  if (!ec)
+    bounds.step(ec, ei);
+  if (ec)
+    return;
+
+  auto r = bounds.current();
+  // text & blobs sort after all numbers, so max finds them. Neither those nor nulls are in any partition.
+  if (r[2].get_int() != 0 || r[1].type() == value_type::text || r[1].type() == value_type::blob)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_MISMATCH);
+    ei.format("parallel_query requires a numeric \"%s\" in every row", partition_column.c_str());
+    return;
+  }
+  if (r[0].is_null()) // empty result
+    return;
+
+  const auto lower = bound_of(r[0], false);
+  const auto upper = bound_of(r[1], true);
+  bounds = statement();
+
+  parallel_query_state st;
+  st.func = func;
+  st.data = data;
+  st.lower = lower;
+  const auto range = static_cast<sqlite3_uint64>(upper) - static_cast<sqlite3_uint64>(lower) + 1u;
+  st.partitions = range == 0u ? partitions : static_cast<std::size_t>((std::min<sqlite3_uint64>)(range, partitions));
+  st.width = range == 0u
+           ? ((std::numeric_limits<sqlite3_uint64>::max)() / st.partitions) + 1u
+           : (range + st.partitions - 1u) / st.partitions;
+
+  const auto workers = (std::min)(pool.size(), st.partitions);
+#if defined(SQLITE_ENABLE_SNAPSHOT)
+  if (workers > 1u)
+  {
+    st.snap = snapshot(leader, "main", ec, ei);
+    if (ec)
+      return;
+  }
+#endif
+
+  std::vector<std::thread> threads;
+  threads.reserve(workers - 1u);
+  BOOST_TRY
+  {
+    for (std::size_t i = 1u; i < workers; i++)
+      threads.emplace_back(
+          [&st, &partition_sql, conn = pool[i], i, workers]
+          {
+            run_worker(st, conn, partition_sql.get(), i, workers, false);
+          });
+  }
+  BOOST_CATCH(...)
+  {
+    st.fail(std::current_exception());
+  }
+  BOOST_CATCH_END
+
+  run_worker(st, leader, partition_sql.get(), 0u, workers, true);
+
+  for (auto & t : threads)
+    t.join();
+
+  if (st.exception)
+    std::rethrow_exception(st.exception);
+
+  if (st.ec)
+  {
+    ec = st.ec;
+    ei.set_message(st.ei.message());
+  }
+}
+
+}
+BOOST_SQLITE_END_NAMESPACE
@@ -0,0 +1,375 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/query_cache.hpp>
+#include <boost/sqlite/hooks.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace
+{
+
+std::string table_key(core::string_view database, core::string_view table)
+{
+  std::string res;
+  res.reserve(database.size() + table.size() + 1u);
+  res.append(database.data(), database.size());
+  res.push_back('\0');
+  res.append(table.data(), table.size());
+  return res;
+}
+
+struct key_writer
+{
+  std::string & key;
+
+  void tag(char t, std::uint64_t n)
+  {
+    char buf[1u + sizeof(n)];
+    buf[0] = t;
+    std::memcpy(buf + 1, &n, sizeof(n));
+    key.append(buf, sizeof(buf));
+  }
+
+  void bytes(char t, const void * data, std::size_t size)
+  {
+    tag(t, size);
+    key.append(static_cast<const char*>(data), size);
+  }
+
+  bool operator()(variant2::monostate)   { key.push_back('n'); return true; }
+  // int & int64 bind the same value, so they share the key.
+  bool operator()(int i)                 { tag('i', static_cast<std::uint64_t>(static_cast<sqlite3_int64>(i))); return true;}
+  bool operator()(sqlite3_int64 i)       { tag('i', static_cast<std::uint64_t>(i)); return true;}
+  bool operator()(blob_view bv)          { bytes('b', bv.data(), bv.size()); return true;}
+  bool operator()(string_view sv)        { bytes('t', sv.data(), sv.size()); return true;}
+  bool operator()(zero_blob zb)          { tag('z', static_cast<std::uint64_t>(zb)); return true;}
+  bool operator()(double d)
+  {
+    std::uint64_t n;
+    std::memcpy(&n, &d, sizeof(n));
+    tag('f', n);
+    return true;
+  }
+  template<typename Pointer>
+  bool operator()(Pointer &&) { return false; }
+};
+
+struct read_recorder
+{
+  std::vector<std::string> & tables;
+  query_cache::authorizer_type auth;
+  void * auth_data;
+};
+
+// Records the tables read by the statement being prepared & asks the authorizer of the user.
+int record_reads(void * data, int action, const char * table, const char * column,
+                 const char * database, const char * trigger)
+{
+  auto & rec = *static_cast<read_recorder*>(data);
+  if (action == SQLITE_READ && table != nullptr && database != nullptr)
+  {
+    BOOST_TRY
+    {
+      auto key = table_key(database, table);
+      if (std::find(rec.tables.begin(), rec.tables.end(), key) == rec.tables.end())
+        rec.tables.push_back(std::move(key));
+    }
+    BOOST_CATCH(...)
+    {
+      // an untracked read could be served stale, so the statement must not be prepared.
+      return SQLITE_DENY;
+    }
+    BOOST_CATCH_END
+  }
+  return rec.auth != nullptr ? rec.auth(rec.auth_data, action, table, column, database, trigger) : SQLITE_OK;
+}
+
+}
+
+sqlite3_int64 cached_value::get_int() const noexcept
+{
+  switch (type())
+  {
+    case value_type::integer:  return static_cast<sqlite3_int64>(cell_->payload);
+    case value_type::floating: return static_cast<sqlite3_int64>(get_double());
+    default: return 0;
+  }
+}
+
+double cached_value::get_double() const noexcept
+{
+  switch (type())
+  {
+    case value_type::integer:  return static_cast<double>(static_cast<sqlite3_int64>(cell_->payload));
+    case value_type::floating:
+    {
+      double d;
+      std::memcpy(&d, &cell_->payload, sizeof(d));
+      return d;
+    }
+    default: return 0.;
+  }
+}
+
+core::string_view cached_value::get_text() const noexcept
+{
+  if (type() != value_type::text && type() != value_type::blob)
+    return core::string_view();
+  return core::string_view(data_ + cell_->payload, cell_->size);
+}
+
+blob_view cached_value::get_blob() const noexcept
+{
+  if (type() != value_type::text && type() != value_type::blob)
+    return blob_view(nullptr, 0u);
+  return blob_view(data_ + cell_->payload, cell_->size);
+}
+
+cached_value cached_result::at(std::size_t row, std::size_t column) const
+{
+  if (row >= rows_ || column >= names_.size())
+    throw_exception(std::out_of_range("cached_result::at"));
+  return cached_value(&cells_[row * names_.size() + column], data_.data());
+}
+
+std::size_t cached_result::memory_used() const noexcept
+{
+  std::size_t n = sizeof(*this) + cells_.capacity() * sizeof(cached_value::cell) + data_.capacity();
+  for (const auto & nm : names_)
+    n += sizeof(nm) + nm.capacity();
+  return n;
+}
+
+void query_cache::on_update::operator()(int, const char * db_name, const char * table, sqlite3_int64) noexcept
+{
+  BOOST_TRY
+  {
+    auto key = table_key(db_name, table);
+    // entries reading a dirty table are neither cached nor left from before the change
+    if (self->dirty_.count(key) != 0u)
+      return;
+    self->drop_table(key);
+    self->dirty_.insert(std::move(key));
+  }
+  BOOST_CATCH(...)
+  {
+    // without the record the entries of the transaction can't be dropped on rollback.
+    self->dirty_.clear();
+    self->clear();
+  }
+  BOOST_CATCH_END
+}
+
+void query_cache::on_rollback::operator()() noexcept
+{
+  for (const auto & tbl : self->dirty_)
+    self->drop_table(tbl);
+  self->dirty_.clear();
+}
+
+query_cache::query_cache(connection_ref conn, std::size_t max_memory)
+    : db_(conn.handle()), max_memory_(max_memory)
+{
+  update_hook(conn, update_);
+  rollback_hook(conn, rollback_);
+}
+
+query_cache::~query_cache()
+{
+  update_hook(connection_ref(db_), nullptr);
+  rollback_hook(connection_ref(db_), nullptr);
+  if (auth_ != nullptr)
+    sqlite3_set_authorizer(db_, nullptr, nullptr);
+}
+
+void query_cache::set_authorizer(authorizer_type auth, void * data)
+{
+  auth_ = auth;
+  auth_data_ = data;
+  sqlite3_set_authorizer(db_, auth_, auth_data_);
+}
+
+std::string query_cache::sql_key(core::string_view sql)
+{
+  std::string key;
+  key.reserve(1u + sizeof(std::uint64_t) + sql.size());
+  key_writer{key}.bytes('s', sql.data(), sql.size());
+  return key;
+}
+
+bool query_cache::append_key(std::string & key, const param_ref & param)
+{
+  return param.visit(key_writer{key});
+}
+
+void query_cache::end_transaction_if_done() noexcept
+{
+  // the changes of a transaction are committed once we're back in autocommit mode.
+  if (!dirty_.empty() && sqlite3_get_autocommit(db_) != 0)
+    dirty_.clear();
+}
+
+std::shared_ptr<const cached_result> query_cache::find(const std::string & key)
+{
+  end_transaction_if_done();
+  const auto itr = index_.find(key);
+  if (itr == index_.end())
+    return nullptr;
+  hits_++;
+  entries_.splice(entries_.begin(), entries_, itr->second);
+  return itr->second->result;
+}
+
+statement query_cache::prepare(core::string_view sql, std::vector<std::string> & tables,
+                               system::error_code & ec, error_info & ei)
+{
+  read_recorder rec{tables, auth_, auth_data_};
+  sqlite3_set_authorizer(db_, &record_reads, &rec);
+  auto res = connection_ref(db_).prepare(sql, ec, ei);
+  sqlite3_set_authorizer(db_, auth_, auth_data_);
+  return res;
+}
+
+std::shared_ptr<const cached_result> query_cache::run(const std::string * key, statement & stmt,
+                                                      std::vector<std::string> tables,
+                                                      system::error_code & ec, error_info & ei)
+{
+  misses_++;
+  const auto ss = stmt.handle();
+  const auto cols = static_cast<std::size_t>(sqlite3_column_count(ss));
+
+  std::shared_ptr<cached_result> res = std::make_shared<cached_result>();
+  res->names_.reserve(cols);
+  for (std::size_t i = 0u; i < cols; i++)
+  {
+    const char * nm = sqlite3_column_name(ss, static_cast<int>(i));
+    res->names_.emplace_back(nm ? nm : "");
+  }
+
+  int cc;
+  while ((cc = sqlite3_step(ss)) == SQLITE_ROW)
+  {
+    res->rows_++;
+    for (std::size_t i = 0u; i < cols; i++)
+    {
+      const auto c = static_cast<int>(i);
+      cached_value::cell cl{0u, 0u, sqlite3_column_type(ss, c)};
+      switch (cl.type)
+      {
+        case SQLITE_INTEGER:
+          cl.payload = static_cast<std::uint64_t>(sqlite3_column_int64(ss, c));
+          break;
+        case SQLITE_FLOAT:
+        {
+          const double d = sqlite3_column_double(ss, c);
+          std::memcpy(&cl.payload, &d, sizeof(d));
+          break;
+        }
+        case SQLITE_TEXT:
+        case SQLITE_BLOB:
+        {
+          const void * data = cl.type == SQLITE_TEXT
+                            ? static_cast<const void*>(sqlite3_column_text(ss, c))
+                            : sqlite3_column_blob(ss, c);
+          cl.size = static_cast<std::uint32_t>(sqlite3_column_bytes(ss, c));
+          cl.payload = res->data_.size();
+          if (cl.size > 0u)
+            res->data_.append(static_cast<const char*>(data), cl.size);
+          break;
+        }
+        default:
+          break;
+      }
+      res->cells_.push_back(cl);
+    }
+  }
+
+  if (cc != SQLITE_DONE)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    ei.set_message(sqlite3_errmsg(db_));
+    return nullptr;
+  }
+  res->cells_.shrink_to_fit();
+  res->data_.shrink_to_fit();
+
+  end_transaction_if_done();
+  const bool dirty = std::any_of(tables.begin(), tables.end(),
+                                 [&](const std::string & tbl) { return dirty_.count(tbl) != 0u; });
+  if (key == nullptr || dirty || !sqlite3_stmt_readonly(ss))
+    return res;
+  const auto size = res->memory_used() + sizeof(entry) + key->size();
+  if (size > max_memory_)
+    return res;
+
+  const auto itr = index_.find(*key);
+  if (itr != index_.end())
+    erase(itr->second);
+
+  entries_.push_front(entry{*key, std::move(tables), res, size});
+  auto & e = entries_.front();
+  index_.emplace(e.key, entries_.begin());
+  for (const auto & tbl : e.tables)
+    tables_[tbl].insert(&e);
+  memory_used_ += size;
+
+  while (memory_used_ > max_memory_)
+    erase(std::prev(entries_.end()));
+  return res;
+}
+
+void query_cache::erase(entry_list::iterator itr) noexcept
+{
+  for (const auto & tbl : itr->tables)
+  {
+    const auto t = tables_.find(tbl);
+    if (t == tables_.end())
+      continue;
+    t->second.erase(&*itr);
+    if (t->second.empty())
+      tables_.erase(t);
+  }
+  memory_used_ -= itr->size;
+  index_.erase(itr->key);
+  entries_.erase(itr);
+}
+
+void query_cache::drop_table(const std::string & name) noexcept
+{
+  const auto t = tables_.find(name);
+  if (t == tables_.end())
+    return;
+  // erase removes the entries from the set, so take it out first.
+  auto readers = std::move(t->second);
+  tables_.erase(t);
+  for (auto e : readers)
+  {
+    const auto itr = index_.find(e->key);
+    if (itr != index_.end())
+      erase(itr->second);
+  }
+}
+
+void query_cache::invalidate(core::string_view table, core::string_view database)
+{
+  drop_table(table_key(database, table));
+}
+
+void query_cache::clear() noexcept
+{
+  entries_.clear();
+  index_.clear();
+  tables_.clear();
+  memory_used_ = 0u;
+}
+
+BOOST_SQLITE_END_NAMESPACE
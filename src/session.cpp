@@ -0,0 +1,332 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/session.hpp>
+
+#if defined(SQLITE_ENABLE_SESSION) && defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+
+#include <limits>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace
+{
+
+bool check_size(blob_view bv, system::error_code & ec, error_info & ei)
+{
+  if (bv.size() > static_cast<std::size_t>((std::numeric_limits<int>::max)()))
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_TOOBIG);
+    ei.set_message("changeset too large");
+    return false;
+  }
+  return true;
+}
+
+// Takes ownership of a buffer returned by a session function.
+blob take_blob(int cc, int size, void * data, system::error_code & ec)
+{
+  unique_ptr<void> owned{data};
+  if (cc != SQLITE_OK)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    return blob();
+  }
+  return blob(std::move(owned), static_cast<std::size_t>(size));
+}
+
+sqlite3_changeset_iter * start_changeset(blob_view changeset, bool invert, system::error_code & ec, error_info & ei)
+{
+  if (!check_size(changeset, ec, ei))
+    return nullptr;
+  sqlite3_changeset_iter * iter = nullptr;
+  const auto cc = sqlite3changeset_start_v2(&iter, static_cast<int>(changeset.size()),
+                                            const_cast<void*>(changeset.data()),
+                                            invert ? SQLITE_CHANGESETSTART_INVERT : 0);
+  if (cc != SQLITE_OK)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    sqlite3changeset_finalize(iter);
+    return nullptr;
+  }
+  return iter;
+}
+
+sqlite3_session * create_session(sqlite3 * db, cstring_ref database, system::error_code & ec, error_info & ei)
+{
+  sqlite3_session * s = nullptr;
+  const auto cc = sqlite3session_create(db, database.c_str(), &s);
+  if (cc != SQLITE_OK)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    ei.set_message(sqlite3_errmsg(db));
+    return nullptr;
+  }
+  return s;
+}
+
+}
+
+changeset_reader::changeset_reader(blob_view changeset, bool invert)
+{
+  system::error_code ec;
+  error_info ei;
+  impl_.reset(start_changeset(changeset, invert, ec, ei));
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+changeset_reader::changeset_reader(blob_view changeset, bool invert, system::error_code & ec, error_info & ei)
+  : impl_(start_changeset(changeset, invert, ec, ei))
+{
+}
+
+bool changeset_reader::next(system::error_code & ec, error_info & ei)
+{
+  if (!impl_)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_MISUSE);
+    ei.set_message("changeset_reader has no changeset");
+    return false;
+  }
+  const auto cc = sqlite3changeset_next(impl_.get());
+  if (cc == SQLITE_ROW)
+    return true;
+  if (cc != SQLITE_DONE)
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+  return false;
+}
+
+bool changeset_reader::next()
+{
+  system::error_code ec;
+  error_info ei;
+  const bool res = next(ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+  return res;
+}
+
+session::session(connection_ref conn, cstring_ref database)
+  : db_(conn.handle())
+{
+  system::error_code ec;
+  error_info ei;
+  impl_.reset(create_session(db_, database, ec, ei));
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+session::session(connection_ref conn, cstring_ref database, system::error_code & ec, error_info & ei)
+  : impl_(create_session(conn.handle(), database, ec, ei)), db_(conn.handle())
+{
+}
+
+void session::attach(cstring_ref table, system::error_code & ec, error_info & ei)
+{
+  const auto cc = sqlite3session_attach(impl_.get(), table.c_str());
+  if (cc != SQLITE_OK)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    ei.set_message(sqlite3_errmsg(db_));
+  }
+}
+
+void session::attach(cstring_ref table)
+{
+  system::error_code ec;
+  error_info ei;
+  attach(table, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+void session::attach(system::error_code & ec, error_info & ei)
+{
+  const auto cc = sqlite3session_attach(impl_.get(), nullptr);
+  if (cc != SQLITE_OK)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    ei.set_message(sqlite3_errmsg(db_));
+  }
+}
+
+void session::attach()
+{
+  system::error_code ec;
+  error_info ei;
+  attach(ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+void session::diff(cstring_ref from_database, cstring_ref table, system::error_code & ec, error_info & ei)
+{
+  char * msg = nullptr;
+  const auto cc = sqlite3session_diff(impl_.get(), from_database.c_str(), table.c_str(), &msg);
+  if (cc != SQLITE_OK)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    if (msg)
+      ei.set_message(msg);
+  }
+  sqlite3_free(msg);
+}
+
+void session::diff(cstring_ref from_database, cstring_ref table)
+{
+  system::error_code ec;
+  error_info ei;
+  diff(from_database, table, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+blob session::changeset(system::error_code & ec, error_info & ) const
+{
+  int n = 0;
+  void * data = nullptr;
+  const auto cc = sqlite3session_changeset(impl_.get(), &n, &data);
+  return take_blob(cc, n, data, ec);
+}
+
+blob session::changeset() const
+{
+  system::error_code ec;
+  error_info ei;
+  auto res = changeset(ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+  return res;
+}
+
+blob session::patchset(system::error_code & ec, error_info & ) const
+{
+  int n = 0;
+  void * data = nullptr;
+  const auto cc = sqlite3session_patchset(impl_.get(), &n, &data);
+  return take_blob(cc, n, data, ec);
+}
+
+blob session::patchset() const
+{
+  system::error_code ec;
+  error_info ei;
+  auto res = patchset(ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+  return res;
+}
+
+changegroup::changegroup()
+{
+  sqlite3_changegroup * cg = nullptr;
+  const auto cc = sqlite3changegroup_new(&cg);
+  if (cc != SQLITE_OK)
+  {
+    system::error_code ec;
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    detail::throw_error_code(ec);
+  }
+  impl_.reset(cg);
+}
+
+void changegroup::add(blob_view changeset, system::error_code & ec, error_info & ei)
+{
+  if (!check_size(changeset, ec, ei))
+    return;
+  const auto cc = sqlite3changegroup_add(impl_.get(), static_cast<int>(changeset.size()),
+                                         const_cast<void*>(changeset.data()));
+  if (cc != SQLITE_OK)
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+}
+
+void changegroup::add(blob_view changeset)
+{
+  system::error_code ec;
+  error_info ei;
+  add(changeset, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+blob changegroup::output(system::error_code & ec, error_info & ) const
+{
+  int n = 0;
+  void * data = nullptr;
+  const auto cc = sqlite3changegroup_output(impl_.get(), &n, &data);
+  return take_blob(cc, n, data, ec);
+}
+
+blob changegroup::output() const
+{
+  system::error_code ec;
+  error_info ei;
+  auto res = output(ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+  return res;
+}
+
+blob invert_changeset(blob_view changeset, system::error_code & ec, error_info & ei)
+{
+  if (!check_size(changeset, ec, ei))
+    return blob();
+  int n = 0;
+  void * data = nullptr;
+  const auto cc = sqlite3changeset_invert(static_cast<int>(changeset.size()), changeset.data(), &n, &data);
+  return take_blob(cc, n, data, ec);
+}
+
+blob invert_changeset(blob_view changeset)
+{
+  system::error_code ec;
+  error_info ei;
+  auto res = invert_changeset(changeset, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+  return res;
+}
+
+namespace detail
+{
+
+void apply_changeset(sqlite3 * db, blob_view changeset,
+                     int (*conflict)(void *, int, sqlite3_changeset_iter *), void * data,
+                     system::error_code & ec, error_info & ei)
+{
+  if (!check_size(changeset, ec, ei))
+    return;
+  const auto cc = sqlite3changeset_apply(db, static_cast<int>(changeset.size()),
+                                         const_cast<void*>(changeset.data()),
+                                         nullptr, conflict, data);
+  if (cc != SQLITE_OK)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    ei.set_message(sqlite3_errmsg(db));
+  }
+}
+
+}
+
+void apply_changeset(connection_ref conn, blob_view changeset, system::error_code & ec, error_info & ei)
+{
+  apply_changeset(conn, changeset,
+                  [](conflict_type, change) noexcept { return conflict_action::abort; },
+                  ec, ei);
+}
+
+void apply_changeset(connection_ref conn, blob_view changeset)
+{
+  system::error_code ec;
+  error_info ei;
+  apply_changeset(conn, changeset, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif
@@ -0,0 +1,101 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/snapshot.hpp>
+
+#if defined(SQLITE_ENABLE_SNAPSHOT)
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace
+{
+
+sqlite3_snapshot * get_snapshot(sqlite3 * db, cstring_ref database, system::error_code & ec, error_info & ei)
+{
+  sqlite3_snapshot * s = nullptr;
+  const auto cc = sqlite3_snapshot_get(db, database.c_str(), &s);
+  if (cc != SQLITE_OK)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    ei.set_message(sqlite3_errmsg(db));
+    return nullptr;
+  }
+  return s;
+}
+
+}
+
+snapshot::snapshot(connection_ref conn, cstring_ref database)
+{
+  system::error_code ec;
+  error_info ei;
+  impl_.reset(get_snapshot(conn.handle(), database, ec, ei));
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+snapshot::snapshot(connection_ref conn, cstring_ref database, system::error_code & ec, error_info & ei)
+  : impl_(get_snapshot(conn.handle(), database, ec, ei))
+{
+}
+
+void snapshot::open(connection_ref conn, cstring_ref database, system::error_code & ec, error_info & ei) const
+{
+  if (!impl_)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, SQLITE_MISUSE);
+    ei.set_message("snapshot is empty");
+    return;
+  }
+
+  const bool begin = sqlite3_get_autocommit(conn.handle()) != 0;
+  if (begin)
+  {
+    conn.execute("BEGIN", ec, ei);
+    if (ec)
+      return;
+  }
+
+  const auto cc = sqlite3_snapshot_open(conn.handle(), database.c_str(), impl_.get());
+  if (cc != SQLITE_OK)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    ei.set_message(sqlite3_errmsg(conn.handle()));
+    if (begin)
+      sqlite3_exec(conn.handle(), "ROLLBACK", nullptr, nullptr, nullptr);
+  }
+}
+
+void snapshot::open(connection_ref conn, cstring_ref database) const
+{
+  system::error_code ec;
+  error_info ei;
+  open(conn, database, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+void snapshot::recover(connection_ref conn, cstring_ref database, system::error_code & ec, error_info & ei)
+{
+  const auto cc = sqlite3_snapshot_recover(conn.handle(), database.c_str());
+  if (cc != SQLITE_OK)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    ei.set_message(sqlite3_errmsg(conn.handle()));
+  }
+}
+
+void snapshot::recover(connection_ref conn, cstring_ref database)
+{
+  system::error_code ec;
+  error_info ei;
+  recover(conn, database, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+BOOST_SQLITE_END_NAMESPACE
+
+#endif
@@ -0,0 +1,438 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/statistics.hpp>
+#include <boost/sqlite/function.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+
+namespace statistics
+{
+
+void order_statistic::update(std::uint32_t n) noexcept
+{
+  auto & nd = nodes_[n];
+  nd.size = static_cast<std::uint32_t>(1u + size_of(nd.left) + size_of(nd.right));
+}
+
+// the nodes below `x` go to `left`, the others to `right`.
+void order_statistic::split(std::uint32_t n, double x, std::uint32_t & left, std::uint32_t & right) noexcept
+{
+  if (n == npos)
+  {
+    left = right = npos;
+    return;
+  }
+  if (nodes_[n].value < x)
+  {
+    split(nodes_[n].right, x, nodes_[n].right, right);
+    left = n;
+  }
+  else
+  {
+    split(nodes_[n].left, x, left, nodes_[n].left);
+    right = n;
+  }
+  update(n);
+}
+
+// all values of `left` are less or equal to those of `right`.
+std::uint32_t order_statistic::join(std::uint32_t left, std::uint32_t right) noexcept
+{
+  if (left == npos)
+    return right;
+  if (right == npos)
+    return left;
+  if (nodes_[left].priority > nodes_[right].priority)
+  {
+    nodes_[left].right = join(nodes_[left].right, right);
+    update(left);
+    return left;
+  }
+  nodes_[right].left = join(left, nodes_[right].left);
+  update(right);
+  return right;
+}
+
+std::uint32_t order_statistic::insert(std::uint32_t n, std::uint32_t x) noexcept
+{
+  if (n == npos)
+    return x;
+  if (nodes_[x].priority > nodes_[n].priority)
+  {
+    split(n, nodes_[x].value, nodes_[x].left, nodes_[x].right);
+    update(x);
+    return x;
+  }
+  if (nodes_[x].value < nodes_[n].value)
+    nodes_[n].left = insert(nodes_[n].left, x);
+  else
+    nodes_[n].right = insert(nodes_[n].right, x);
+  update(n);
+  return n;
+}
+
+std::uint32_t order_statistic::erase(std::uint32_t n, double x) noexcept
+{
+  if (n == npos)
+    return npos;
+  if (x < nodes_[n].value)
+    nodes_[n].left = erase(nodes_[n].left, x);
+  else if (nodes_[n].value < x)
+    nodes_[n].right = erase(nodes_[n].right, x);
+  else
+  {
+    const auto res = join(nodes_[n].left, nodes_[n].right);
+    nodes_[n].left = free_;
+    free_ = n;
+    return res;
+  }
+  update(n);
+  return n;
+}
+
+void order_statistic::insert(double x)
+{
+  std::uint32_t n = free_;
+  if (n != npos)
+    free_ = nodes_[n].left;
+  else
+  {
+    nodes_.push_back({});
+    n = static_cast<std::uint32_t>(nodes_.size() - 1u);
+  }
+
+  // xorshift32
+  seed_ ^= seed_ << 13u;
+  seed_ ^= seed_ >> 17u;
+  seed_ ^= seed_ << 5u;
+  nodes_[n] = {x, seed_, 1u, npos, npos};
+  root_ = insert(root_, n);
+}
+
+void order_statistic::erase(double x) noexcept
+{
+  root_ = erase(root_, x);
+}
+
+double order_statistic::operator[](std::size_t n) const noexcept
+{
+  auto itr = root_;
+  while (true)
+  {
+    const auto & nd = nodes_[itr];
+    const auto left = size_of(nd.left);
+    if (n < left)
+      itr = nd.left;
+    else if (n == left)
+      return nd.value;
+    else
+    {
+      n -= left + 1u;
+      itr = nd.right;
+    }
+  }
+}
+
+optional_double order_statistic::quantile(double q) const noexcept
+{
+  if (empty())
+    return nullptr;
+  const auto sz = size();
+  const auto pos = q * static_cast<double>(sz - 1u);
+  const auto lo  = static_cast<std::size_t>(std::floor(pos));
+  if (lo + 1u >= sz)
+    return (*this)[sz - 1u];
+  const auto l = (*this)[lo];
+  return l + ((*this)[lo + 1u] - l) * (pos - static_cast<double>(lo));
+}
+
+namespace
+{
+
+constexpr double pi = 3.14159265358979323846;
+
+// the k1 scale function, which keeps the centroids at the tails small.
+double k_of_q(double q, double compression)
+{
+  return compression / (2. * pi) * std::asin(2. * q - 1.);
+}
+
+double q_of_k(double k, double compression)
+{
+  if (k >= compression / 4.)
+    return 1.;
+  return (std::sin(k * 2. * pi / compression) + 1.) / 2.;
+}
+
+struct tdigest_header
+{
+  std::uint32_t magic;
+  std::uint32_t reserved;
+  std::uint64_t count;
+  double compression, total, min, max;
+};
+
+constexpr std::uint32_t tdigest_magic = 0x31474454u; // "TDG1"
+
+}
+
+void tdigest::add(double x, double weight)
+{
+  if (total_weight() == 0.)
+    min_ = max_ = x;
+  else
+  {
+    min_ = (std::min)(min_, x);
+    max_ = (std::max)(max_, x);
+  }
+  buffer_.push_back({x, weight});
+  buffered_ += weight;
+  if (buffer_.size() >= static_cast<std::size_t>(compression_) * 5u)
+    compress();
+}
+
+void tdigest::merge(const tdigest & other)
+{
+  if (other.total_weight() == 0.)
+    return;
+  if (total_weight() == 0.)
+  {
+    min_ = other.min_;
+    max_ = other.max_;
+  }
+  else
+  {
+    min_ = (std::min)(min_, other.min_);
+    max_ = (std::max)(max_, other.max_);
+  }
+  buffer_.insert(buffer_.end(), other.centroids_.begin(), other.centroids_.end());
+  buffer_.insert(buffer_.end(), other.buffer_.begin(), other.buffer_.end());
+  buffered_ += other.total_weight();
+  compress();
+}
+
+result<void> tdigest::merge(blob_view bv)
+{
+  tdigest_header hdr;
+  if (bv.size() < sizeof(hdr))
+    return error(SQLITE_MISMATCH, "invalid tdigest");
+  std::memcpy(&hdr, bv.data(), sizeof(hdr));
+  if (hdr.magic != tdigest_magic
+      || (bv.size() - sizeof(hdr)) / sizeof(centroid) != hdr.count
+      || (bv.size() - sizeof(hdr)) % sizeof(centroid) != 0u)
+    return error(SQLITE_MISMATCH, "invalid tdigest");
+
+  if (hdr.count == 0u)
+    return {};
+
+  const auto offset = buffer_.size();
+  buffer_.resize(offset + static_cast<std::size_t>(hdr.count));
+  std::memcpy(buffer_.data() + offset,
+              static_cast<const char*>(bv.data()) + sizeof(hdr),
+              static_cast<std::size_t>(hdr.count) * sizeof(centroid));
+
+  // the total of the header isn't trusted, it's summed from the centroids.
+  double weight = 0.;
+  for (auto itr = buffer_.begin() + static_cast<std::ptrdiff_t>(offset); itr != buffer_.end(); itr++)
+  {
+    if (!std::isfinite(itr->mean) || !std::isfinite(itr->weight) || !(itr->weight > 0.))
+    {
+      buffer_.resize(offset);
+      return error(SQLITE_MISMATCH, "invalid tdigest");
+    }
+    weight += itr->weight;
+  }
+  if (!std::isfinite(weight))
+  {
+    buffer_.resize(offset);
+    return error(SQLITE_MISMATCH, "invalid tdigest");
+  }
+
+  const auto mm = std::minmax_element(buffer_.begin() + static_cast<std::ptrdiff_t>(offset), buffer_.end(),
+                                      [](const centroid & l, const centroid & r) {return l.mean < r.mean;});
+  // the extremes are only approximated by the centroids, so the header is used if it's consistent with them.
+  const auto lo = std::isfinite(hdr.min) && hdr.min <= mm.first->mean  ? hdr.min : mm.first->mean;
+  const auto hi = std::isfinite(hdr.max) && hdr.max >= mm.second->mean ? hdr.max : mm.second->mean;
+  if (total_weight() == 0.)
+  {
+    min_ = lo;
+    max_ = hi;
+  }
+  else
+  {
+    min_ = (std::min)(min_, lo);
+    max_ = (std::max)(max_, hi);
+  }
+
+  buffered_ += weight;
+  compress();
+  return {};
+}
+
+void tdigest::compress()
+{
+  if (buffer_.empty())
+    return;
+
+  buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+  std::sort(buffer_.begin(), buffer_.end(),
+            [](const centroid & l, const centroid & r) {return l.mean < r.mean;});
+
+  total_ += buffered_;
+  buffered_ = 0.;
+  centroids_.clear();
+
+  auto cur = buffer_.front();
+  double q0 = 0.;
+  double q_limit = q_of_k(k_of_q(q0, compression_) + 1., compression_);
+  for (auto itr = std::next(buffer_.begin()); itr != buffer_.end(); itr++)
+  {
+    const auto q = q0 + (cur.weight + itr->weight) / total_;
+    if (q <= q_limit)
+    {
+      cur.weight += itr->weight;
+      cur.mean += (itr->mean - cur.mean) * itr->weight / cur.weight;
+    }
+    else
+    {
+      centroids_.push_back(cur);
+      q0 += cur.weight / total_;
+      q_limit = q_of_k(k_of_q(q0, compression_) + 1., compression_);
+      cur = *itr;
+    }
+  }
+  centroids_.push_back(cur);
+  buffer_.clear();
+}
+
+optional_double tdigest::quantile(double q)
+{
+  compress();
+  if (centroids_.empty())
+    return nullptr;
+  if (centroids_.size() == 1u)
+    return centroids_.front().mean;
+
+  const auto index = q * total_;
+  const auto & first = centroids_.front();
+  if (index < first.weight / 2.)
+    return min_ + (first.mean - min_) * index / (first.weight / 2.);
+
+  auto cum = first.weight / 2.;
+  for (std::size_t i = 0u; i + 1u < centroids_.size(); i++)
+  {
+    const auto & l = centroids_[i];
+    const auto & r = centroids_[i + 1u];
+    const auto dw = (l.weight + r.weight) / 2.;
+    if (cum + dw > index)
+      return l.mean + (r.mean - l.mean) * (index - cum) / dw;
+    cum += dw;
+  }
+
+  const auto & last = centroids_.back();
+  const auto t = (std::min)(1., (index - cum) / (last.weight / 2.));
+  return last.mean + (max_ - last.mean) * t;
+}
+
+blob tdigest::to_blob()
+{
+  compress();
+  tdigest_header hdr{tdigest_magic, 0u, centroids_.size(), compression_, total_, min_, max_};
+  blob res{sizeof(hdr) + centroids_.size() * sizeof(centroid)};
+  std::memcpy(res.data(), &hdr, sizeof(hdr));
+  if (!centroids_.empty())
+    std::memcpy(static_cast<char*>(res.data()) + sizeof(hdr), centroids_.data(),
+                centroids_.size() * sizeof(centroid));
+  return res;
+}
+
+namespace
+{
+
+result<void> read_quantile(double & q, const value & v)
+{
+  const auto nq = v.get_double();
+  if (q < 0.)
+  {
+    if (!(nq >= 0. && nq <= 1.))
+      return error(SQLITE_RANGE, "quantile must be in [0, 1]");
+    q = nq;
+  }
+  else if (nq != q)
+    return error(SQLITE_MISUSE, "quantile must be constant");
+  return {};
+}
+
+}
+
+result<void> percentile_cont::step(span<sqlite::value, 2u> args)
+{
+  auto res = read_quantile(q, args[1]);
+  if (res && !args[0].is_null())
+    state.insert(args[0].get_double());
+  return res;
+}
+
+result<void> approx_percentile::step(span<sqlite::value, 2u> args)
+{
+  auto res = read_quantile(q, args[1]);
+  if (res && !args[0].is_null())
+    state.add(args[0].get_double());
+  return res;
+}
+
+}
+
+void create_statistics_functions(connection_ref conn, system::error_code & ec, error_info & ei)
+{
+  using namespace statistics;
+  const auto flags = deterministic;
+  create_window_function<var_samp>   (conn, "var_samp",    std::tuple<>{}, flags, ec);
+  if (!ec) create_window_function<var_pop>    (conn, "var_pop",     std::tuple<>{}, flags, ec);
+  if (!ec) create_window_function<stddev_samp>(conn, "stddev_samp", std::tuple<>{}, flags, ec);
+  if (!ec) create_window_function<stddev_pop> (conn, "stddev_pop",  std::tuple<>{}, flags, ec);
+  if (!ec) create_window_function<covar_samp> (conn, "covar_samp",  std::tuple<>{}, flags, ec);
+  if (!ec) create_window_function<covar_pop>  (conn, "covar_pop",   std::tuple<>{}, flags, ec);
+  if (!ec) create_window_function<corr>       (conn, "corr",        std::tuple<>{}, flags, ec);
+  if (!ec) create_window_function<median>     (conn, "median",      std::tuple<>{}, flags, ec);
+  if (!ec) create_window_function<percentile_cont>(conn, "percentile_cont", std::tuple<>{}, flags, ec);
+  if (!ec) create_aggregate_function<tdigest_function>(conn, "tdigest", std::tuple<>{}, flags, ec, ei);
+  if (!ec) create_aggregate_function<tdigest_merge>(conn, "tdigest_merge", std::tuple<>{}, flags, ec, ei);
+  if (!ec) create_aggregate_function<approx_percentile>(conn, "approx_percentile", std::tuple<>{}, flags, ec, ei);
+  if (!ec)
+    create_scalar_function(
+      conn, "tdigest_quantile",
+      [](blob_view digest, double q) -> result<optional_double>
+      {
+        if (!(q >= 0. && q <= 1.))
+          return error(SQLITE_RANGE, "quantile must be in [0, 1]");
+        tdigest td;
+        auto res = td.merge(digest);
+        if (res.has_error())
+          return std::move(res).error();
+        return td.quantile(q);
+      }, flags, ec, ei);
+
+  if (ec && ei.message().empty())
+    ei.set_message(sqlite3_errmsg(conn.handle()));
+}
+
+void create_statistics_functions(connection_ref conn)
+{
+  system::error_code ec;
+  error_info ei;
+  create_statistics_functions(conn, ec, ei);
+  if (ec)
+    detail::throw_error_code(ec, ei);
+}
+
+BOOST_SQLITE_END_NAMESPACE
@@ -0,0 +1,167 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/transaction.hpp>
+#include <boost/sqlite/detail/exception.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+BOOST_SQLITE_BEGIN_NAMESPACE
+namespace detail
+{
+
+struct control_statements
+{
+  // statements for more names than this get prepared for every use.
+  constexpr static std::size_t max_savepoints = 16u;
+
+  struct savepoint_statements
+  {
+    std::string name;
+    // savepoint, release, rollback to
+    std::array<statement, 3u> stmts;
+  };
+
+  sqlite3 * db;
+  // indexed by control_op, up to & including rollback.
+  std::array<statement, 6u> transaction;
+  std::vector<savepoint_statements> savepoints;
+};
+
+void control_statements_deleter::operator()(control_statements * cs) const noexcept
+{
+  delete cs;
+}
+
+control_statements * control_statements_of(connection & conn)
+{
+  if (!conn.handle())
+    return nullptr;
+  if (!conn.control_ || conn.control_->db != conn.handle())
+    conn.control_.reset(new control_statements{conn.handle(), {}, {}});
+  return conn.control_.get();
+}
+
+namespace
+{
+
+const char * transaction_sql(control_op op)
+{
+  switch (op)
+  {
+    case control_op::begin:           return "BEGIN";
+    case control_op::begin_deferred:  return "BEGIN DEFERRED";
+    case control_op::begin_immediate: return "BEGIN IMMEDIATE";
+    case control_op::begin_exclusive: return "BEGIN EXCLUSIVE";
+    case control_op::commit:          return "COMMIT";
+    default:                          return "ROLLBACK";
+  }
+}
+
+const char * savepoint_sql(std::size_t idx)
+{
+  switch (idx)
+  {
+    case 0u: return "SAVEPOINT ";
+    case 1u: return "RELEASE ";
+    default: return "ROLLBACK TO ";
+  }
+}
+
+void step_control(sqlite3 * db, sqlite3_stmt * stmt, system::error_code & ec, error_info & ei)
+{
+  const auto cc = sqlite3_step(stmt);
+  sqlite3_reset(stmt);
+  if (cc != SQLITE_DONE)
+  {
+    BOOST_SQLITE_ASSIGN_EC(ec, cc);
+    ei.set_message(sqlite3_errmsg(db));
+  }
+}
+
+// runs the statement idx of the savepoint `name`.
+void execute_savepoint(connection_ref conn, control_statements * cache, std::size_t idx, core::string_view name,
+                       system::error_code & ec, error_info & ei)
+{
+  control_statements::savepoint_statements * sp = nullptr;
+  if (cache)
+  {
+    for (auto & s : cache->savepoints)
+      if (s.name == name)
+      {
+        sp = &s;
+        break;
+      }
+
+    if (!sp && cache->savepoints.size() < control_statements::max_savepoints)
+    {
+      cache->savepoints.push_back({std::string(name), {}});
+      sp = &cache->savepoints.back();
+    }
+  }
+
+  if (sp && sp->stmts[idx].handle())
+    return step_control(conn.handle(), sp->stmts[idx].handle(), ec, ei);
+
+  std::string sql = savepoint_sql(idx);
+  sql.append(name.data(), name.size());
+  auto stmt = conn.prepare(sql, ec, ei);
+  if (ec)
+    return;
+  step_control(conn.handle(), stmt.handle(), ec, ei);
+  if (sp)
+    sp->stmts[idx] = std::move(stmt);
+}
+
+}
+
+void execute_control(connection_ref conn, control_statements * cache,
+                     control_op op, core::string_view name,
+                     system::error_code & ec, error_info & ei)
+{
+  // the control statement would overwrite a message taken lazily from the connection.
+  ei.detach();
+  switch (op)
+  {
+    case control_op::savepoint:
+      return execute_savepoint(conn, cache, 0u, name, ec, ei);
+    case control_op::release:
+      return execute_savepoint(conn, cache, 1u, name, ec, ei);
+    case control_op::rollback_savepoint:
+      // rolling back to a savepoint keeps it open, so it gets released afterwards.
+      execute_savepoint(conn, cache, 2u, name, ec, ei);
+      if (!ec)
+        execute_savepoint(conn, cache, 1u, name, ec, ei);
+      return;
+    default:
+      break;
+  }
+
+  const auto idx = static_cast<std::size_t>(op);
+  if (cache && cache->transaction[idx].handle())
+    return step_control(conn.handle(), cache->transaction[idx].handle(), ec, ei);
+
+  auto stmt = conn.prepare(transaction_sql(op), ec, ei);
+  if (ec)
+    return;
+  step_control(conn.handle(), stmt.handle(), ec, ei);
+  if (cache)
+    cache->transaction[idx] = std::move(stmt);
+}
+
+void execute_control(connection_ref conn, control_statements * cache,
+                     control_op op, core::string_view name)
+{
+  system::error_code ec;
+  error_info ei;
+  execute_control(conn, cache, op, name, ec, ei);
+  if (ec)
+    throw_error_code(ec, ei);
+}
+
+}
+BOOST_SQLITE_END_NAMESPACE
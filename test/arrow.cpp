@@ -0,0 +1,202 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/arrow.hpp>
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/function.hpp>
+#include "test.hpp"
+
+#include <string>
+
+using namespace boost;
+
+namespace
+{
+
+bool is_valid(const ArrowArray & array, std::int64_t idx)
+{
+  const auto validity = static_cast<const std::uint8_t*>(array.buffers[0]);
+  return validity == nullptr || (validity[idx / 8] & (1u << (idx % 8))) != 0u;
+}
+
+std::string text_at(const ArrowArray & array, std::int64_t idx)
+{
+  const auto offsets = static_cast<const std::int64_t*>(array.buffers[1]);
+  const auto data = static_cast<const char*>(array.buffers[2]);
+  return std::string(data + offsets[idx], data + offsets[idx + 1]);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(arrow_batches)
+{
+  sqlite::connection conn(":memory:");
+  conn.execute(
+      "create table t(id integer, name text, score real, data blob, misc numeric);"
+      "insert into t values (1, 'one', 1.5, x'01', 1), (2, null, 2.5, null, 2.5), (3, 'three', null, x'0203', 3),"
+      "                     (4, 'four', 4.5, x'', 4), (5, 'five', 5.5, x'05', null);");
+
+  auto stmt = conn.prepare("select id, name, score, data, misc, id * 2 as twice from t order by id");
+  auto reader = sqlite::arrow::export_batches(stmt, 2u);
+
+  ArrowSchema schema;
+  reader.read_schema(&schema);
+  BOOST_CHECK_EQUAL(schema.format, std::string("+s"));
+  BOOST_REQUIRE_EQUAL(schema.n_children, 6);
+  const char * formats[] = {"l", "U", "g", "Z", "g", "l"};
+  const char * names[]   = {"id", "name", "score", "data", "misc", "twice"};
+  for (int i = 0; i < 6; i++)
+  {
+    BOOST_CHECK_EQUAL(schema.children[i]->format, std::string(formats[i]));
+    BOOST_CHECK_EQUAL(schema.children[i]->name, std::string(names[i]));
+    BOOST_CHECK(schema.children[i]->flags & ARROW_FLAG_NULLABLE);
+  }
+  schema.release(&schema);
+  BOOST_CHECK(schema.release == nullptr);
+
+  std::vector<std::int64_t> ids, twice;
+  std::vector<std::string> texts;
+  std::vector<double> misc;
+  std::int64_t null_names = 0;
+  ArrowArray batch;
+  std::size_t batches = 0u;
+  while (reader.read_next(&batch))
+  {
+    batches++;
+    BOOST_CHECK_LE(batch.length, 2);
+    BOOST_REQUIRE_EQUAL(batch.n_children, 6);
+    const auto & id = *batch.children[0];
+    const auto & name = *batch.children[1];
+    BOOST_CHECK_EQUAL(id.n_buffers, 2);
+    BOOST_CHECK_EQUAL(name.n_buffers, 3);
+    for (std::int64_t i = 0; i < batch.length; i++)
+    {
+      ids.push_back(static_cast<const std::int64_t*>(id.buffers[1])[i]);
+      twice.push_back(static_cast<const std::int64_t*>(batch.children[5]->buffers[1])[i]);
+      misc.push_back(static_cast<const double*>(batch.children[4]->buffers[1])[i]);
+      texts.push_back(is_valid(name, i) ? text_at(name, i) : "<null>");
+    }
+    null_names += name.null_count;
+
+    // a consumer may move a child out & release it separately
+    ArrowArray moved = *batch.children[3];
+    batch.children[3]->release = nullptr;
+    batch.release(&batch);
+    BOOST_CHECK(batch.release == nullptr);
+    moved.release(&moved);
+  }
+  BOOST_CHECK(batch.release == nullptr);
+
+  BOOST_CHECK_EQUAL(batches, 3u);
+  BOOST_CHECK(ids == (std::vector<std::int64_t>{1, 2, 3, 4, 5}));
+  BOOST_CHECK(twice == (std::vector<std::int64_t>{2, 4, 6, 8, 10}));
+  BOOST_CHECK(misc == (std::vector<double>{1., 2.5, 3., 4., 0.}));
+  BOOST_CHECK(texts == (std::vector<std::string>{"one", "<null>", "three", "four", "five"}));
+  BOOST_CHECK_EQUAL(null_names, 1);
+}
+
+BOOST_AUTO_TEST_CASE(arrow_stream)
+{
+  sqlite::connection conn(":memory:");
+  ArrowArrayStream stream;
+  sqlite::arrow::export_stream(
+      conn.prepare("with recursive c(i) as (select 1 union all select i + 1 from c where i < 1000) "
+                   "select i, 'v' || i from c"),
+      128u, &stream);
+
+  ArrowSchema schema;
+  BOOST_REQUIRE_EQUAL(stream.get_schema(&stream, &schema), 0);
+  BOOST_CHECK_EQUAL(schema.children[0]->format, std::string("l"));
+  BOOST_CHECK_EQUAL(schema.children[1]->format, std::string("U"));
+  schema.release(&schema);
+
+  std::int64_t rows = 0, sum = 0;
+  ArrowArray batch;
+  while (stream.get_next(&stream, &batch) == 0 && batch.release != nullptr)
+  {
+    const auto values = static_cast<const std::int64_t*>(batch.children[0]->buffers[1]);
+    for (std::int64_t i = 0; i < batch.length; i++)
+      sum += values[i];
+    BOOST_CHECK_EQUAL(text_at(*batch.children[1], batch.length - 1), "v" + std::to_string(values[batch.length - 1]));
+    rows += batch.length;
+    batch.release(&batch);
+  }
+  BOOST_CHECK_EQUAL(rows, 1000);
+  BOOST_CHECK_EQUAL(sum, 500500);
+  BOOST_CHECK(stream.get_last_error(&stream) == nullptr);
+  stream.release(&stream);
+  BOOST_CHECK(stream.release == nullptr);
+
+  sqlite::arrow::export_stream(conn.prepare("select abs(-9223372036854775807 - 1)"), 16u, &stream);
+  BOOST_CHECK_NE(stream.get_schema(&stream, &schema), 0);
+  BOOST_CHECK(stream.get_last_error(&stream) != nullptr);
+  stream.release(&stream);
+}
+
+BOOST_AUTO_TEST_CASE(arrow_batches_error)
+{
+  sqlite::connection conn(":memory:");
+  conn.execute(
+      "create table t(i integer);"
+      "with recursive c(i) as (select 1 union all select i + 1 from c where i < 1000) insert into t select i from c;");
+
+  int calls = 0;
+  sqlite::create_scalar_function(
+      conn, "fail_at_3",
+      [&calls](sqlite3_int64 i) -> sqlite::result<sqlite3_int64>
+      {
+        calls++;
+        if (i == 3)
+          return sqlite::error(SQLITE_CONSTRAINT, "row 3");
+        return i;
+      });
+
+  // typed column, so the rows get read in read_next
+  {
+    auto stmt = conn.prepare("select i from t where fail_at_3(i) order by i");
+    auto reader = sqlite::arrow::export_batches(stmt, 1000u);
+    ArrowSchema schema;
+    reader.read_schema(&schema);
+    schema.release(&schema);
+
+    system::error_code ec;
+    sqlite::error_info ei;
+    ArrowArray batch;
+    BOOST_CHECK(!reader.read_next(&batch, ec, ei));
+    BOOST_CHECK_EQUAL(ec.value(), SQLITE_CONSTRAINT);
+    BOOST_CHECK_EQUAL(calls, 3);
+
+    // the reader stays failed, instead of restarting the statement.
+    ec.clear();
+    ei.clear();
+    BOOST_CHECK(!reader.read_next(&batch, ec, ei));
+    BOOST_CHECK(batch.release == nullptr);
+    BOOST_CHECK_EQUAL(ec.value(), SQLITE_CONSTRAINT);
+    BOOST_CHECK_EQUAL(ei.message(), "row 3");
+    BOOST_CHECK_EQUAL(calls, 3);
+  }
+
+  // untyped column, so the first batch gets read to derive the type
+  calls = 0;
+  {
+    auto stmt = conn.prepare("select fail_at_3(i) from t order by i");
+    auto reader = sqlite::arrow::export_batches(stmt, 1000u);
+    system::error_code ec;
+    sqlite::error_info ei;
+    ArrowSchema schema;
+    reader.read_schema(&schema, ec, ei);
+    BOOST_CHECK_EQUAL(ec.value(), SQLITE_CONSTRAINT);
+    BOOST_CHECK_EQUAL(calls, 3);
+
+    // no partial batch is buffered or read again.
+    ec.clear();
+    ArrowArray batch;
+    BOOST_CHECK(!reader.read_next(&batch, ec, ei));
+    BOOST_CHECK_EQUAL(ec.value(), SQLITE_CONSTRAINT);
+    reader.read_schema(&schema, ec, ei);
+    BOOST_CHECK(schema.release == nullptr);
+    BOOST_CHECK_EQUAL(calls, 3);
+  }
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/arrow_table.hpp>
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/iterator.hpp>
+#include "test.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace boost;
+
+namespace
+{
+
+std::vector<std::string> texts(sqlite::connection & conn, const std::string & sql)
+{
+  std::vector<std::string> res;
+  auto st = conn.prepare(sql);
+  for (auto r : sqlite::statement_range<sqlite::row>(st))
+    res.push_back(r.at(0).is_null() ? "<null>" : std::string(r.at(0).get_text()));
+  return res;
+}
+
+// A single batch with int32, utf8, boolean & float32 columns, built by hand.
+struct test_stream
+{
+  std::int32_t ids[5] = {0, 1, 2, 3, 4};
+  std::uint8_t id_validity[1] = {0x1Bu}; // id 2 is null
+  std::int32_t offsets[6] = {0, 5, 9, 9, 14, 19};
+  char names[20] = "alphabetagammadelta";
+  std::uint8_t flags[1] = {0x05u};
+  float reals[5] = {0.5f, 1.5f, 2.5f, 3.5f, 4.5f};
+
+  const void * id_buffers[2]   = {id_validity, ids};
+  const void * name_buffers[3] = {nullptr, offsets, names};
+  const void * flag_buffers[2] = {nullptr, flags};
+  const void * real_buffers[2] = {nullptr, reals};
+  const void * struct_buffers[1] = {nullptr};
+
+  ArrowArray children[4];
+  ArrowArray * child_ptrs[4] = {&children[0], &children[1], &children[2], &children[3]};
+  ArrowSchema fields[4];
+  ArrowSchema * field_ptrs[4] = {&fields[0], &fields[1], &fields[2], &fields[3]};
+  bool sent = false;
+  int released = 0;
+
+  static void noop(ArrowArray * a) { a->release = nullptr; }
+  static void noop_schema(ArrowSchema * s) { s->release = nullptr; }
+
+  test_stream()
+  {
+    const char * formats[] = {"i", "u", "b", "f"};
+    const char * names_[]  = {"id", "name", "flag", "real"};
+    const void ** buffers[] = {id_buffers, name_buffers, flag_buffers, real_buffers};
+    for (int i = 0; i < 4; i++)
+    {
+      fields[i] = ArrowSchema{formats[i], names_[i], nullptr, ARROW_FLAG_NULLABLE, 0, nullptr, nullptr, &noop_schema, nullptr};
+      children[i] = ArrowArray{5, i == 0 ? 1 : 0, 0, i == 1 ? 3 : 2, 0, buffers[i], nullptr, nullptr, &noop, nullptr};
+    }
+  }
+
+  void export_to(ArrowArrayStream * out)
+  {
+    out->private_data = this;
+    out->get_schema = +[](ArrowArrayStream * s, ArrowSchema * schema)
+    {
+      auto & self = *static_cast<test_stream*>(s->private_data);
+      *schema = ArrowSchema{"+s", "", nullptr, 0, 4, self.field_ptrs, nullptr, &noop_schema, nullptr};
+      return 0;
+    };
+    out->get_next = +[](ArrowArrayStream * s, ArrowArray * array)
+    {
+      auto & self = *static_cast<test_stream*>(s->private_data);
+      if (self.sent)
+        array->release = nullptr;
+      else
+        *array = ArrowArray{5, 0, 0, 1, 4, self.struct_buffers, self.child_ptrs, nullptr,
+                            +[](ArrowArray * a) { a->release = nullptr; }, nullptr};
+      self.sent = true;
+      return 0;
+    };
+    out->get_last_error = +[](ArrowArrayStream *) -> const char * { return nullptr; };
+    out->release = +[](ArrowArrayStream * s)
+    {
+      static_cast<test_stream*>(s->private_data)->released++;
+      s->release = nullptr;
+    };
+  }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(arrow_table)
+{
+  test_stream ts;
+  ArrowArrayStream stream;
+  ts.export_to(&stream);
+
+  sqlite::connection conn(":memory:");
+  sqlite::create_module(conn, "items", sqlite::vtab::arrow_module(&stream));
+  BOOST_CHECK(stream.release == nullptr);
+  BOOST_CHECK_EQUAL(ts.released, 1);
+
+  using v = std::vector<std::string>;
+  BOOST_CHECK(texts(conn, "select name from items") == (v{"alpha", "beta", "", "gamma", "delta"}));
+  BOOST_CHECK(texts(conn, "select id from items") == (v{"0", "1", "<null>", "3", "4"}));
+  BOOST_CHECK(texts(conn, "select name from items where flag") == (v{"alpha", ""}));
+  BOOST_CHECK(texts(conn, "select name from items where id >= 1 and id < 4") == (v{"beta", "gamma"}));
+  BOOST_CHECK(texts(conn, "select name from items where id = 1.5").empty());
+  BOOST_CHECK(texts(conn, "select id from items where name = 'gamma'") == (v{"3"}));
+  BOOST_CHECK(texts(conn, "select id from items where name = 'GAMMA' collate nocase") == (v{"3"}));
+  BOOST_CHECK(texts(conn, "select name from items where real > 2") == (v{"", "gamma", "delta"}));
+  BOOST_CHECK(texts(conn, "select name from items where real = 1.5") == (v{"beta"}));
+  BOOST_CHECK(texts(conn, "select count(*) from items a join items b on a.id = b.id") == (v{"4"}));
+  BOOST_CHECK(texts(conn, "select typeof(real) || typeof(flag) from items limit 1") == (v{"realinteger"}));
+}
+
+BOOST_AUTO_TEST_CASE(arrow_round_trip)
+{
+  sqlite::connection src(":memory:");
+  src.execute(
+      "create table t(id integer, name text, score real, data blob);"
+      "with recursive c(i) as (select 1 union all select i + 1 from c where i < 1000) "
+      "insert into t select i, 'n' || i, i * 0.5, case when i % 10 = 0 then null else x'00ff' end from c;");
+
+  ArrowArrayStream stream;
+  sqlite::arrow::export_stream(src.prepare("select * from t"), 128u, &stream);
+
+  sqlite::vtab::arrow_batches batches;
+  batches.import(&stream);
+  BOOST_CHECK_EQUAL(batches.size(), 1000u);
+  BOOST_CHECK_EQUAL(batches.batch_count(), 8u);
+  BOOST_CHECK_EQUAL(batches.column_count(), 4u);
+  BOOST_CHECK(batches.column_kind(1) == sqlite::vtab::arrow_batches::kind::large_utf8);
+
+  sqlite::connection conn(":memory:");
+  sqlite::create_module(conn, "t", sqlite::vtab::arrow_module(std::move(batches)));
+
+  using v = std::vector<std::string>;
+  BOOST_CHECK(texts(conn, "select sum(id) from t") == (v{"500500"}));
+  BOOST_CHECK(texts(conn, "select name from t where id = 777") == (v{"n777"}));
+  BOOST_CHECK(texts(conn, "select count(*) from t where score between 100 and 200") == (v{"201"}));
+  BOOST_CHECK(texts(conn, "select count(*) from t where data is null") == (v{"100"}));
+  BOOST_CHECK(texts(conn, "select hex(data) from t where rowid = 128") == (v{"00FF"}));
+}
@@ -0,0 +1,197 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/busy.hpp>
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/hooks.hpp>
+#include "test.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <thread>
+
+using namespace boost;
+
+namespace
+{
+
+struct busy_db
+{
+  const char * name = "boost_sqlite_busy.db";
+  busy_db()
+  {
+    clear();
+    sqlite::connection conn{name};
+    conn.execute("create table t(id integer primary key, x integer unique);");
+  }
+  ~busy_db()
+  {
+    clear();
+  }
+  void clear()
+  {
+    std::remove(name);
+    std::remove("boost_sqlite_busy.db-journal");
+  }
+};
+
+std::uint64_t sum(const std::array<std::uint64_t, sqlite::lock_wait_metrics::buckets> & histogram)
+{
+  return std::accumulate(histogram.begin(), histogram.end(), std::uint64_t(0u));
+}
+
+sqlite3_int64 count_rows(sqlite::connection & conn)
+{
+  auto st = conn.prepare("select count(*) from t");
+  st.step();
+  return st.current().at(0).get_int();
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(busy_handler)
+{
+  busy_db db;
+  sqlite::connection holder{db.name}, conn{db.name};
+  holder.execute("begin immediate");
+
+  int calls = 0;
+  auto handler = [&](int count) noexcept
+  {
+    BOOST_CHECK_EQUAL(count, calls);
+    return ++calls < 4;
+  };
+  sqlite::busy_handler(conn, handler);
+
+  system::error_code ec;
+  sqlite::error_info ei;
+  conn.execute("begin immediate", ec, ei);
+  BOOST_CHECK_EQUAL(ec.value(), SQLITE_BUSY);
+  BOOST_CHECK_EQUAL(calls, 4);
+
+  sqlite::busy_handler(conn, nullptr);
+  calls = 0;
+  ec.clear();
+  conn.execute("begin immediate", ec, ei);
+  BOOST_CHECK_EQUAL(ec.value(), SQLITE_BUSY);
+  BOOST_CHECK_EQUAL(calls, 0);
+  holder.execute("commit");
+}
+
+BOOST_AUTO_TEST_CASE(backoff_busy_handler)
+{
+  busy_db db;
+  sqlite::connection holder{db.name}, conn{db.name};
+
+  sqlite::backoff_options opts;
+  opts.initial_delay = std::chrono::milliseconds(1);
+  opts.max_delay = std::chrono::milliseconds(4);
+  opts.timeout = std::chrono::milliseconds(20);
+  sqlite::backoff_busy_handler backoff{opts};
+  sqlite::busy_handler(conn, backoff);
+
+  holder.execute("begin immediate");
+  system::error_code ec;
+  sqlite::error_info ei;
+  conn.execute("begin immediate", ec, ei);
+  BOOST_CHECK_EQUAL(ec.value(), SQLITE_BUSY);
+
+  auto m = backoff.metrics();
+  BOOST_CHECK_EQUAL(m.waits, 1u);
+  BOOST_CHECK_EQUAL(m.timeouts, 1u);
+  BOOST_CHECK_GT(m.retries, 1u);
+  BOOST_CHECK_EQUAL(sum(m.retry_histogram), 1u);
+  BOOST_CHECK_EQUAL(sum(m.wait_histogram), 1u);
+  // waited for the whole timeout, i.e. at least 16ms
+  BOOST_CHECK_EQUAL(std::accumulate(m.wait_histogram.begin() + 4, m.wait_histogram.end(), std::uint64_t(0u)), 1u);
+
+  // released while waiting
+  std::thread releaser{[&]{ std::this_thread::sleep_for(std::chrono::milliseconds(5)); holder.execute("commit"); }};
+  ec.clear();
+  opts.timeout = std::chrono::seconds(10);
+  sqlite::backoff_busy_handler patient{opts};
+  sqlite::busy_handler(conn, patient);
+  conn.execute("begin immediate", ec, ei);
+  releaser.join();
+  BOOST_CHECK(!ec);
+  conn.execute("commit");
+
+  m = patient.metrics();
+  BOOST_CHECK_EQUAL(m.waits, 1u);
+  BOOST_CHECK_EQUAL(m.timeouts, 0u);
+  BOOST_CHECK_GT(m.retries, 0u);
+  BOOST_CHECK_EQUAL(sum(m.retry_histogram), 1u);
+  BOOST_CHECK_EQUAL(sum(m.wait_histogram), 1u);
+
+  sqlite::busy_timeout(conn, std::chrono::milliseconds(0));
+}
+
+BOOST_AUTO_TEST_CASE(with_retry)
+{
+  busy_db db;
+  sqlite::connection conn{db.name};
+
+  sqlite::retry_options opts;
+  opts.backoff.initial_delay = std::chrono::milliseconds(1);
+  opts.backoff.max_delay = std::chrono::milliseconds(2);
+
+  // a transient error rolls back & reruns the whole block
+  int runs = 0;
+  sqlite::with_retry(
+      conn,
+      [&]
+      {
+        conn.execute("insert into t(x) values (1)");
+        if (++runs == 1)
+          throw system::system_error(system::error_code(SQLITE_BUSY_SNAPSHOT, sqlite::sqlite_category()));
+      }, opts);
+  BOOST_CHECK_EQUAL(runs, 2);
+  BOOST_CHECK_EQUAL(count_rows(conn), 1);
+  BOOST_CHECK(conn.handle() != nullptr && sqlite3_get_autocommit(conn.handle()));
+
+  // other errors are not retried
+  runs = 0;
+  BOOST_CHECK_THROW(
+      sqlite::with_retry(conn, [&]{ runs++; conn.execute("insert into t(x) values (1)"); }, opts),
+      system::system_error);
+  BOOST_CHECK_EQUAL(runs, 1);
+  BOOST_CHECK(sqlite3_get_autocommit(conn.handle()));
+
+  // a lazy message of func survives the rollback
+  {
+    system::error_code ec;
+    sqlite::error_info ei;
+    ei.set_lazy();
+    sqlite::with_retry(
+        conn,
+        [&](system::error_code & ec, sqlite::error_info & ei)
+        {
+          conn.prepare("select abs(-9223372036854775807 - 1)").execute(std::make_tuple(), ec, ei);
+        }, opts, ec, ei);
+    BOOST_CHECK_EQUAL(ec.value(), SQLITE_ERROR);
+    BOOST_CHECK_EQUAL(ei.message(), "integer overflow");
+    BOOST_CHECK(sqlite3_get_autocommit(conn.handle()));
+  }
+
+  // a lock that is held too long
+  sqlite::connection holder{db.name};
+  holder.execute("begin immediate");
+  opts.max_attempts = 3;
+  runs = 0;
+  system::error_code ec;
+  sqlite::error_info ei;
+  sqlite::with_retry(conn, [&](system::error_code &, sqlite::error_info &) { runs++; }, opts, ec, ei);
+  BOOST_CHECK_EQUAL(ec.value(), SQLITE_BUSY);
+  BOOST_CHECK_EQUAL(runs, 0);
+
+  // a lock that gets released
+  opts.max_attempts = 1000;
+  std::thread releaser{[&]{ std::this_thread::sleep_for(std::chrono::milliseconds(5)); holder.execute("commit"); }};
+  sqlite::with_retry(conn, [&]{ runs++; conn.execute("insert into t(x) values (2)"); }, opts);
+  releaser.join();
+  BOOST_CHECK_EQUAL(runs, 1);
+  BOOST_CHECK_EQUAL(count_rows(conn), 2);
+}
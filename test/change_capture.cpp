@@ -0,0 +1,103 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/change_capture.hpp>
+#include <boost/sqlite/connection.hpp>
+#include "test.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_CASE(change_capture)
+{
+  sqlite::connection conn(":memory:");
+  conn.execute("create table t(id integer primary key, name text);");
+
+  sqlite::change_capture cdc{4u};
+  BOOST_CHECK_EQUAL(cdc.capacity(), 4u);
+  cdc.attach(conn);
+
+  conn.execute("begin; insert into t values (1, 'a'), (2, 'b'); update t set name = 'c' where id = 2; commit;");
+  sqlite::change_batch batch;
+  BOOST_REQUIRE(cdc.try_pop(batch));
+  BOOST_CHECK(!cdc.try_pop(batch) );
+  BOOST_CHECK_EQUAL(batch.sequence, 0u);
+  BOOST_REQUIRE_EQUAL(batch.changes.size(), 3u);
+  BOOST_CHECK_EQUAL(batch.changes[0].op, SQLITE_INSERT);
+  BOOST_CHECK_EQUAL(batch.changes[0].database, "main");
+  BOOST_CHECK_EQUAL(batch.changes[0].table, "t");
+  BOOST_CHECK_EQUAL(batch.changes[1].new_rowid, 2);
+  BOOST_CHECK_EQUAL(batch.changes[2].op, SQLITE_UPDATE);
+
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+  BOOST_REQUIRE_EQUAL(batch.changes[2].old_values.size(), 2u);
+  BOOST_CHECK_EQUAL(batch.changes[2].old_values[1].get().get_text(), "b");
+  BOOST_CHECK_EQUAL(batch.changes[2].new_values[1].get().get_text(), "c");
+  BOOST_CHECK(batch.changes[0].old_values.empty());
+#endif
+
+  // rolled back changes are never published
+  conn.execute("begin; delete from t; rollback;");
+  BOOST_CHECK(!cdc.try_pop(batch));
+
+  conn.execute("delete from t where id = 1;");
+  BOOST_REQUIRE(cdc.try_pop(batch));
+  BOOST_CHECK_EQUAL(batch.sequence, 1u);
+  BOOST_REQUIRE_EQUAL(batch.changes.size(), 1u);
+  BOOST_CHECK_EQUAL(batch.changes[0].op, SQLITE_DELETE);
+  BOOST_CHECK_EQUAL(batch.changes[0].old_rowid, 1);
+
+  // a full ring drops the batch
+  for (int i = 0; i < 5; i++)
+    conn.execute("insert into t(name) values ('x');");
+  BOOST_CHECK_EQUAL(cdc.dropped(), 1u);
+  std::vector<std::uint64_t> seqs;
+  BOOST_CHECK_EQUAL(cdc.drain([&](sqlite::change_batch && b) { seqs.push_back(b.sequence); }), 4u);
+  BOOST_CHECK(seqs == (std::vector<std::uint64_t>{2u, 3u, 4u, 5u}));
+
+  cdc.detach(conn);
+  conn.execute("insert into t(name) values ('y');");
+  BOOST_CHECK(!cdc.try_pop(batch));
+}
+
+BOOST_AUTO_TEST_CASE(change_capture_concurrent)
+{
+  sqlite::connection conn(":memory:");
+  conn.execute("create table t(id integer primary key, value integer);");
+
+  sqlite::change_capture cdc{64u};
+  cdc.attach(conn, false);
+
+  constexpr std::size_t commits = 2000u;
+  std::atomic<bool> done{false};
+  std::size_t changes = 0u, batches = 0u;
+  bool ordered = true;
+  std::thread consumer{[&]
+  {
+    std::uint64_t last = 0u;
+    const auto consume = [&](sqlite::change_batch && b)
+    {
+      ordered &= batches == 0u || b.sequence > last;
+      last = b.sequence;
+      changes += b.changes.size();
+      batches++;
+    };
+    while (!done.load())
+      if (cdc.drain(consume) == 0u)
+        std::this_thread::yield();
+    cdc.drain(consume);
+  }};
+
+  for (std::size_t i = 0u; i < commits; i++)
+    conn.execute("begin; insert into t(value) values (1); insert into t(value) values (2); commit;");
+  done = true;
+  consumer.join();
+
+  BOOST_CHECK(ordered);
+  BOOST_CHECK_EQUAL(batches + cdc.dropped(), commits);
+  BOOST_CHECK_EQUAL(changes, batches * 2u);
+}
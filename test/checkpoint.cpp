@@ -0,0 +1,124 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/checkpoint.hpp>
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/hooks.hpp>
+#include "test.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using namespace boost;
+
+namespace
+{
+
+struct wal_db
+{
+  const char * name = "boost_sqlite_checkpoint.db";
+  wal_db()
+  {
+    clear();
+    sqlite::connection conn{name};
+    conn.execute("pragma journal_mode=wal; create table t(id integer primary key, data blob);");
+  }
+  ~wal_db()
+  {
+    clear();
+  }
+  void clear()
+  {
+    std::remove(name);
+    std::remove("boost_sqlite_checkpoint.db-wal");
+    std::remove("boost_sqlite_checkpoint.db-shm");
+  }
+};
+
+template<typename Pred>
+bool wait_for(Pred pred)
+{
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!pred())
+  {
+    if (std::chrono::steady_clock::now() > deadline)
+      return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(wal_checkpoint)
+{
+  wal_db db;
+  sqlite::connection conn{db.name};
+
+  int last_pages = 0;
+  auto hk = [&](const char * db_name, int pages) noexcept
+  {
+    BOOST_CHECK_EQUAL(db_name, "main");
+    last_pages = pages;
+  };
+  sqlite::wal_hook(conn, hk);
+  conn.execute("insert into t(data) values (zeroblob(10000))");
+  BOOST_CHECK_GT(last_pages, 0);
+
+  auto res = sqlite::wal_checkpoint(conn);
+  BOOST_CHECK_EQUAL(res.log_frames, last_pages);
+  BOOST_CHECK_EQUAL(res.checkpointed_frames, last_pages);
+
+  res = sqlite::wal_checkpoint(conn, sqlite::checkpoint_mode::truncate);
+  BOOST_CHECK_EQUAL(res.log_frames, 0);
+
+  sqlite::wal_autocheckpoint(conn, 1);
+  conn.execute("insert into t(data) values (zeroblob(10000))");
+  // the auto checkpoint replaced the hook & checkpointed the log
+  res = sqlite::wal_checkpoint(conn);
+  BOOST_CHECK_EQUAL(res.log_frames, res.checkpointed_frames);
+
+  sqlite::connection mem{":memory:"};
+  res = sqlite::wal_checkpoint(mem);
+  BOOST_CHECK_EQUAL(res.log_frames, -1);
+}
+
+BOOST_AUTO_TEST_CASE(checkpoint_manager)
+{
+  wal_db db;
+  sqlite::connection writer{db.name};
+
+  sqlite::checkpoint_options opts;
+  opts.passive_frames = 1;
+  opts.restart_frames = 1000;
+  opts.truncate_frames = 40;
+  opts.interval = std::chrono::milliseconds(0);
+  opts.busy_timeout = std::chrono::milliseconds(10);
+  sqlite::checkpoint_manager mgr{db.name, opts};
+  mgr.attach(writer);
+
+  writer.execute("insert into t(data) values (zeroblob(1000))");
+  BOOST_CHECK(wait_for([&]{ return mgr.metrics().passive > 0u; }));
+  BOOST_CHECK_EQUAL(mgr.metrics().truncate, 0u);
+
+  // an open read transaction keeps the log from being reset, so it grows until a truncate gets attempted
+  sqlite::connection reader{db.name};
+  reader.execute("begin; select count(*) from t;");
+  auto st = reader.prepare("select * from t");
+  st.step();
+  writer.execute("insert into t(data) values (zeroblob(400000))");
+  BOOST_CHECK(wait_for([&]{ return mgr.metrics().truncate > 0u; }));
+  BOOST_CHECK(wait_for([&]{ return mgr.metrics().failed > 0u; }));
+  BOOST_CHECK_GE(mgr.metrics().log_frames, opts.truncate_frames);
+
+  st = sqlite::statement{};
+  reader.execute("commit");
+  mgr.request();
+  BOOST_CHECK(wait_for([&]{ return mgr.metrics().log_frames == 0; }));
+
+  mgr.detach(writer);
+  mgr.stop();
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/columnar_table.hpp>
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/iterator.hpp>
+#include "test.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace boost;
+
+namespace
+{
+
+std::vector<sqlite3_int64> ids(sqlite::connection & conn, const char * sql)
+{
+  std::vector<sqlite3_int64> res;
+  auto st = conn.prepare(sql);
+  for (auto r : sqlite::statement_range<sqlite::row>(st))
+    res.push_back(r.at(0).get_int());
+  return res;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(columnar_table)
+{
+  std::vector<sqlite3_int64> qty;
+  std::vector<double> price;
+  std::vector<std::string> sym;
+  for (int i = 0; i < 100; i++)
+  {
+    qty.push_back(i % 10);
+    price.push_back(i * .5);
+    sym.push_back(i % 2 ? "odd" : "even");
+  }
+
+  sqlite::vtab::column_store store;
+  store.add_column("qty",    std::move(qty));
+  store.add_column("price",  std::move(price));
+  store.add_column("symbol", std::move(sym));
+  BOOST_CHECK_THROW(store.add_column("bad", std::vector<double>(3u)), std::invalid_argument);
+
+  sqlite::connection conn(":memory:");
+  sqlite::create_module(conn, "trades", sqlite::vtab::columnar_module(store));
+
+  using v = std::vector<sqlite3_int64>;
+  BOOST_CHECK(ids(conn, "select rowid from trades where qty = 3 and price < 30;") == (v{3, 13, 23, 33, 43, 53}));
+  BOOST_CHECK(ids(conn, "select rowid from trades where price between 10 and 11.5;") == (v{20, 21, 22, 23}));
+  BOOST_CHECK(ids(conn, "select rowid from trades where price > 48 and qty >= 7.5;") == (v{98, 99}));
+  BOOST_CHECK(ids(conn, "select rowid from trades where qty in (1, 2.0, '4') and price < 10;") == (v{1, 2, 4, 11, 12, 14}));
+  BOOST_CHECK(ids(conn, "select rowid from trades where price in (0, 0.5, 1, 1.5, 2, 2.5, 3, 3.5, 4, 9.5) and qty > 4;") == (v{5, 6, 7, 8, 19}));
+  BOOST_CHECK(ids(conn, "select rowid from trades where qty = 2.5;").empty());
+  BOOST_CHECK(ids(conn, "select rowid from trades where qty > null;").empty());
+  BOOST_CHECK(ids(conn, "select rowid from trades where price > 'abc';").empty());
+  BOOST_CHECK_EQUAL(ids(conn, "select count(*) from trades where price < 'abc';").front(), 100);
+  BOOST_CHECK_EQUAL(ids(conn, "select count(*) from trades where symbol = 'odd' and qty < 5;").front(), 20);
+  BOOST_CHECK_EQUAL(ids(conn, "select count(*) from trades;").front(), 100);
+
+  auto st = conn.prepare("select qty, price, symbol from trades where rowid = 31;");
+  st.step();
+  BOOST_CHECK_EQUAL(st.current().at(0).get_int(), 1);
+  BOOST_CHECK_EQUAL(st.current().at(1).get_double(), 15.5);
+  BOOST_CHECK_EQUAL(st.current().at(2).get_text(), "odd");
+
+  // the same statement filtered with different values
+  auto p = conn.prepare("select count(*) from trades where qty = ?;");
+  for (int i = 0; i < 10; i++)
+  {
+    p.bind(1, i);
+    p.step();
+    BOOST_CHECK_EQUAL(p.current().at(0).get_int(), 10);
+    sqlite3_reset(p.handle());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(columnar_table_limit)
+{
+  std::vector<sqlite3_int64> x;
+  for (int i = 0; i < 1000; i++)
+    x.push_back(i);
+
+  sqlite::vtab::column_store store;
+  store.add_column("x", std::move(x));
+
+  sqlite::connection conn(":memory:");
+  sqlite::create_module(conn, "data", sqlite::vtab::columnar_module(store));
+
+  using v = std::vector<sqlite3_int64>;
+  BOOST_CHECK(ids(conn, "select x from data limit 3;") == (v{0, 1, 2}));
+  BOOST_CHECK(ids(conn, "select x from data limit 2 offset 998;") == (v{998, 999}));
+  BOOST_CHECK(ids(conn, "select x from data limit 2 offset 5000;").empty());
+  BOOST_CHECK(ids(conn, "select x from data where x > 500 limit 3 offset 2;") == (v{503, 504, 505}));
+  BOOST_CHECK(ids(conn, "select x from data where x in (1, 3, 5, 7) limit -1 offset 1;") == (v{3, 5, 7}));
+  BOOST_CHECK(ids(conn, "select x from data where x > 990 and x % 2 = 0 limit 2;") == (v{992, 994}));
+}
@@ -0,0 +1,140 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/container_table.hpp>
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/iterator.hpp>
+#include "test.hpp"
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace boost;
+
+namespace
+{
+
+std::vector<sqlite3_int64> ids(sqlite::connection & conn, const char * sql)
+{
+  std::vector<sqlite3_int64> res;
+  auto st = conn.prepare(sql);
+  for (auto r : sqlite::statement_range<sqlite::row>(st))
+    res.push_back(r.at(0).get_int());
+  return res;
+}
+
+std::string plan(sqlite::connection & conn, const std::string & sql)
+{
+  std::string res;
+  auto st = conn.prepare("explain query plan " + sql);
+  for (auto r : sqlite::statement_range<sqlite::row>(st))
+    res += r.at(3).get_text();
+  return res;
+}
+
+}
+
+#if BOOST_SQLITE_HAS_DESCRIBE
+
+#include <boost/describe/class.hpp>
+
+struct library
+{
+  std::string name;
+  int first_released;
+  double standard;
+};
+
+BOOST_DESCRIBE_STRUCT(library, (), (name, first_released, standard));
+
+BOOST_AUTO_TEST_CASE(container_table_describe)
+{
+  std::vector<library> libs{{"asio", 35, 98}, {"beast", 66, 11}, {"describe", 77, 14}};
+  sqlite::connection conn(":memory:");
+  sqlite::create_module(conn, "libs", sqlite::vtab::make_container_module(libs));
+
+  auto st = conn.prepare("select name, first_released, standard from libs where rowid = 1;");
+  st.step();
+  BOOST_CHECK_EQUAL(st.current().at(0).get_text(), "beast");
+  BOOST_CHECK_EQUAL(st.current().at(1).get_int(), 66);
+  BOOST_CHECK_EQUAL(st.current().at(2).get_double(), 11.);
+}
+
+#endif
+
+BOOST_AUTO_TEST_CASE(container_table_vector)
+{
+  std::vector<std::tuple<std::string, int, double>> data;
+  for (int i = 0; i < 1000; i++)
+    data.emplace_back("item-" + std::to_string(i), i * 2, i / 2.);
+
+  sqlite::connection conn(":memory:");
+  sqlite::create_module(conn, "items", sqlite::vtab::make_container_module(data));
+
+  auto st = conn.prepare("select c0, c1, c2 from items where rowid = 42;");
+  st.step();
+  BOOST_CHECK_EQUAL(st.current().at(0).get_text(), "item-42");
+  BOOST_CHECK_EQUAL(st.current().at(1).get_int(), 84);
+  BOOST_CHECK_EQUAL(st.current().at(2).get_double(), 21.);
+  BOOST_CHECK(!st.step());
+
+  using v = std::vector<sqlite3_int64>;
+  BOOST_CHECK(ids(conn, "select rowid from items where rowid between 10 and 13;") == (v{10, 11, 12, 13}));
+  BOOST_CHECK(ids(conn, "select rowid from items where rowid > 996;") == (v{997, 998, 999}));
+  BOOST_CHECK(ids(conn, "select rowid from items where rowid < 2.5;") == (v{0, 1, 2}));
+  BOOST_CHECK(ids(conn, "select rowid from items where rowid >= 1.5 and rowid < 4;") == (v{2, 3}));
+  BOOST_CHECK(ids(conn, "select rowid from items where rowid = '7';") == (v{7}));
+  BOOST_CHECK(ids(conn, "select rowid from items where rowid = 7.5;").empty());
+  BOOST_CHECK(ids(conn, "select rowid from items where rowid = 1000;").empty());
+  BOOST_CHECK(ids(conn, "select rowid from items where rowid > null;").empty());
+  BOOST_CHECK(ids(conn, "select rowid from items where rowid < 'x' and rowid > 997;") == (v{998, 999}));
+  BOOST_CHECK(ids(conn, "select rowid from items where rowid > 5 and rowid < 3;").empty());
+  BOOST_CHECK_EQUAL(ids(conn, "select count(*) from items;").front(), 1000);
+
+  BOOST_CHECK_NE(plan(conn, "select * from items where rowid = 5").find("INDEX 1:"), std::string::npos);
+  BOOST_CHECK_NE(plan(conn, "select * from items where rowid > 5 and rowid <= 10").find("INDEX 14:"), std::string::npos);
+
+  // the planner should look up the vtable by rowid in a join
+  conn.execute("create table wanted(id integer); insert into wanted values (3), (500);");
+  BOOST_CHECK_NE(plan(conn, "select c0 from wanted join items on items.rowid = wanted.id").find("INDEX 1:"), std::string::npos);
+  BOOST_CHECK(ids(conn, "select c1 from wanted join items on items.rowid = wanted.id order by wanted.id;") == (v{6, 1000}));
+
+  BOOST_CHECK_EQUAL(plan(conn, "select * from items order by rowid").find("ORDER BY"), std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(container_table_map)
+{
+  std::map<int, std::pair<std::string, double>> ordered;
+  std::unordered_map<sqlite3_int64, std::pair<std::string, double>> hashed;
+  for (int i = -50; i < 50; i++)
+  {
+    ordered.emplace(i * 10, std::make_pair(std::to_string(i), i * 1.5));
+    hashed.emplace(i * 10, std::make_pair(std::to_string(i), i * 1.5));
+  }
+
+  sqlite::connection conn(":memory:");
+  sqlite::create_module(conn, "ordered", sqlite::vtab::make_container_module(ordered));
+  sqlite::create_module(conn, "hashed", sqlite::vtab::make_container_module(hashed));
+
+  using v = std::vector<sqlite3_int64>;
+  BOOST_CHECK(ids(conn, "select rowid from ordered where rowid between -25 and 15;") == (v{-20, -10, 0, 10}));
+  BOOST_CHECK(ids(conn, "select rowid from ordered where rowid > 9999999999;").empty());
+  BOOST_CHECK(ids(conn, "select rowid from ordered where rowid < -9999999999;").empty());
+  BOOST_CHECK_EQUAL(ids(conn, "select count(*) from ordered where rowid >= -9999999999;").front(), 100);
+  BOOST_CHECK(ids(conn, "select rowid from hashed where rowid = 30;") == (v{30}));
+  BOOST_CHECK(ids(conn, "select rowid from hashed where rowid = 31;").empty());
+  BOOST_CHECK_EQUAL(ids(conn, "select count(*) from hashed where rowid between -25 and 15;").front(), 4);
+
+  auto st = conn.prepare("select c0, c1 from ordered where rowid = -40;");
+  st.step();
+  BOOST_CHECK_EQUAL(st.current().at(0).get_text(), "-4");
+  BOOST_CHECK_EQUAL(st.current().at(1).get_double(), -6.);
+
+  BOOST_CHECK_NE(plan(conn, "select * from ordered where rowid >= 5").find("INDEX 2:"), std::string::npos);
+  BOOST_CHECK_NE(plan(conn, "select * from hashed where rowid >= 5").find("INDEX 0:"), std::string::npos);
+}
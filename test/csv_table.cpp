@@ -0,0 +1,133 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/csv_table.hpp>
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/iterator.hpp>
+#include "test.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace boost;
+
+namespace
+{
+
+struct temp_file
+{
+  std::string path;
+  temp_file(std::string path, const std::string & content) : path(std::move(path))
+  {
+    std::ofstream ofs{this->path, std::ios::binary | std::ios::trunc};
+    ofs << content;
+  }
+  ~temp_file() { std::remove(path.c_str()); }
+};
+
+std::vector<std::string> texts(sqlite::connection & conn, const std::string & sql)
+{
+  std::vector<std::string> res;
+  auto st = conn.prepare(sql);
+  for (auto r : sqlite::statement_range<sqlite::row>(st))
+    res.push_back(r.at(0).is_null() ? "<null>" : std::string(r.at(0).get_text()));
+  return res;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(csv_table)
+{
+  temp_file tf{"csv_table_test.csv",
+               "\xEF\xBB\xBFid,name,comment\r\n"
+               "1,alpha,plain\r\n"
+               "2,\"beta, gamma\",\"say \"\"hi\"\"\"\r\n"
+               "3,delta,\"two\nlines\"\n"
+               "4,epsilon\n"
+               "5,zeta,last"};
+
+  sqlite::connection conn(":memory:");
+  sqlite::create_module(conn, "csv", sqlite::vtab::csv_module());
+  conn.execute("create virtual table data using csv(filename='csv_table_test.csv');");
+
+  using v = std::vector<std::string>;
+  BOOST_CHECK(texts(conn, "select name from data;") == (v{"alpha", "beta, gamma", "delta", "epsilon", "zeta"}));
+  BOOST_CHECK(texts(conn, "select comment from data;") == (v{"plain", "say \"hi\"", "two\nlines", "<null>", "last"}));
+  BOOST_CHECK(texts(conn, "select id from data where rowid = 3;") == (v{"3"}));
+  BOOST_CHECK(texts(conn, "select id from data where rowid > 3;") == (v{"4", "5"}));
+  BOOST_CHECK(texts(conn, "select id from data where rowid between 2 and 3;") == (v{"2", "3"}));
+  BOOST_CHECK(texts(conn, "select id from data where rowid = 6;").empty());
+  BOOST_CHECK(texts(conn, "select id from data where rowid > null;").empty());
+  BOOST_CHECK(texts(conn, "select id from data where rowid < null;").empty());
+  BOOST_CHECK(texts(conn, "select id from data where rowid > 'a';").empty());
+  BOOST_CHECK(texts(conn, "select id from data where rowid < 'a' and rowid > 3;") == (v{"4", "5"}));
+  BOOST_CHECK(texts(conn, "select count(*) from data;") == (v{"5"}));
+  BOOST_CHECK(texts(conn, "select name from data where cast(id as integer) % 2 = 0;") == (v{"beta, gamma", "epsilon"}));
+
+  BOOST_CHECK_THROW(conn.execute("create virtual table missing using csv(filename='does-not-exist.csv');"),
+                    system::system_error);
+  BOOST_CHECK_THROW(conn.execute("create virtual table bad using csv(filename='csv_table_test.csv', colour=red);"),
+                    system::system_error);
+}
+
+BOOST_AUTO_TEST_CASE(csv_table_tsv)
+{
+  temp_file tf{"csv_table_test.tsv", "a\t1\nb\t2\nc\t3\n"};
+
+  sqlite::connection conn(":memory:");
+  sqlite::create_module(conn, "csv", sqlite::vtab::csv_module());
+  conn.execute("create virtual table data using csv('csv_table_test.tsv', delimiter=tab, header=no);");
+
+  using v = std::vector<std::string>;
+  BOOST_CHECK(texts(conn, "select c0 || c1 from data;") == (v{"a1", "b2", "c3"}));
+  BOOST_CHECK(texts(conn, "select c0 from data where rowid = 3;") == (v{"c"}));
+}
+
+BOOST_AUTO_TEST_CASE(csv_file_index)
+{
+  std::string content = "key,value\n";
+  for (int i = 0; i < 50000; i++)
+  {
+    content += std::to_string(i);
+    content += i % 7 == 0 ? ",\"multi\nline, \"\"quoted\"\"\"\n" : ",value\n";
+  }
+  temp_file tf{"csv_table_index.csv", content};
+
+  sqlite::vtab::csv_options single;
+  single.index_stride = 16u;
+  single.threads = 1u;
+  sqlite::vtab::csv_file seq;
+  seq.open(tf.path, single);
+
+  auto parallel = single;
+  parallel.threads = 4u;
+  parallel.parallel_threshold = 0u;
+  sqlite::vtab::csv_file par;
+  par.open(tf.path, parallel);
+
+  BOOST_CHECK_EQUAL(seq.size(), 50000u);
+  BOOST_CHECK_EQUAL(par.size(), 50000u);
+  BOOST_CHECK_EQUAL(seq.column_count(), 2u);
+
+  std::vector<sqlite::vtab::csv_field> fields;
+  std::string buf;
+  for (std::size_t i : {0u, 1u, 15u, 16u, 17u, 7000u, 32767u, 49999u})
+  {
+    BOOST_CHECK_EQUAL(std::string(par.row_begin(i), 8u), std::string(seq.row_begin(i), 8u));
+    par.split_row(par.row_begin(i), 2u, fields);
+    BOOST_REQUIRE_EQUAL(fields.size(), 2u);
+    BOOST_CHECK_EQUAL(par.decode(fields[0], buf), std::to_string(i));
+    BOOST_CHECK_EQUAL(par.decode(fields[1], buf), i % 7 == 0 ? "multi\nline, \"quoted\"" : "value");
+  }
+
+  sqlite::vtab::csv_file missing;
+  system::error_code ec;
+  sqlite::error_info ei;
+  missing.open("csv_table_missing.csv", single, ec, ei);
+  BOOST_CHECK(ec);
+  BOOST_CHECK(!missing.is_open());
+}
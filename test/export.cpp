@@ -0,0 +1,112 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/export.hpp>
+#include <boost/sqlite/connection.hpp>
+#include "test.hpp"
+
+#include <cerrno>
+#include <string>
+
+using namespace boost;
+
+namespace
+{
+
+struct string_sink
+{
+  std::string data;
+  std::size_t calls = 0u;
+  void operator()(core::string_view sv, system::error_code &)
+  {
+    data.append(sv.data(), sv.size());
+    calls++;
+  }
+};
+
+std::string export_string(sqlite::connection & conn, const char * sql, const sqlite::export_options & opts = {})
+{
+  string_sink sink;
+  auto st = conn.prepare(sql);
+  sqlite::export_rows(st, sink, opts);
+  return sink.data;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(export_csv)
+{
+  sqlite::connection conn(":memory:");
+  conn.execute(
+      "create table t(id integer, name text, score real, data blob);"
+      "insert into t values (1, 'plain', 1.5, x'00ff'),"
+      "                     (-42, 'with, comma', 3.0, null),"
+      "                     (9223372036854775807, 'say \"hi\"', 0.1, x''),"
+      "                     (null, 'two' || char(10) || 'lines', 1e300, x'0102');");
+
+  BOOST_CHECK_EQUAL(export_string(conn, "select * from t"),
+                    "id,name,score,data\n"
+                    "1,plain,1.5,00ff\n"
+                    "-42,\"with, comma\",3.0,\n"
+                    "9223372036854775807,\"say \"\"hi\"\"\",0.1,\n"
+                    ",\"two\nlines\",1e+300,0102\n");
+
+  sqlite::export_options opts;
+  opts.header = false;
+  opts.delimiter = ';';
+  BOOST_CHECK_EQUAL(export_string(conn, "select id, name from t where id = -42", opts), "-42;with, comma\n");
+}
+
+BOOST_AUTO_TEST_CASE(export_tsv)
+{
+  sqlite::connection conn(":memory:");
+  sqlite::export_options opts;
+  opts.format = sqlite::export_format::tsv;
+  BOOST_CHECK_EQUAL(export_string(conn, "select 'a' || char(9) || 'b' as x, 'c\\d' as y, null as z", opts),
+                    "x\ty\tz\n"
+                    "a\\tb\tc\\\\d\t\\N\n");
+}
+
+BOOST_AUTO_TEST_CASE(export_ndjson)
+{
+  sqlite::connection conn(":memory:");
+  sqlite::export_options opts;
+  opts.format = sqlite::export_format::ndjson;
+  opts.blobs = sqlite::blob_encoding::base64;
+  BOOST_CHECK_EQUAL(
+      export_string(conn,
+                    "select 1 as \"a\"\"b\", 'q\"' || char(1) || char(10) as s, null as n, x'666f6f62' as b, 2.25 as r "
+                    "union all select -1, '', 1, x'666f6f', 1e999",
+                    opts),
+      "{\"a\\\"b\":1,\"s\":\"q\\\"\\u0001\\n\",\"n\":null,\"b\":\"Zm9vYg==\",\"r\":2.25}\n"
+      "{\"a\\\"b\":-1,\"s\":\"\",\"n\":1,\"b\":\"Zm9v\",\"r\":9e999}\n");
+}
+
+BOOST_AUTO_TEST_CASE(export_buffering)
+{
+  sqlite::connection conn(":memory:");
+  conn.execute("create table t(x text);"
+               "with recursive c(i) as (select 1 union all select i + 1 from c where i < 1000) "
+               "insert into t select printf('row number %d with enough text to be longer than sixteen bytes', i) from c;");
+
+  std::string expected = "x\n";
+  for (int i = 1; i <= 1000; i++)
+    expected += "row number " + std::to_string(i) + " with enough text to be longer than sixteen bytes\n";
+
+  sqlite::export_options opts;
+  opts.buffer_size = 256u;
+  string_sink sink;
+  auto st = conn.prepare("select x from t");
+  BOOST_CHECK_EQUAL(sqlite::export_rows(st, sink, opts), 1000u);
+  BOOST_CHECK(sink.data == expected);
+  BOOST_CHECK_GT(sink.calls, 100u);
+
+  auto failing = [](core::string_view, system::error_code & ec) {ec.assign(EIO, system::generic_category());};
+  auto st2 = conn.prepare("select x from t");
+  system::error_code ec;
+  sqlite::error_info ei;
+  sqlite::export_rows(st2, failing, opts, ec, ei);
+  BOOST_CHECK_EQUAL(ec.value(), EIO);
+}
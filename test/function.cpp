@@ -8,6 +8,8 @@
 #include <boost/sqlite/iterator.hpp>
 #include "test.hpp"
 
+#include <boost/optional.hpp>
+
 #include <string>
 #include <vector>
 
@@ -176,6 +178,154 @@ BOOST_AUTO_TEST_CASE(aggregate)
   BOOST_CHECK(lens[0]  == (5 + 6 + 7 + 5));
 }
 
+BOOST_AUTO_TEST_CASE(scalar_noexcept)
+{
+  sqlite::connection conn(":memory:");
+  conn.execute(
+#include "test-db.sql"
+  );
+
+  auto text_len = [](sqlite::context<>, boost::span<sqlite::value, 1u> val) noexcept -> sqlite3_int64
+                  {
+                    return val[0].get_text().size();
+                  };
+  auto identity = [](sqlite::context<>, boost::span<sqlite::value, 1u> val) noexcept -> core::string_view
+                  {
+                    return val[0].get_text();
+                  };
+  std::size_t calls = 0u;
+  auto counter  = [&](sqlite::context<>, boost::span<sqlite::value, 1u>) noexcept { calls++; };
+
+  sqlite::create_scalar_function(conn, "text_len", text_len);
+  sqlite::create_scalar_function(conn, "identity", identity);
+  sqlite::create_scalar_function(conn, "counter", counter);
+
+  // language=sqlite
+  auto q = conn.prepare("select text_len(first_name), identity(first_name), counter(first_name) "
+                        "from author order by last_name asc;");
+  std::vector<std::int64_t> lens;
+  std::vector<std::string> names;
+  for (auto r : sqlite::statement_range<sqlite::row>(q))
+  {
+    lens.push_back(r.at(0).get_int());
+    names.emplace_back(r.at(1).get_text());
+    BOOST_CHECK(r.at(2).is_null());
+  }
+
+  std::vector<std::int64_t> ln = {5, 6, 7, 5};
+  std::vector<std::string> nm = {"peter", "vinnie", "richard", "ruben"};
+  BOOST_CHECK(ln == lens);
+  BOOST_CHECK(nm == names);
+  BOOST_CHECK(calls == 4u);
+}
+
+sqlite3_int64 typed_add(sqlite3_int64 x, sqlite3_int64 y) noexcept
+{
+  return x + y;
+}
+
+BOOST_AUTO_TEST_CASE(scalar_typed)
+{
+  sqlite::connection conn(":memory:");
+
+  sqlite::create_scalar_function(
+      conn, "describe",
+      [](sqlite3_int64 i, sqlite::string_view s, boost::optional<double> d) -> std::string
+      {
+        return std::to_string(i) + ":" + std::string(s) + ":" + (d ? std::to_string(static_cast<int>(*d)) : "null");
+      });
+  sqlite::create_scalar_function(conn, "typed_add", &typed_add);
+  sqlite::create_scalar_function(
+      conn, "non_negative",
+      [](sqlite::context<> ctx, sqlite3_int64 i)
+      {
+        if (i < 0)
+          ctx.set_error("negative");
+        else
+          ctx.set_result(i);
+      });
+
+  // language=sqlite
+  auto q = conn.prepare("select describe(1, 'foo', 2.5), describe(2, 'bar', null), typed_add(20, 22), "
+                        "non_negative(3);");
+  q.step();
+  BOOST_CHECK(q.current().at(0).get_text() == "1:foo:2");
+  BOOST_CHECK(q.current().at(1).get_text() == "2:bar:null");
+  BOOST_CHECK(q.current().at(2).get_int() == 42);
+  BOOST_CHECK(q.current().at(3).get_int() == 3);
+  BOOST_CHECK_THROW(conn.execute("select non_negative(-1);"), boost::system::system_error);
+
+  // wrong arity is rejected by sqlite
+  BOOST_CHECK_THROW(conn.prepare("select describe(1, 'foo');"), boost::system::system_error);
+
+  // wrong types are rejected before the function gets invoked
+  system::error_code ec;
+  sqlite::error_info ei;
+  auto st = conn.prepare("select describe('foo', 'bar', 1.0);");
+  st.step(ec, ei);
+  BOOST_CHECK(ec.value() == SQLITE_MISMATCH);
+  BOOST_CHECK(ei.message() == "argument 1: expected integer, got text");
+}
+
+BOOST_AUTO_TEST_CASE(scalar_overloads)
+{
+  sqlite::connection conn(":memory:");
+
+  sqlite::create_scalar_function(
+      conn, "pad",
+      sqlite::overloads(
+          [](sqlite::string_view s) noexcept -> std::string {return std::string(s) + "!";},
+          [](sqlite::string_view s, sqlite3_int64 n) -> std::string {return std::string(s) + std::string(n, '!');}));
+
+  // language=sqlite
+  auto q = conn.prepare("select pad('a'), pad('b', 3);");
+  q.step();
+  BOOST_CHECK(q.current().at(0).get_text() == "a!");
+  BOOST_CHECK(q.current().at(1).get_text() == "b!!!");
+}
+
+BOOST_AUTO_TEST_CASE(aggregate_noexcept)
+{
+  sqlite::connection conn(":memory:");
+  conn.execute(
+#include "test-db.sql"
+  );
+
+  struct aggregate_func
+  {
+    aggregate_func(int value) noexcept : counter(value) {}
+    std::size_t counter;
+    void step(boost::span<sqlite::value, 1u> val) noexcept
+    {
+      counter += val[0].get_text().size();
+    }
+
+    std::int64_t final() noexcept
+    {
+      return counter;
+    }
+  };
+
+  static_assert(sqlite::detail::is_nothrow_aggregate_step<
+                  aggregate_func, std::tuple<int>, boost::span<sqlite::value, 1u>>::value,
+                "noexcept step");
+  static_assert(sqlite::detail::is_nothrow_aggregate_final<aggregate_func, std::tuple<int>>::value,
+                "noexcept final");
+
+  sqlite::create_aggregate_function<aggregate_func>(
+      conn,
+      "char_counter", std::make_tuple(0));
+
+  // language=sqlite
+  auto q = conn.prepare("select char_counter(first_name) from author;");
+  std::vector<std::size_t> lens;
+  for (auto r : sqlite::statement_range<sqlite::row>(q))
+    lens.emplace_back(r.at(0).get_int());
+
+  BOOST_CHECK(lens.size() == 1u);
+  BOOST_CHECK(lens[0]  == (5 + 6 + 7 + 5));
+}
+
 BOOST_AUTO_TEST_CASE(aggregate_result)
 {
   sqlite::connection conn(":memory:");
@@ -0,0 +1,83 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/hyperloglog.hpp>
+#include <boost/sqlite/connection.hpp>
+#include "test.hpp"
+
+#include <cstring>
+#include <memory>
+
+using namespace boost;
+
+namespace
+{
+
+sqlite3_int64 get_int(sqlite::connection & conn, const char * sql)
+{
+  auto st = conn.prepare(sql);
+  st.step();
+  return st.current().at(0).get_int();
+}
+
+std::uint64_t splitmix(std::uint64_t x)
+{
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(hyperloglog)
+{
+  sqlite::connection conn(":memory:");
+  sqlite::create_hyperloglog_functions(conn);
+
+  // language=sqlite
+  conn.execute(R"(
+create table visits(day integer, user text);
+with recursive c(i) as (select 0 union all select i + 1 from c where i < 99999)
+  insert into visits select i % 7, 'user-' || (i % 50000) from c;
+create table daily as select day, hll_sketch(user) as sketch from visits group by day;
+)");
+
+  const auto direct = get_int(conn, "select approx_count_distinct(user) from visits;");
+  BOOST_CHECK_CLOSE(static_cast<double>(direct), 50000., 3.);
+
+  const auto merged = get_int(conn, "select hll_estimate(hll_merge(sketch)) from daily;");
+  BOOST_CHECK_EQUAL(merged, direct);
+
+  BOOST_CHECK_EQUAL(get_int(conn, "select approx_count_distinct(user) from visits where day < 0;"), 0);
+  BOOST_CHECK_EQUAL(get_int(conn, "select approx_count_distinct(x) from (select 1 as x union all select 1.0 union all select null);"), 1);
+  BOOST_CHECK_EQUAL(get_int(conn, "select approx_count_distinct(x) from (select 1 as x union all select '1' union all select x'31');"), 3);
+
+  BOOST_CHECK_THROW(conn.execute("select hll_estimate(x'00');"), system::system_error);
+  BOOST_CHECK_THROW(conn.execute("select hll_merge(x'00');"), system::system_error);
+
+  std::unique_ptr<sqlite::hyperloglog> small{new sqlite::hyperloglog()};
+  for (std::uint64_t i = 0u; i < 100u; i++)
+    small->add_hash(splitmix(i));
+  BOOST_CHECK_CLOSE(small->estimate(), 100., 5.);
+
+  std::unique_ptr<sqlite::hyperloglog> copy{new sqlite::hyperloglog()};
+  auto bl = small->to_blob();
+  BOOST_CHECK(copy->merge(sqlite::blob_view(bl)).has_value());
+  BOOST_CHECK_EQUAL(copy->estimate(), small->estimate());
+
+  // a valid header with registers out of range, e.g. read from a corrupted database.
+  auto corrupt = small->to_blob();
+  std::memset(static_cast<unsigned char*>(corrupt.data()) + 8u, 0xFF, sqlite::hyperloglog::register_count);
+  const auto before = copy->estimate();
+  auto res = copy->merge(sqlite::blob_view(corrupt));
+  BOOST_REQUIRE(res.has_error());
+  BOOST_CHECK_EQUAL(std::move(res).error().code, SQLITE_MISMATCH);
+  BOOST_CHECK_EQUAL(copy->estimate(), before);
+
+  auto st = conn.prepare("select hll_estimate($1);");
+  st.bind(std::make_tuple(sqlite::blob_view(corrupt)));
+  BOOST_CHECK_THROW(st.step(), system::system_error);
+}
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/sqlite/memory_resource.hpp>
+#include <boost/test/unit_test.hpp>
+
+#if BOOST_SQLITE_HAS_MEMORY_RESOURCE
+
+#include <boost/sqlite/connection.hpp>
+#include <boost/core/ignore_unused.hpp>
+
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_CASE(memory_resource)
+{
+  auto res = sqlite::get_memory_resource();
+  BOOST_CHECK(res == sqlite::get_memory_resource());
+  BOOST_CHECK(res->is_equal(*sqlite::get_memory_resource()));
+  BOOST_CHECK(!res->is_equal(*std::pmr::new_delete_resource()));
+
+  const auto used = sqlite3_memory_used();
+  auto p = res->allocate(100);
+  BOOST_CHECK_GT(sqlite3_memory_used(), used);
+  res->deallocate(p, 100);
+  BOOST_CHECK_EQUAL(sqlite3_memory_used(), used);
+
+  auto aligned = res->allocate(100, 64);
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(aligned) % 64u, 0u);
+  res->deallocate(aligned, 100, 64);
+  BOOST_CHECK_EQUAL(sqlite3_memory_used(), used);
+
+  // the whole block must be usable, whatever the alignment of the block returned by sqlite.
+  for (std::size_t alignment = 16u; alignment <= 256u; alignment *= 2u)
+    for (std::size_t size = 1u; size <= 64u; size++)
+    {
+      auto q = res->allocate(size, alignment);
+      BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(q) % alignment, 0u);
+      std::memset(q, 0xFF, size);
+      res->deallocate(q, size, alignment);
+    }
+  BOOST_CHECK_EQUAL(sqlite3_memory_used(), used);
+
+  BOOST_CHECK_THROW(boost::ignore_unused(res->allocate((std::numeric_limits<std::size_t>::max)() / 2u)), std::bad_alloc);
+  BOOST_CHECK_THROW(boost::ignore_unused(res->allocate((std::numeric_limits<std::size_t>::max)() - 8u, 64u)), std::bad_alloc);
+
+  std::pmr::vector<int> vec{res};
+  vec.assign(1000, 42);
+  BOOST_CHECK_GT(sqlite3_memory_used(), used);
+}
+
+BOOST_AUTO_TEST_CASE(arena)
+{
+  sqlite::connection conn{":memory:"};
+  conn.execute(
+      "create table t(name text);"
+      "with recursive c(x) as (select 1 union all select x + 1 from c where x < 100)"
+      "  insert into t select 'a rather long name, so it is not stored inline ' || x from c;");
+
+  const auto used = sqlite3_memory_used();
+  sqlite::arena arena{1024u};
+  for (int i = 0; i < 2; i++)
+  {
+    std::pmr::vector<std::pmr::string> names{&arena};
+    auto st = conn.prepare("select name from t");
+    while (st.step())
+      names.emplace_back(st.current().at(0).get_text().c_str());
+    BOOST_CHECK_EQUAL(names.size(), 100u);
+    BOOST_CHECK_EQUAL(names.back(), "a rather long name, so it is not stored inline 100");
+  }
+  BOOST_CHECK_GT(sqlite3_memory_used(), used);
+  arena.reset();
+  BOOST_CHECK_EQUAL(sqlite3_memory_used(), used);
+
+  alignas(16) unsigned char buffer[256];
+  const auto before = sqlite3_memory_used();
+  sqlite::arena stack{buffer, sizeof(buffer)};
+  auto p = stack.allocate(64);
+  BOOST_CHECK(p >= static_cast<void*>(buffer) && p < static_cast<void*>(buffer + sizeof(buffer)));
+  BOOST_CHECK_EQUAL(sqlite3_memory_used(), before);
+}
+
+#endif
@@ -7,9 +7,13 @@
 
 
 #include <boost/sqlite/mutex.hpp>
+#include <boost/sqlite/connection.hpp>
 
 #include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
 #include <mutex>
+#include <thread>
 
 using namespace boost;
 
@@ -28,4 +32,57 @@ BOOST_AUTO_TEST_CASE(mutex)
   BOOST_CHECK(rmtx.try_lock());
   BOOST_CHECK(rmtx.try_lock());
   BOOST_CHECK(rmtx.try_lock());
-}
\ No newline at end of file
+}
+BOOST_AUTO_TEST_CASE(adaptive_mutex)
+{
+  sqlite3_mutex_methods original;
+  BOOST_REQUIRE_EQUAL(sqlite3_shutdown(), SQLITE_OK);
+  BOOST_REQUIRE_EQUAL(sqlite3_config(SQLITE_CONFIG_GETMUTEX, &original), SQLITE_OK);
+
+  sqlite::install_adaptive_mutex();
+  BOOST_REQUIRE_EQUAL(sqlite3_initialize(), SQLITE_OK);
+
+  system::error_code ec;
+  sqlite::install_adaptive_mutex({}, ec);
+  BOOST_CHECK_EQUAL(ec.value(), SQLITE_MISUSE);
+
+  {
+    sqlite::connection conn{":memory:"};
+    conn.execute("create table t(x); insert into t values (1), (2), (3);");
+
+    sqlite::recursive_mutex rmtx;
+    rmtx.lock();
+    BOOST_CHECK(rmtx.try_lock());
+    rmtx.unlock();
+    rmtx.unlock();
+
+    sqlite::mutex mtx;
+    mtx.lock();
+    std::atomic<bool> try_failed{false};
+    std::thread thr{
+      [&]
+      {
+        try_failed = !mtx.try_lock();
+        mtx.lock();
+        mtx.unlock();
+      }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    mtx.unlock();
+    thr.join();
+    BOOST_CHECK(try_failed);
+  }
+
+  BOOST_CHECK_GT(sqlite::mutex_contention(SQLITE_MUTEX_STATIC_MAIN).acquisitions, 0u);
+  BOOST_CHECK_GE(sqlite::mutex_contention(SQLITE_MUTEX_RECURSIVE).acquisitions, 2u);
+
+  const auto fast = sqlite::mutex_contention(SQLITE_MUTEX_FAST);
+  BOOST_CHECK_GE(fast.acquisitions, 2u);
+  BOOST_CHECK_GE(fast.contended, 1u);
+  BOOST_CHECK_GE(fast.wait_time.count(), 1000000);
+
+  BOOST_CHECK_EQUAL(sqlite::mutex_contention(-1).acquisitions, 0u);
+
+  BOOST_REQUIRE_EQUAL(sqlite3_shutdown(), SQLITE_OK);
+  BOOST_CHECK_EQUAL(sqlite3_config(SQLITE_CONFIG_MUTEX, &original), SQLITE_OK);
+  BOOST_CHECK_EQUAL(sqlite3_initialize(), SQLITE_OK);
+}
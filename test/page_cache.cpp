@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/sqlite/page_cache.hpp>
+#include <boost/sqlite/connection.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <string>
+
+using namespace boost;
+
+namespace
+{
+
+sqlite3_int64 scalar(sqlite::connection & conn, core::string_view sql)
+{
+  auto st = conn.prepare(sql);
+  BOOST_REQUIRE(st.step());
+  return sqlite3_column_int64(st.handle(), 0);
+}
+
+std::string integrity(sqlite::connection & conn)
+{
+  auto st = conn.prepare("pragma integrity_check");
+  BOOST_REQUIRE(st.step());
+  return reinterpret_cast<const char*>(sqlite3_column_text(st.handle(), 0));
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(page_cache)
+{
+  sqlite3_pcache_methods2 original;
+  BOOST_REQUIRE_EQUAL(sqlite3_shutdown(), SQLITE_OK);
+  BOOST_REQUIRE_EQUAL(sqlite3_config(SQLITE_CONFIG_GETPCACHE2, &original), SQLITE_OK);
+
+  // about 16 pages of 4k per shard.
+  sqlite::install_page_cache({4u * 16u * 4096u, 4u});
+  BOOST_REQUIRE_EQUAL(sqlite3_initialize(), SQLITE_OK);
+
+  system::error_code ec;
+  sqlite::install_page_cache({}, ec);
+  BOOST_CHECK_EQUAL(ec.value(), SQLITE_MISUSE);
+
+  const std::string path = "page_cache_test.db";
+  std::remove(path.c_str());
+  {
+    sqlite::connection writer{path};
+    writer.execute(
+        "pragma page_size = 4096;"
+        "create table t(id integer primary key, data blob);"
+        "with recursive c(x) as (select 1 union all select x + 1 from c where x < 2000)"
+        "  insert into t select x, randomblob(500) from c;");
+
+    sqlite::connection reader{path};
+    BOOST_CHECK_EQUAL(scalar(reader, "select count(*) from t"), 2000);
+    BOOST_CHECK_EQUAL(scalar(reader, "select sum(id) from t"), 2000 * 2001 / 2);
+    BOOST_CHECK_EQUAL(scalar(writer, "select sum(length(data)) from t"), 2000 * 500);
+
+    writer.execute("delete from t where id > 1000; vacuum;");
+    BOOST_CHECK_EQUAL(scalar(reader, "select count(*) from t"), 1000);
+    BOOST_CHECK_EQUAL(integrity(reader), "ok");
+
+    // auto vacuum moves pages, which rekeys them, & truncates the cache.
+    writer.execute(
+        "pragma auto_vacuum = full; vacuum;"
+        "delete from t where id % 3 = 0;"
+        "delete from t where id <= 500;");
+    BOOST_CHECK_EQUAL(scalar(reader, "select count(*) from t"), 333);
+    BOOST_CHECK_EQUAL(integrity(reader), "ok");
+    BOOST_CHECK_EQUAL(integrity(writer), "ok");
+
+    // in-memory databases exceed the budget, because their pages can't be evicted.
+    sqlite::connection mem{":memory:"};
+    mem.execute(
+        "create table t(id integer primary key, data blob);"
+        "with recursive c(x) as (select 1 union all select x + 1 from c where x < 2000)"
+        "  insert into t select x, zeroblob(500) from c;");
+    BOOST_CHECK_EQUAL(scalar(mem, "select sum(length(data)) from t"), 2000 * 500);
+    BOOST_CHECK_EQUAL(integrity(mem), "ok");
+    BOOST_CHECK_GT(sqlite::page_cache_stats().memory_used, 4u * 16u * 4096u);
+
+    const auto stats = sqlite::page_cache_stats();
+    BOOST_CHECK_GT(stats.hits, 0u);
+    BOOST_CHECK_GT(stats.misses, 0u);
+    BOOST_CHECK_GT(stats.evictions, 0u);
+    BOOST_CHECK_GT(stats.pages, 0u);
+  }
+  std::remove(path.c_str());
+  BOOST_CHECK_EQUAL(sqlite::page_cache_stats().pages, 0u);
+
+  BOOST_REQUIRE_EQUAL(sqlite3_shutdown(), SQLITE_OK);
+  BOOST_CHECK_EQUAL(sqlite3_config(SQLITE_CONFIG_PCACHE2, &original), SQLITE_OK);
+  BOOST_CHECK_EQUAL(sqlite3_initialize(), SQLITE_OK);
+}
@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/sqlite/parallel_query.hpp>
+#include <boost/sqlite/connection.hpp>
+
+#include "test.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+using namespace boost;
+
+struct parallel_db
+{
+  const char * name = "boost_sqlite_parallel_query.db";
+  parallel_db()
+  {
+    clear();
+    sqlite::connection conn{name};
+    conn.execute("pragma journal_mode=wal;"
+                 "create table numbers(id integer primary key, value integer);"
+                 "with recursive seq(x) as (select 1 union all select x + 1 from seq where x < 1000)"
+                 " insert into numbers select x, x * 2 from seq;"
+                 "create table reals(k real);"
+                 "with recursive seq(x) as (select 1 union all select x + 1 from seq where x < 200)"
+                 " insert into reals select x * 0.5 - 0.25 from seq;"
+                 "insert into reals values (-1e30), (1e30);"
+                 "create table holes(k);"
+                 "insert into holes values (1), (null), (3);"
+                 "create table texts(k);"
+                 "insert into texts values (1), ('two'), (3);");
+  }
+  ~parallel_db()
+  {
+    clear();
+  }
+  void clear()
+  {
+    std::remove(name);
+    std::remove("boost_sqlite_parallel_query.db-wal");
+    std::remove("boost_sqlite_parallel_query.db-shm");
+  }
+};
+
+BOOST_AUTO_TEST_CASE(parallel_query)
+{
+  parallel_db db;
+  std::vector<sqlite::connection> pool;
+  for (int i = 0; i < 3; i++)
+    pool.emplace_back(db.name, SQLITE_OPEN_READONLY);
+
+  std::vector<std::vector<sqlite3_int64>> parts(7u);
+  sqlite::parallel_query(pool, "select id, value from numbers where value % 3 = 0", "id", parts.size(),
+                         [&](std::size_t partition, const sqlite::row & r)
+                         {
+                           BOOST_REQUIRE(partition < parts.size());
+                           BOOST_CHECK_EQUAL(r[1].get_int(), r[0].get_int() * 2);
+                           parts[partition].push_back(r[0].get_int());
+                         });
+
+  std::vector<sqlite3_int64> ids;
+  for (auto & p : parts)
+    ids.insert(ids.end(), p.begin(), p.end());
+
+  BOOST_REQUIRE_EQUAL(ids.size(), 333u);
+  for (std::size_t i = 0u; i < ids.size(); i++)
+    BOOST_CHECK_EQUAL(ids[i], static_cast<sqlite3_int64>((i + 1) * 3));
+
+  for (auto & c : pool)
+    BOOST_CHECK(sqlite3_get_autocommit(c.handle()) != 0);
+
+  std::size_t n = 0u;
+  sqlite::parallel_query(pool, "select id from numbers where id > 5000", "id", 4u,
+                         [&](std::size_t, const sqlite::row &) {n++;});
+  BOOST_CHECK_EQUAL(n, 0u);
+
+  BOOST_CHECK_THROW(
+    sqlite::parallel_query(pool, "select id from numbers", "id", 4u,
+                           [&](std::size_t, const sqlite::row &) { throw std::runtime_error("stop"); }),
+    std::runtime_error);
+
+  system::error_code ec;
+  sqlite::error_info ei;
+  sqlite::parallel_query(pool, "select id from no_such_table", "id", 4u,
+                         [&](std::size_t, const sqlite::row &) {}, ec, ei);
+  BOOST_CHECK(ec);
+
+  // every partition is sorted, even if the query orders otherwise.
+  std::vector<std::vector<sqlite3_int64>> desc(4u);
+  sqlite::parallel_query(pool, "select id from numbers order by id desc", "id", desc.size(),
+                         [&](std::size_t partition, const sqlite::row & r) { desc[partition].push_back(r[0].get_int()); });
+  ids.clear();
+  for (auto & p : desc)
+    ids.insert(ids.end(), p.begin(), p.end());
+  BOOST_REQUIRE_EQUAL(ids.size(), 1000u);
+  BOOST_CHECK(std::is_sorted(ids.begin(), ids.end()));
+
+  // real values between the integer bounds & beyond the range of an integer are in a partition, too.
+  std::vector<std::vector<double>> reals(7u);
+  sqlite::parallel_query(pool, "select k from reals", "k", reals.size(),
+                         [&](std::size_t partition, const sqlite::row & r) { reals[partition].push_back(r[0].get_double()); });
+  std::vector<double> ks;
+  for (auto & p : reals)
+    ks.insert(ks.end(), p.begin(), p.end());
+  BOOST_REQUIRE_EQUAL(ks.size(), 202u);
+  BOOST_CHECK(std::is_sorted(ks.begin(), ks.end()));
+  BOOST_CHECK_EQUAL(ks.front(), -1e30);
+  BOOST_CHECK_EQUAL(ks[1], 0.25);
+  BOOST_CHECK_EQUAL(ks.back(), 1e30);
+
+  // rows that can't be partitioned are an error, instead of missing from the result.
+  n = 0u;
+  ec.clear();
+  sqlite::parallel_query(pool, "select k from holes", "k", 2u,
+                         [&](std::size_t, const sqlite::row &) {n++;}, ec, ei);
+  BOOST_CHECK_EQUAL(ec.value(), SQLITE_MISMATCH);
+  ec.clear();
+  sqlite::parallel_query(pool, "select k from texts", "k", 2u,
+                         [&](std::size_t, const sqlite::row &) {n++;}, ec, ei);
+  BOOST_CHECK_EQUAL(ec.value(), SQLITE_MISMATCH);
+  BOOST_CHECK_EQUAL(n, 0u);
+  for (auto & c : pool)
+    BOOST_CHECK(sqlite3_get_autocommit(c.handle()) != 0);
+
+  std::vector<sqlite::connection> empty;
+  BOOST_CHECK_THROW(
+    sqlite::parallel_query(empty, "select id from numbers", "id", 4u, [&](std::size_t, const sqlite::row &) {}),
+    system::system_error);
+}
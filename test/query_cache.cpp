@@ -0,0 +1,185 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/query_cache.hpp>
+#include <boost/sqlite/connection.hpp>
+#include "test.hpp"
+
+#include <cstring>
+#include <vector>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_CASE(query_cache)
+{
+  sqlite::connection conn(":memory:");
+  conn.execute(
+      "create table users(id integer primary key, name text, score real, data blob);"
+      "create table orders(id integer primary key, user integer, total integer);"
+      "create view totals as select user, sum(total) as total from orders group by user;"
+      "insert into users values (1, 'alice', 1.5, x'0102'), (2, 'bob', null, null);"
+      "insert into orders values (1, 1, 10), (2, 1, 20), (3, 2, 5);");
+
+  sqlite::query_cache cache{conn};
+
+  auto res = cache.query("select name, score, data, id from users where id = ?", {1});
+  BOOST_REQUIRE(res);
+  BOOST_CHECK_EQUAL(cache.misses(), 1u);
+  BOOST_REQUIRE_EQUAL(res->size(), 1u);
+  BOOST_REQUIRE_EQUAL(res->column_count(), 4u);
+  BOOST_CHECK_EQUAL(res->column_name(1), "score");
+  BOOST_CHECK_EQUAL(res->at(0, 0).get_text(), "alice");
+  BOOST_CHECK_EQUAL(res->at(0, 1).get_double(), 1.5);
+  BOOST_CHECK(res->at(0, 2).type() == sqlite::value_type::blob);
+  BOOST_CHECK_EQUAL(res->at(0, 2).get_blob().size(), 2u);
+  BOOST_CHECK_EQUAL(res->at(0, 3).get_int(), 1);
+  BOOST_CHECK_THROW(res->at(1, 0), std::out_of_range);
+
+  // same sql & parameters are answered from the cache
+  BOOST_CHECK(cache.query("select name, score, data, id from users where id = ?", {1}) == res);
+  BOOST_CHECK_EQUAL(cache.hits(), 1u);
+  // int & int64 share the key, but a double or text parameter does not
+  BOOST_CHECK(cache.query("select name, score, data, id from users where id = ?", {std::int64_t(1)}) == res);
+  BOOST_CHECK(cache.query("select name, score, data, id from users where id = ?", {1.0}) != res);
+  BOOST_CHECK(cache.query("select name, score, data, id from users where id = ?", {"1"}) != res);
+  auto bob = cache.query("select name, score, data, id from users where id = ?", {2});
+  BOOST_CHECK(bob->at(0, 1).is_null());
+  BOOST_CHECK_EQUAL(cache.size(), 4u);
+
+  auto totals = cache.query("select total from totals where user = 1");
+  BOOST_CHECK_EQUAL(totals->at(0, 0).get_int(), 30);
+  auto joined = cache.query("select count(*) from users join orders on users.id = orders.user");
+
+  // changing orders drops the entries reading it, including through the view
+  conn.execute("insert into orders values (4, 1, 5)");
+  BOOST_CHECK_EQUAL(cache.size(), 4u);
+  BOOST_CHECK(cache.query("select name, score, data, id from users where id = ?", {1}) == res);
+  BOOST_CHECK_EQUAL(cache.query("select total from totals where user = 1")->at(0, 0).get_int(), 35);
+  BOOST_CHECK(cache.query("select count(*) from users join orders on users.id = orders.user") != joined);
+
+  conn.execute("update users set name = 'carol' where id = 2");
+  BOOST_CHECK_EQUAL(cache.query("select name, score, data, id from users where id = ?", {2})->at(0, 0).get_text(), "carol");
+  // the old result stays valid
+  BOOST_CHECK_EQUAL(bob->at(0, 0).get_text(), "bob");
+
+  // a statement that writes is run, but never cached
+  const auto before = cache.size();
+  cache.query("insert into orders values (5, 2, 1) returning id");
+  BOOST_CHECK_EQUAL(cache.size(), before - 1u);
+
+  cache.query("select total from totals where user = 1");
+  cache.invalidate("users");
+  BOOST_CHECK_EQUAL(cache.size(), 1u);
+  cache.clear();
+  BOOST_CHECK_EQUAL(cache.size(), 0u);
+  BOOST_CHECK_EQUAL(cache.memory_used(), 0u);
+
+  system::error_code ec;
+  sqlite::error_info ei;
+  BOOST_CHECK(!cache.query("select * from nope", ec, ei));
+  BOOST_CHECK(ec);
+
+  // the encoded parameter matches the text of the second query, "i" followed by eight '0'.
+  const auto hits = cache.hits();
+  BOOST_CHECK_EQUAL(cache.query("select :a", {sqlite3_int64(0x3030303030303030)})->at(0, 0).get_int(),
+                    0x3030303030303030);
+  // so it must not be answered from the cache, but run & fail for the missing parameter.
+  ec = {};
+  BOOST_CHECK(!cache.query("select :ai00000000", ec, ei));
+  BOOST_CHECK(ec);
+  BOOST_CHECK_EQUAL(cache.hits(), hits);
+}
+
+BOOST_AUTO_TEST_CASE(query_cache_transaction)
+{
+  sqlite::connection conn(":memory:");
+  conn.execute("create table t(id integer primary key, name text);"
+               "create table u(id integer primary key);"
+               "insert into t values (1, 'a');");
+
+  sqlite::query_cache cache{conn};
+  const auto name = [&]{ return std::string(cache.query("select name from t where id = 1")->at(0, 0).get_text()); };
+  cache.query("select count(*) from u");
+  BOOST_CHECK_EQUAL(name(), "a");
+
+  conn.execute("begin; update t set name = 'b' where id = 1;");
+  BOOST_CHECK_EQUAL(name(), "b");
+  // not cached while the change is uncommitted
+  BOOST_CHECK_EQUAL(cache.size(), 1u);
+  conn.execute("rollback");
+  BOOST_CHECK_EQUAL(name(), "a");
+  BOOST_CHECK_EQUAL(cache.size(), 2u);
+
+  conn.execute("begin; update t set name = 'c' where id = 1; commit;");
+  BOOST_CHECK_EQUAL(name(), "c");
+  BOOST_CHECK_EQUAL(cache.size(), 2u);
+
+  // sqlite runs a delete without where clause as a truncate, which the update hook doesn't see
+  conn.execute("delete from t");
+  BOOST_CHECK(!cache.query("select name from t where id = 1")->empty());
+  cache.invalidate("t");
+  BOOST_CHECK(cache.query("select name from t where id = 1")->empty());
+}
+
+BOOST_AUTO_TEST_CASE(query_cache_lru)
+{
+  sqlite::connection conn(":memory:");
+  conn.execute(
+      "create table t(id integer primary key, data text);"
+      "with recursive c(i) as (select 1 union all select i + 1 from c where i < 100) "
+      "insert into t select i, printf('%.1000c', 'x') from c;");
+
+  sqlite::query_cache cache{conn, 8192u};
+  std::vector<std::shared_ptr<const sqlite::cached_result>> held;
+  for (int i = 1; i <= 10; i++)
+  {
+    held.push_back(cache.query("select data from t where id = ?", {i}));
+    BOOST_CHECK_LE(cache.memory_used(), cache.max_memory());
+  }
+  BOOST_CHECK_LT(cache.size(), 10u);
+  // the most recent one is still there, the first got evicted
+  BOOST_CHECK(cache.query("select data from t where id = ?", {10}) == held.back());
+  BOOST_CHECK(cache.query("select data from t where id = ?", {1}) != held.front());
+  BOOST_CHECK_EQUAL(held.front()->at(0, 0).get_text().size(), 1000u);
+
+  // a result larger than the cache is returned, but not cached
+  const auto sz = cache.size();
+  BOOST_CHECK_EQUAL(cache.query("select data from t")->size(), 100u);
+  BOOST_CHECK_LE(cache.size(), sz);
+}
+
+BOOST_AUTO_TEST_CASE(query_cache_authorizer)
+{
+  sqlite::connection conn(":memory:");
+  conn.execute("create table t(id integer primary key);"
+               "create table secret(id integer primary key);");
+
+  int calls = 0;
+  auto deny_secret =
+      [&](int action, const char * table, const char *, const char *, const char *) noexcept
+      {
+        calls++;
+        return action == SQLITE_READ && table != nullptr && std::strcmp(table, "secret") == 0 ? SQLITE_DENY : SQLITE_OK;
+      };
+
+  {
+    sqlite::query_cache cache{conn};
+    cache.set_authorizer(deny_secret);
+
+    // statements prepared by the cache are authorized too
+    system::error_code ec;
+    sqlite::error_info ei;
+    BOOST_CHECK(!cache.query("select * from secret", ec, ei));
+    BOOST_CHECK_EQUAL(ec.value(), SQLITE_AUTH);
+    BOOST_CHECK_GT(calls, 0);
+
+    // and the authorizer stays installed after a miss
+    BOOST_CHECK(cache.query("select count(*) from t"));
+    BOOST_CHECK_THROW(conn.prepare("select * from secret"), system::system_error);
+  }
+
+  // the cache removes it on destruction
+  BOOST_CHECK_NO_THROW(conn.prepare("select * from secret"));
+}
@@ -0,0 +1,176 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/row_cursor.hpp>
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/iterator.hpp>
+#include "test.hpp"
+
+#include <array>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace boost;
+
+namespace
+{
+
+using square_row = std::tuple<sqlite3_int64, double, std::string>;
+
+struct square_cursor final : sqlite::vtab::row_cursor<square_row>
+{
+  explicit square_cursor(std::array<std::size_t, 3> & loaded) : loaded(&loaded) {}
+
+  std::array<std::size_t, 3> * loaded;
+  sqlite3_int64 pos = 0;
+
+  sqlite::result<void> filter(int, const char * idx_str, span<sqlite::value>)
+  {
+    set_columns_used(idx_str);
+    pos = 0;
+    load();
+    return {};
+  }
+  sqlite::result<void> next() { pos++; load(); return {}; }
+  bool eof() noexcept { return pos == 10; }
+  sqlite::result<sqlite3_int64> row_id() { return pos; }
+
+  void load()
+  {
+    if (eof())
+      return;
+    fill([&](auto & member, auto idx)
+         {
+           (*loaded)[idx]++;
+           load_member(member, idx);
+         });
+  }
+
+  void load_member(sqlite3_int64 & member, std::integral_constant<std::size_t, 0>) { member = pos; }
+  void load_member(double      & member, std::integral_constant<std::size_t, 1>) { member = pos * pos * .5; }
+  void load_member(std::string & member, std::integral_constant<std::size_t, 2>) { member = "#" + std::to_string(pos); }
+};
+
+struct square_table final : sqlite::vtab::table<square_cursor>
+{
+  explicit square_table(std::array<std::size_t, 3> & loaded) : loaded(loaded) {}
+  std::array<std::size_t, 3> & loaded;
+
+  const char * declaration() { return "create table x(value integer, half_square real, name text);"; }
+  sqlite::result<square_cursor> open() { return square_cursor{loaded}; }
+  sqlite::result<void> best_index(sqlite::vtab::index_info & info)
+  {
+    return sqlite::vtab::store_columns_used(info);
+  }
+};
+
+struct square_module final : sqlite::vtab::eponymous_module<square_table>
+{
+  std::array<std::size_t, 3> loaded{};
+  sqlite::result<square_table> connect(sqlite::connection_ref, int, const char * const *)
+  {
+    return square_table{loaded};
+  }
+};
+
+// more columns than fit into the index number.
+using wide_row = mp11::mp_rename<mp11::mp_repeat_c<mp11::mp_list<sqlite3_int64>, 40>, std::tuple>;
+
+struct wide_cursor final : sqlite::vtab::row_cursor<wide_row>
+{
+  sqlite3_int64 pos = 0;
+
+  sqlite::result<void> filter(int, const char * idx_str, span<sqlite::value>)
+  {
+    set_columns_used(idx_str);
+    pos = 0;
+    load();
+    return {};
+  }
+  sqlite::result<void> next() { pos++; load(); return {}; }
+  bool eof() noexcept { return pos == 3; }
+  sqlite::result<sqlite3_int64> row_id() { return pos; }
+
+  void load()
+  {
+    if (!eof())
+      fill([&](sqlite3_int64 & member, auto idx) { member = pos * 100 + static_cast<sqlite3_int64>(idx); });
+  }
+};
+
+struct wide_table final : sqlite::vtab::table<wide_cursor>
+{
+  std::string decl;
+
+  const char * declaration()
+  {
+    decl = "create table x(";
+    for (std::size_t i = 0u; i < std::tuple_size<wide_row>::value; i++)
+      decl += (i == 0u ? "c" : ", c") + std::to_string(i) + " integer";
+    decl += ");";
+    return decl.c_str();
+  }
+  sqlite::result<wide_cursor> open() { return wide_cursor{}; }
+  sqlite::result<void> best_index(sqlite::vtab::index_info & info)
+  {
+    return sqlite::vtab::store_columns_used(info);
+  }
+};
+
+struct wide_module final : sqlite::vtab::eponymous_module<wide_table>
+{
+  sqlite::result<wide_table> connect(sqlite::connection_ref, int, const char * const *)
+  {
+    return wide_table{};
+  }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(row_cursor)
+{
+  sqlite::connection conn(":memory:");
+  auto & m = create_module(conn, "squares", square_module{});
+
+  auto st = conn.prepare("select value, half_square, name from squares where rowid = 3;");
+  BOOST_CHECK(st.step());
+  BOOST_CHECK_EQUAL(st.current().at(0).get_int(), 3);
+  BOOST_CHECK_EQUAL(st.current().at(1).get_double(), 4.5);
+  BOOST_CHECK_EQUAL(st.current().at(2).get_text(), "#3");
+
+  // only the name gets read, so the other members are never filled
+  m.loaded = {};
+  std::vector<std::string> names;
+  auto nt = conn.prepare("select name from squares;");
+  for (auto r : sqlite::statement_range<sqlite::row>(nt))
+    names.push_back(r.at(0).get_text());
+  BOOST_CHECK_EQUAL(names.size(), 10u);
+  BOOST_CHECK_EQUAL(names.back(), "#9");
+  BOOST_CHECK_EQUAL(m.loaded[0], 0u);
+  BOOST_CHECK_EQUAL(m.loaded[1], 0u);
+  BOOST_CHECK_EQUAL(m.loaded[2], 10u);
+
+  m.loaded = {};
+  auto cnt = conn.prepare("select sum(value) from squares where half_square > 10;");
+  BOOST_CHECK(cnt.step());
+  BOOST_CHECK_EQUAL(cnt.current().at(0).get_int(), 5 + 6 + 7 + 8 + 9);
+  BOOST_CHECK_EQUAL(m.loaded[0], 10u);
+  BOOST_CHECK_EQUAL(m.loaded[1], 10u);
+  BOOST_CHECK_EQUAL(m.loaded[2], 0u);
+}
+
+BOOST_AUTO_TEST_CASE(row_cursor_wide)
+{
+  sqlite::connection conn(":memory:");
+  create_module(conn, "wide", wide_module{});
+
+  auto st = conn.prepare("select c0, c30, c35, c39 from wide where rowid = 2;");
+  BOOST_REQUIRE(st.step());
+  BOOST_CHECK_EQUAL(st.current().at(0).get_int(), 200);
+  BOOST_CHECK_EQUAL(st.current().at(1).get_int(), 230);
+  BOOST_CHECK_EQUAL(st.current().at(2).get_int(), 235);
+  BOOST_CHECK_EQUAL(st.current().at(3).get_int(), 239);
+}
@@ -0,0 +1,137 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/session.hpp>
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/iterator.hpp>
+#include "test.hpp"
+
+#include <string>
+#include <vector>
+
+#if defined(SQLITE_ENABLE_SESSION) && defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+
+using namespace boost;
+
+namespace
+{
+
+std::vector<std::string> names(sqlite::connection & conn)
+{
+  std::vector<std::string> res;
+  auto st = conn.prepare("select name from t order by id");
+  for (auto r : sqlite::statement_range<sqlite::row>(st))
+    res.push_back(std::string(r.at(0).get_text()));
+  return res;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(session)
+{
+  const char * schema = "create table t(id integer primary key, name text);"
+                        "insert into t values (1, 'a'), (2, 'b');";
+  sqlite::connection primary(":memory:"), replica(":memory:");
+  primary.execute(schema);
+  replica.execute(schema);
+
+  sqlite::blob cs;
+  {
+    sqlite::session sess{primary};
+    sess.attach("t");
+    BOOST_CHECK(sess.empty());
+    primary.execute("insert into t values (3, 'c'); update t set name = 'x' where id = 1; delete from t where id = 2;");
+    BOOST_CHECK(!sess.empty());
+    cs = sess.changeset();
+    BOOST_CHECK_LT(sess.patchset().size(), cs.size());
+  }
+
+  std::vector<int> ops;
+  sqlite::changeset_reader rd{cs};
+  while (rd.next())
+  {
+    auto ch = rd.current();
+    BOOST_CHECK_EQUAL(ch.table(), "t");
+    BOOST_CHECK_EQUAL(ch.column_count(), 2);
+    BOOST_CHECK(ch.is_primary_key(0));
+    BOOST_CHECK(!ch.is_primary_key(1));
+    ops.push_back(ch.op());
+    if (ch.op() == SQLITE_UPDATE)
+    {
+      BOOST_CHECK_EQUAL(ch.old_value(1).value().get_text(), "a");
+      BOOST_CHECK_EQUAL(ch.new_value(1).value().get_text(), "x");
+      // the primary key is unchanged
+      BOOST_CHECK(ch.new_value(0).has_error());
+    }
+  }
+  BOOST_CHECK_EQUAL(ops.size(), 3u);
+
+  sqlite::apply_changeset(replica, cs);
+  BOOST_CHECK(names(replica) == (std::vector<std::string>{"x", "c"}));
+
+  // the same changeset again conflicts on every row
+  std::vector<sqlite::conflict_type> conflicts;
+  sqlite::apply_changeset(replica, cs,
+                          [&](sqlite::conflict_type type, sqlite::change ch) noexcept
+                          {
+                            conflicts.push_back(type);
+                            if (type == sqlite::conflict_type::conflict)
+                              BOOST_CHECK_EQUAL(ch.conflict_value(1).value().get_text(), "c");
+                            return sqlite::conflict_action::omit;
+                          });
+  BOOST_CHECK_EQUAL(conflicts.size(), 3u);
+
+  system::error_code ec;
+  sqlite::error_info ei;
+  sqlite::apply_changeset(replica, cs, ec, ei);
+  BOOST_CHECK(ec);
+
+  // undo it
+  sqlite::apply_changeset(replica, sqlite::invert_changeset(cs));
+  BOOST_CHECK(names(replica) == (std::vector<std::string>{"a", "b"}));
+}
+
+BOOST_AUTO_TEST_CASE(changegroup)
+{
+  sqlite::connection conn(":memory:");
+  conn.execute("create table t(id integer primary key, name text);");
+
+  sqlite::changegroup grp;
+  for (int i = 0; i < 3; i++)
+  {
+    sqlite::session sess{conn};
+    sess.attach();
+    if (i == 0)
+      conn.execute("insert into t values (1, 'a')");
+    else
+      conn.execute("update t set name = name || 'b'");
+    grp.add(sess.changeset());
+  }
+
+  // insert + updates are merged into one insert
+  const auto combined = grp.output();
+  sqlite::changeset_reader rd{combined};
+  BOOST_REQUIRE(rd.next());
+  BOOST_CHECK_EQUAL(rd.current().op(), SQLITE_INSERT);
+  BOOST_CHECK_EQUAL(rd.current().new_value(1).value().get_text(), "abb");
+  BOOST_CHECK(!rd.next());
+
+  sqlite::connection other(":memory:");
+  other.execute("create table t(id integer primary key, name text);");
+  sqlite::apply_changeset(other, combined);
+  BOOST_CHECK(names(other) == (std::vector<std::string>{"abb"}));
+
+  // diff an attached database
+  other.execute("attach ':memory:' as old; create table old.t(id integer primary key, name text);");
+  sqlite::session sess{other};
+  sess.attach("t");
+  sess.diff("old", "t");
+  const auto cs = sess.changeset();
+  sqlite::changeset_reader diff{cs};
+  BOOST_REQUIRE(diff.next());
+  BOOST_CHECK_EQUAL(diff.current().op(), SQLITE_INSERT);
+}
+
+#endif
@@ -0,0 +1,97 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/snapshot.hpp>
+#include <boost/sqlite/connection.hpp>
+#include "test.hpp"
+
+#include <cstdio>
+
+#if defined(SQLITE_ENABLE_SNAPSHOT)
+
+using namespace boost;
+
+namespace
+{
+
+struct wal_db
+{
+  const char * name = "boost_sqlite_snapshot.db";
+  wal_db()
+  {
+    clear();
+    sqlite::connection conn{name};
+    conn.execute("pragma journal_mode=wal; create table t(id integer primary key, x integer);"
+                 "insert into t(x) values (1), (2), (3);");
+  }
+  ~wal_db()
+  {
+    clear();
+  }
+  void clear()
+  {
+    std::remove(name);
+    std::remove("boost_sqlite_snapshot.db-wal");
+    std::remove("boost_sqlite_snapshot.db-shm");
+  }
+};
+
+sqlite3_int64 sum(sqlite::connection & conn)
+{
+  auto st = conn.prepare("select sum(x) from t");
+  st.step();
+  return st.current().at(0).get_int();
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(snapshot)
+{
+  wal_db db;
+  sqlite::connection leader{db.name}, writer{db.name}, reader{db.name};
+  // keeps the log from being checkpointed on close
+  sqlite::connection keeper{db.name};
+  keeper.execute("select count(*) from t");
+
+  leader.execute("begin");
+  BOOST_CHECK_EQUAL(sum(leader), 6);
+  sqlite::snapshot snap{leader};
+  BOOST_CHECK(snap);
+
+  writer.execute("insert into t(x) values (4)");
+  BOOST_CHECK_EQUAL(sum(writer), 10);
+
+  // the reader sees the data of the leader, not the one committed after the snapshot
+  snap.open(reader);
+  BOOST_CHECK(!sqlite3_get_autocommit(reader.handle()));
+  BOOST_CHECK_EQUAL(sum(reader), 6);
+  reader.execute("commit");
+  BOOST_CHECK_EQUAL(sum(reader), 10);
+  leader.execute("commit");
+
+  reader.execute("begin");
+  BOOST_CHECK_EQUAL(sum(reader), 10);
+  sqlite::snapshot newer{reader};
+  reader.execute("commit");
+  BOOST_CHECK_LT(snap.compare(newer), 0);
+  BOOST_CHECK_GT(newer.compare(snap), 0);
+  BOOST_CHECK_EQUAL(snap.compare(snap), 0);
+
+  // a snapshot needs a read transaction
+  system::error_code ec;
+  sqlite::error_info ei;
+  sqlite::snapshot none{reader, "main", ec, ei};
+  BOOST_CHECK(ec);
+  BOOST_CHECK(!none);
+
+  ec.clear();
+  none.open(reader, "main", ec, ei);
+  BOOST_CHECK_EQUAL(ec.value(), SQLITE_MISUSE);
+  BOOST_CHECK(sqlite3_get_autocommit(reader.handle()));
+
+  sqlite::snapshot::recover(reader);
+}
+
+#endif
@@ -11,6 +11,7 @@
 #include <boost/json.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <cstring>
 #include <unordered_map>
 
 
@@ -78,3 +79,129 @@ BOOST_AUTO_TEST_CASE(map)
 
   BOOST_CHECK_THROW(conn.prepare("elect * from nothing;"), boost::system::system_error);
 }
+
+BOOST_AUTO_TEST_CASE(lazy_error_message)
+{
+  sqlite::connection conn{":memory:"};
+  conn.execute("create table t(id integer primary key);");
+  auto st = conn.prepare("insert into t values ($1);");
+  st.execute(std::make_tuple(1));
+
+  // copied by default, so it stays valid when the connection is used again.
+  system::error_code ec;
+  sqlite::error_info copied;
+  conn.execute("begin");
+  conn.prepare("insert into t values (1);").execute(std::make_tuple(), ec, copied);
+  BOOST_CHECK_EQUAL(ec.value(), SQLITE_CONSTRAINT_PRIMARYKEY);
+  conn.execute("rollback");
+  BOOST_CHECK_GT(copied.capacity(), 0u);
+  BOOST_CHECK_EQUAL(copied.message(), "UNIQUE constraint failed: t.id");
+
+  {
+    sqlite::connection closed{":memory:"};
+    closed.execute("create table t(id integer primary key); insert into t values (1);");
+    sqlite::error_info ei;
+    ec.clear();
+    closed.prepare("insert into t values (1);").execute(std::make_tuple(), ec, ei);
+    BOOST_CHECK_EQUAL(ec.value(), SQLITE_CONSTRAINT_PRIMARYKEY);
+    closed.close();
+    BOOST_CHECK_EQUAL(ei.message(), "UNIQUE constraint failed: t.id");
+  }
+
+  // taken from the connection, so nothing got allocated.
+  sqlite::error_info ei;
+  ei.set_lazy();
+  ec.clear();
+  auto dup = conn.prepare("insert into t values ($1);");
+  dup.execute(std::make_tuple(1), ec, ei);
+  BOOST_CHECK_EQUAL(ec.value(), SQLITE_CONSTRAINT_PRIMARYKEY);
+  BOOST_CHECK_EQUAL(ei.capacity(), 0u);
+  BOOST_CHECK_EQUAL(ei.message(), "UNIQUE constraint failed: t.id");
+
+  // an error copies the message, so it outlives the next use of the connection.
+  sqlite::error err{ec, std::move(ei)};
+  conn.execute("insert into t values (2);");
+  auto cnt = conn.prepare("select count(*) from t;");
+  BOOST_REQUIRE(cnt.step());
+  BOOST_CHECK_EQUAL(cnt.current().at(0).get_int(), 2);
+  BOOST_CHECK_EQUAL(err.info.message(), "UNIQUE constraint failed: t.id");
+
+  try
+  {
+    conn.prepare("insert into t values ($1);").execute(std::make_tuple(2));
+    BOOST_CHECK(false);
+  }
+  catch (system::system_error & se)
+  {
+    BOOST_CHECK_EQUAL(se.code().value(), SQLITE_CONSTRAINT_PRIMARYKEY);
+    BOOST_CHECK(std::strstr(se.what(), "UNIQUE constraint failed: t.id") != nullptr);
+  }
+
+  sqlite::error_info lazy;
+  lazy.set_lazy();
+  lazy.set_message(conn.handle());
+  lazy.detach();
+  BOOST_CHECK_GT(lazy.capacity(), 0u);
+  lazy.clear();
+  BOOST_CHECK_EQUAL(lazy.message(), "");
+}
+
+BOOST_AUTO_TEST_CASE(reset)
+{
+  sqlite::connection conn{":memory:"};
+  conn.execute("create table t(id integer primary key);");
+
+  // a completed statement can be executed again.
+  auto st = conn.prepare("insert into t values ($1);");
+  st.execute(std::make_tuple(1));
+  st.execute(std::make_tuple(2));
+
+  auto sel = conn.prepare("select id from t order by id;");
+  BOOST_REQUIRE(sel.step());
+  BOOST_CHECK_EQUAL(sel.current().at(0).get_int(), 1);
+  BOOST_REQUIRE(sel.step());
+  BOOST_CHECK(!sel.step());
+  BOOST_CHECK(sel.done());
+  sel.reset();
+  BOOST_CHECK(!sel.done());
+  BOOST_REQUIRE(sel.step());
+  BOOST_CHECK_EQUAL(sel.current().at(0).get_int(), 1);
+
+  // reset reports the error of the last step & re-arms the statement.
+  system::error_code ec;
+  sqlite::error_info ei;
+  st.execute(std::make_tuple(1), ec, ei);
+  BOOST_CHECK_EQUAL(ec.value(), SQLITE_CONSTRAINT_PRIMARYKEY);
+  ec.clear();
+  st.reset(ec, ei);
+  BOOST_CHECK_EQUAL(ec.value(), SQLITE_CONSTRAINT_PRIMARYKEY);
+  ec.clear();
+  st.reset(ec, ei);
+  BOOST_CHECK(!ec);
+  st.execute(std::make_tuple(3), ec, ei);
+  BOOST_CHECK(!ec);
+
+  // cleared parameters are null.
+  auto param = conn.prepare("select $1;");
+  param.bind(std::make_tuple(42));
+  param.clear_bindings(ec, ei);
+  BOOST_CHECK(!ec);
+  BOOST_REQUIRE(param.step());
+  BOOST_CHECK(param.current().at(0).is_null());
+  param.reset();
+  param.clear_bindings();
+}
+
+BOOST_AUTO_TEST_CASE(error_info_copy)
+{
+  // the message doesn't need to be null-terminated.
+  const char text[] = "constraint failed; trailing";
+  sqlite::error_info ei{core::string_view(text, 17u)};
+  BOOST_CHECK_EQUAL(ei.message(), "constraint failed");
+
+  ei.set_message(core::string_view(text, 10u));
+  BOOST_CHECK_EQUAL(ei.message(), "constraint");
+
+  ei.set_message(core::string_view());
+  BOOST_CHECK_EQUAL(ei.message(), "");
+}
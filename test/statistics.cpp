@@ -0,0 +1,207 @@
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/sqlite/statistics.hpp>
+#include <boost/sqlite/connection.hpp>
+#include <boost/sqlite/iterator.hpp>
+#include "test.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace boost;
+
+namespace
+{
+
+sqlite::connection make_db()
+{
+  sqlite::connection conn(":memory:");
+  sqlite::create_statistics_functions(conn);
+  // language=sqlite
+  conn.execute(
+      "create table data(id integer primary key, x real, y real);"
+      "insert into data(x, y) values (2, 1), (4, 3), (4, 2), (4, 5), (5, 4), (5, 7), (7, 6), (9, 8), (null, 1);");
+  return conn;
+}
+
+double get_double(sqlite::connection & conn, const char * sql)
+{
+  auto st = conn.prepare(sql);
+  st.step();
+  return st.current().at(0).get_double();
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(variance)
+{
+  auto conn = make_db();
+  BOOST_CHECK_CLOSE(get_double(conn, "select var_pop(x) from data;"),     4.,  1e-9);
+  BOOST_CHECK_CLOSE(get_double(conn, "select stddev_pop(x) from data;"),  2.,  1e-9);
+  BOOST_CHECK_CLOSE(get_double(conn, "select var_samp(x) from data;"),    32. / 7., 1e-9);
+  BOOST_CHECK_CLOSE(get_double(conn, "select stddev_samp(x) from data;"), std::sqrt(32. / 7.), 1e-9);
+
+  auto st = conn.prepare("select var_samp(x) from data where id = 1;");
+  st.step();
+  BOOST_CHECK(st.current().at(0).is_null());
+}
+
+BOOST_AUTO_TEST_CASE(covariance)
+{
+  auto conn = make_db();
+  // x = 2 4 4 4 5 5 7 9, y = 1 3 2 5 4 7 6 8
+  // sum((x - 5) * (y - 4.5)) = 31, sum((x - 5)^2) = 32, sum((y - 4.5)^2) = 42
+  BOOST_CHECK_CLOSE(get_double(conn, "select covar_pop(x, y) from data;"),  31. / 8., 1e-9);
+  BOOST_CHECK_CLOSE(get_double(conn, "select covar_samp(x, y) from data;"), 31. / 7., 1e-9);
+  BOOST_CHECK_CLOSE(get_double(conn, "select corr(x, y) from data;"),       31. / std::sqrt(32. * 42.), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(sliding_window)
+{
+  auto conn = make_db();
+
+  std::vector<double> xs;
+  auto xq = conn.prepare("select x from data where x is not null order by id;");
+  for (auto r : sqlite::statement_range<sqlite::row>(xq))
+    xs.push_back(r.at(0).get_double());
+
+  // language=sqlite
+  auto q = conn.prepare(
+      "select median(x) over w, percentile_cont(x, 0.25) over w, var_pop(x) over w, corr(x, y) over w from data "
+      "where x is not null window w as (order by id rows between 2 preceding and current row) order by id;");
+
+  std::size_t i = 0u;
+  for (auto r : sqlite::statement_range<sqlite::row>(q))
+  {
+    std::vector<double> frame(xs.begin() + (i < 2u ? 0u : i - 2u), xs.begin() + i + 1u);
+    std::sort(frame.begin(), frame.end());
+    const auto at = [&](double q)
+    {
+      const auto pos = q * static_cast<double>(frame.size() - 1u);
+      const auto lo  = static_cast<std::size_t>(pos);
+      return lo + 1u >= frame.size() ? frame.back() : frame[lo] + (frame[lo + 1u] - frame[lo]) * (pos - lo);
+    };
+    double mean = 0., m2 = 0.;
+    for (auto f : frame)
+      mean += f / static_cast<double>(frame.size());
+    for (auto f : frame)
+      m2 += (f - mean) * (f - mean);
+
+    BOOST_CHECK_CLOSE(r.at(0).get_double(), at(.5),  1e-9);
+    BOOST_CHECK_CLOSE(r.at(1).get_double(), at(.25), 1e-9);
+    BOOST_CHECK_SMALL(r.at(2).get_double() - m2 / static_cast<double>(frame.size()), 1e-9);
+    if (i == 0u)
+      BOOST_CHECK(r.at(3).is_null());
+    i++;
+  }
+  BOOST_CHECK_EQUAL(i, xs.size());
+
+  BOOST_CHECK_THROW(conn.execute("select percentile_cont(x, 2) from data;"), system::system_error);
+  BOOST_CHECK_THROW(conn.execute("select percentile_cont(x, x / 10) from data;"), system::system_error);
+}
+
+BOOST_AUTO_TEST_CASE(order_statistic)
+{
+  sqlite::statistics::order_statistic os;
+  std::vector<double> ref;
+  std::uint32_t rng = 12345u;
+  for (int i = 0; i < 5000; i++)
+  {
+    rng = rng * 1664525u + 1013904223u;
+    // few distinct values, so there are many duplicates.
+    const double x = static_cast<double>((rng >> 8u) % 200u);
+    if ((rng >> 4u) % 3u == 0u)
+    {
+      os.erase(x);
+      auto itr = std::find(ref.begin(), ref.end(), x);
+      if (itr != ref.end())
+        ref.erase(itr);
+    }
+    else
+    {
+      os.insert(x);
+      ref.insert(std::upper_bound(ref.begin(), ref.end(), x), x);
+    }
+    BOOST_REQUIRE_EQUAL(os.size(), ref.size());
+  }
+  for (std::size_t i = 0u; i < ref.size(); i++)
+    BOOST_CHECK_EQUAL(os[i], ref[i]);
+
+  while (!ref.empty())
+  {
+    os.erase(ref.back());
+    ref.pop_back();
+  }
+  BOOST_CHECK(os.empty());
+  BOOST_CHECK(os.quantile(.5).index() == 0u);
+  os.insert(1.);
+  os.insert(3.);
+  BOOST_CHECK_EQUAL(variant2::get<double>(os.quantile(.5)), 2.);
+}
+
+BOOST_AUTO_TEST_CASE(tdigest)
+{
+  sqlite::connection conn(":memory:");
+  sqlite::create_statistics_functions(conn);
+
+  // language=sqlite
+  conn.execute(R"(
+create table samples(bucket integer, x real);
+with recursive c(i) as (select 0 union all select i + 1 from c where i < 9999)
+  insert into samples select i % 4, i from c;
+create table digests as select bucket, tdigest(x) as digest from samples group by bucket;
+)");
+
+  const auto approx = get_double(conn, "select approx_percentile(x, 0.9) from samples;");
+  BOOST_CHECK_CLOSE(approx, 9000., 1.);
+
+  const auto merged = get_double(conn, "select tdigest_quantile(tdigest_merge(digest), 0.5) from digests;");
+  BOOST_CHECK_CLOSE(merged, 5000., 1.);
+
+  const auto tail = get_double(conn, "select tdigest_quantile(tdigest_merge(digest), 0.999) from digests;");
+  BOOST_CHECK_CLOSE(tail, 9990., .1);
+
+  sqlite::statistics::tdigest td;
+  for (int i = 0; i < 1000; i++)
+    td.add(i);
+  auto bl = td.to_blob();
+  sqlite::statistics::tdigest copy;
+  BOOST_CHECK(copy.merge(sqlite::blob_view(bl)).has_value());
+  BOOST_CHECK_EQUAL(copy.total_weight(), 1000.);
+  BOOST_CHECK_CLOSE(variant2::get<double>(copy.quantile(.5)), 500., 1.);
+
+  // the total of the header is ignored, the weights of the centroids count.
+  const auto total_at = 3u * sizeof(std::uint64_t);
+  const auto weight_at = 6u * sizeof(std::uint64_t) + sizeof(double);
+  sqlite::blob wrong_total{sqlite::blob_view(bl)};
+  const double zero = 0.;
+  std::memcpy(static_cast<char*>(wrong_total.data()) + total_at, &zero, sizeof(zero));
+  sqlite::statistics::tdigest summed;
+  BOOST_CHECK(summed.merge(sqlite::blob_view(wrong_total)).has_value());
+  BOOST_CHECK_EQUAL(summed.total_weight(), 1000.);
+  BOOST_CHECK_CLOSE(variant2::get<double>(summed.quantile(.5)), 500., 1.);
+
+  for (double w : {0., -1., std::nan("")})
+  {
+    sqlite::blob bad{sqlite::blob_view(bl)};
+    std::memcpy(static_cast<char*>(bad.data()) + weight_at, &w, sizeof(w));
+    sqlite::statistics::tdigest rejected;
+    auto res = rejected.merge(sqlite::blob_view(bad));
+    BOOST_REQUIRE(res.has_error());
+    BOOST_CHECK_EQUAL(std::move(res).error().code, SQLITE_MISMATCH);
+    BOOST_CHECK_EQUAL(rejected.total_weight(), 0.);
+  }
+
+  BOOST_CHECK_THROW(conn.execute("select tdigest_quantile(x'00', 0.5);"), system::system_error);
+  BOOST_CHECK_THROW(conn.execute("select tdigest_quantile(digest, 1.5) from digests;"), system::system_error);
+
+  auto st = conn.prepare("select approx_percentile(x, 0.5), tdigest_quantile(tdigest(x), 0.5) from samples where x < 0;");
+  st.step();
+  BOOST_CHECK(st.current().at(0).is_null());
+  BOOST_CHECK(st.current().at(1).is_null());
+}
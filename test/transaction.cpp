@@ -10,6 +10,8 @@
 
 #include "test.hpp"
 
+#include <cstring>
+
 using namespace boost;
 
 BOOST_AUTO_TEST_CASE(transaction)
@@ -94,3 +96,85 @@ BOOST_AUTO_TEST_CASE(transaction)
   BOOST_CHECK_EQUAL(check_size(), 2u);
 }
 
+
+namespace
+{
+
+int count_statements(sqlite::connection & conn, const char * sql)
+{
+  int n = 0;
+  for (auto s = sqlite3_next_stmt(conn.handle(), nullptr); s != nullptr; s = sqlite3_next_stmt(conn.handle(), s))
+    if (std::strcmp(sqlite3_sql(s), sql) == 0)
+      n++;
+  return n;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(cached_control_statements)
+{
+  sqlite::connection conn{":memory:"};
+  conn.execute("create table test(nr integer);");
+
+  auto sum = [&]{
+    auto q = conn.prepare("select total(nr) from test");
+    q.step();
+    return q.current().at(0).get_double();
+  };
+
+  for (int i = 1; i <= 3; i++)
+  {
+    sqlite::transaction t{conn, sqlite::transaction::immediate};
+    conn.execute("insert into test values(1)");
+    {
+      sqlite::savepoint sp{conn, "sp"};
+      conn.execute("insert into test values(10)");
+      sp.rollback();
+    }
+    {
+      sqlite::savepoint sp{conn, "sp"};
+      conn.execute("insert into test values(100)");
+    }
+    t.commit();
+    BOOST_CHECK_EQUAL(sum(), i);
+  }
+
+  // prepared once, reused by every transaction
+  BOOST_CHECK_EQUAL(count_statements(conn, "BEGIN IMMEDIATE"), 1);
+  BOOST_CHECK_EQUAL(count_statements(conn, "COMMIT"), 1);
+  BOOST_CHECK_EQUAL(count_statements(conn, "SAVEPOINT sp"), 1);
+  BOOST_CHECK_EQUAL(count_statements(conn, "ROLLBACK TO sp"), 1);
+  BOOST_CHECK_EQUAL(count_statements(conn, "RELEASE sp"), 1);
+
+  // a rolled back savepoint is released, so the outermost one doesn't leave a transaction open.
+  {
+    sqlite::savepoint sp{conn, "outer"};
+    conn.execute("insert into test values(1000)");
+    sp.rollback();
+  }
+  BOOST_CHECK(sqlite3_get_autocommit(conn.handle()));
+  BOOST_CHECK_EQUAL(sum(), 3);
+
+  // a guard on a connection_ref prepares the statements for every use.
+  {
+    sqlite::transaction t{sqlite::connection_ref(conn)};
+    t.rollback();
+  }
+  BOOST_CHECK_EQUAL(count_statements(conn, "BEGIN"), 0);
+
+  // a lazy message gets copied before a control statement runs.
+  {
+    sqlite::transaction t{conn};
+    system::error_code ec;
+    sqlite::error_info ei;
+    ei.set_lazy();
+    conn.prepare("select abs(-9223372036854775807 - 1)").execute(std::make_tuple(), ec, ei);
+    BOOST_CHECK_EQUAL(ec.value(), SQLITE_ERROR);
+    t.rollback(ec, ei);
+    BOOST_CHECK_EQUAL(ei.message(), "integer overflow");
+  }
+
+  // the cached statements don't keep the connection from closing.
+  conn.close();
+  BOOST_CHECK(!conn.valid());
+}
@@ -255,4 +255,197 @@ BOOST_AUTO_TEST_CASE(modifyable_reader)
 }
 
 
+#if SQLITE_VERSION_NUMBER >= 3038000
+
+// a table with the integers 0 to 999, that counts how many rows it produced.
+struct range_cursor final : sqlite::vtab::cursor<sqlite3_int64>
+{
+  explicit range_cursor(std::size_t & produced) : produced(produced) {}
+
+  std::size_t & produced;
+  std::vector<sqlite3_int64> rows;
+  std::size_t pos = 0u;
+
+  sqlite::result<void> filter(int index, const char * , span<sqlite::value> values)
+  {
+    rows.clear();
+    pos = 0u;
+    auto arg = values.begin();
+    if (index & 1) // in
+      for (auto & v : sqlite::vtab::in(*arg++))
+        rows.push_back(v.get_int());
+    else
+      for (sqlite3_int64 i = 0; i < 1000; i++)
+        rows.push_back(i);
+
+    if (index & 4) // offset comes last
+      rows.erase(rows.begin(), rows.begin() + (std::min)(rows.size(), static_cast<std::size_t>(values.back().get_int())));
+    if (index & 2)
+      rows.resize((std::min)(rows.size(), static_cast<std::size_t>(arg->get_int())));
+    produced += rows.size();
+    return {};
+  }
+
+  sqlite::result<void> next() {pos++; return {};}
+  bool eof() noexcept {return pos == rows.size();}
+  sqlite::result<sqlite3_int64> column(int, bool) {return rows[pos];}
+  sqlite::result<sqlite3_int64> row_id() {return rows[pos];}
+};
+
+struct range_table final : sqlite::vtab::table<range_cursor>
+{
+  explicit range_table(std::size_t & produced, std::vector<sqlite3_int64> & constants)
+      : produced(produced), constants(constants) {}
+  std::size_t & produced;
+  std::vector<sqlite3_int64> & constants;
+
+  const char * declaration() {return "create table x(id integer);";}
+
+  sqlite::result<range_cursor> open() {return range_cursor{produced};}
+
+  sqlite::result<void> best_index(sqlite::vtab::index_info & info)
+  {
+    int idx = 0;
+    for (auto & ct : info.constraints())
+    {
+      if (ct.iColumn != 0 || ct.op != SQLITE_INDEX_CONSTRAINT_EQ)
+        continue;
+      auto rhs = info.rhs_value(info.index_of(ct));
+      if (rhs)
+        constants.push_back(rhs->get_int());
+      if (ct.usable && info.is_in(info.index_of(ct)) && (idx & 1) == 0)
+      {
+        BOOST_CHECK(info.claim_in(ct));
+        idx |= 1;
+      }
+    }
+
+    auto lo = info.claim_limit_and_offset();
+    if (lo.first >= 0)
+      idx |= 2;
+    if (lo.second >= 0)
+      idx |= 4;
+    info.set_index(idx);
+    info.set_estimated_cost(idx & 1 ? 10. : 1000.);
+    return {};
+  }
+};
+
+struct range_module final : sqlite::vtab::eponymous_module<range_table>
+{
+  std::size_t produced = 0u;
+  std::vector<sqlite3_int64> constants;
+  sqlite::result<range_table> connect(sqlite::connection_ref, int, const char * const *)
+  {
+    return range_table{produced, constants};
+  }
+};
+
+BOOST_AUTO_TEST_CASE(index_info_helpers)
+{
+  sqlite::connection conn(":memory:");
+  auto & m = create_module(conn, "range", range_module{});
+
+  const auto count = [&](const char * sql)
+  {
+    m.produced = 0u;
+    std::vector<sqlite3_int64> res;
+    auto st = conn.prepare(sql);
+    for (auto r : sqlite::statement_range<sqlite::row>(st))
+      res.push_back(r.at(0).get_int());
+    return res;
+  };
+
+  using v = std::vector<sqlite3_int64>;
+  BOOST_CHECK(count("select id from range limit 3;") == (v{0, 1, 2}));
+  BOOST_CHECK_EQUAL(m.produced, 3u);
+  BOOST_CHECK(count("select id from range limit 2 offset 10;") == (v{10, 11}));
+  BOOST_CHECK_EQUAL(m.produced, 2u);
+  BOOST_CHECK(count("select id from range where id in (5, 7, 9) limit 2;") == (v{5, 7}));
+  BOOST_CHECK_EQUAL(m.produced, 2u);
+
+  // the other constraint isn't handled by the table, so the limit must be left to sqlite.
+  BOOST_CHECK(count("select id from range where id % 2 = 1 limit 2;") == (v{1, 3}));
+  BOOST_CHECK_EQUAL(m.produced, 1000u);
+
+  m.constants.clear();
+  count("select id from range where id = 42;");
+  BOOST_CHECK(std::find(m.constants.begin(), m.constants.end(), 42) != m.constants.end());
+}
+
+#endif
+
+struct pool_counters
+{
+  std::size_t opened = 0u, reset = 0u, destroyed = 0u;
+};
+
+struct pooled_cursor final : sqlite::vtab::cursor<sqlite3_int64>
+{
+  explicit pooled_cursor(pool_counters & cnt) : cnt(&cnt) {cnt.opened++;}
+  pooled_cursor(pooled_cursor && lhs) noexcept : cnt(lhs.cnt), pos(lhs.pos) {lhs.cnt = nullptr;}
+  ~pooled_cursor()
+  {
+    if (cnt)
+      cnt->destroyed++;
+  }
+
+  pool_counters * cnt;
+  sqlite3_int64 pos = 0;
+
+  sqlite::result<void> reset() {cnt->reset++; pos = 0; return {};}
+  sqlite::result<void> filter(int, const char *, boost::span<sqlite::value>) {pos = 0; return {};}
+  sqlite::result<void> next() {pos++; return {};}
+  bool eof() noexcept {return pos == 3;}
+  sqlite::result<sqlite3_int64> column(int, bool) {return pos;}
+  sqlite::result<sqlite3_int64> row_id() {return pos;}
+};
+
+struct pooled_table final : sqlite::vtab::table<pooled_cursor>, sqlite::vtab::cursor_pool
+{
+  explicit pooled_table(pool_counters & cnt) : cnt(cnt) {}
+  pool_counters & cnt;
+
+  const char * declaration() {return "create table x(id integer);";}
+  sqlite::result<pooled_cursor> open() {return pooled_cursor{cnt};}
+};
+
+struct pooled_module final : sqlite::vtab::eponymous_module<pooled_table>
+{
+  explicit pooled_module(pool_counters & cnt) : cnt(&cnt) {}
+  pool_counters * cnt;
+  sqlite::result<pooled_table> connect(sqlite::connection_ref, int, const char * const *)
+  {
+    return pooled_table{*cnt};
+  }
+};
+
+BOOST_AUTO_TEST_CASE(cursor_pool)
+{
+  pool_counters cnt;
+  {
+    sqlite::connection conn(":memory:");
+    create_module(conn, "pooled", pooled_module{cnt});
+
+    auto st = conn.prepare("select sum(id) from pooled;");
+    for (int i = 0; i < 10; i++)
+    {
+      BOOST_CHECK(st.step());
+      BOOST_CHECK_EQUAL(st.current().at(0).get_int(), 3);
+      sqlite3_reset(st.handle());
+    }
+    BOOST_CHECK_EQUAL(cnt.opened, 1u);
+    BOOST_CHECK_EQUAL(cnt.reset, 10u);
+    BOOST_CHECK_EQUAL(cnt.destroyed, 0u);
+
+    // two cursors open at the same time
+    auto self = conn.prepare("select count(*) from pooled a, pooled b;");
+    BOOST_CHECK(self.step());
+    BOOST_CHECK_EQUAL(self.current().at(0).get_int(), 9);
+    BOOST_CHECK_EQUAL(cnt.opened, 2u);
+  }
+  // the pooled cursors get destroyed with the table
+  BOOST_CHECK_EQUAL(cnt.destroyed, 2u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()